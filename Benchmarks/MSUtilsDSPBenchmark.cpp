@@ -0,0 +1,1098 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+// Microbenchmarks for the per-block work of every MS_Utils node. Each runner drives the same MSUtilsDSP
+// processor its operator's Execute() calls, so the numbers track the real hot path without the engine.
+//
+// Usage: MSUtilsDSPBenchmark [--quick] [--csv] [--filter=<substring>] [--simd=scalar|sse|avx2|avx512|neon]
+//
+// Runs with the widest SIMD kernels the CPU supports unless --simd picks a narrower set.
+//
+// Parameter cases:
+//   static       the control input never changes
+//   per-block    the control input changes every block
+//   per-sample   the control input changes every sample. Control rate nodes can only follow this by
+//                executing one frame at a time, which is what this case measures for them.
+
+#include "MSUtilsDSP/CrossfadeBank.h"
+#include "MSUtilsDSP/Denormals.h"
+#include "MSUtilsDSP/EqualPowerCrossfader.h"
+#include "MSUtilsDSP/FadeEngine.h"
+#include "MSUtilsDSP/FadeEnvelope.h"
+#include "MSUtilsDSP/GainKernelDispatch.h"
+#include "MSUtilsDSP/GainKernels.h"
+#include "MSUtilsDSP/MappedRangeGain.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using namespace MSUtilsDSP;
+
+	enum class EParamCase
+	{
+		Static,
+		PerBlock,
+		PerSample
+	};
+
+	const char* LexToString(EParamCase Case)
+	{
+		switch (Case)
+		{
+		case EParamCase::Static: return "static";
+		case EParamCase::PerBlock: return "per-block";
+		default: return "per-sample";
+		}
+	}
+
+	struct FBenchConfig
+	{
+		int32 BlockSize = 256;
+		float SampleRate = 48000.0f;
+		EParamCase ParamCase = EParamCase::Static;
+	};
+
+	// Slow sweep between 0 and 1 used to drive every changing parameter
+	float GetSweep(int64_t SampleIndex)
+	{
+		return 0.5f + 0.5f * std::sin((float)(SampleIndex % 48000) * 0.00013f);
+	}
+
+	std::vector<float> MakeNoise(int32 NumFrames, uint32 Seed)
+	{
+		std::mt19937 Rng(Seed);
+		std::uniform_real_distribution<float> Dist(-1.0f, 1.0f);
+		std::vector<float> Buffer(NumFrames);
+		for (float& Sample : Buffer)
+		{
+			Sample = Dist(Rng);
+		}
+		return Buffer;
+	}
+
+	class IBenchRunner
+	{
+	public:
+		virtual ~IBenchRunner() = default;
+
+		// Runs one block of the node. BlockIndex drives the parameter sweep.
+		virtual void RunBlock(int64_t BlockIndex) = 0;
+
+		// Checksum of the output so the work cannot be optimized away
+		virtual float GetOutputSample() const = 0;
+
+		// Bytes of audio read and written since the last call
+		uint64_t ConsumeBytesTouched()
+		{
+			const uint64_t Bytes = BytesTouched;
+			BytesTouched = 0;
+			return Bytes;
+		}
+
+	protected:
+		uint64_t BytesTouched = 0;
+	};
+
+	// Helper for runners that only have a block-level Process(): calls it once per block, or once per frame
+	// for the per-sample case, feeding the parameter for that block or frame.
+	template<typename ProcessFunc>
+	void ForEachSubBlock(const FBenchConfig& Config, int64_t BlockIndex, ProcessFunc Process)
+	{
+		const int64_t FirstSample = BlockIndex * Config.BlockSize;
+		switch (Config.ParamCase)
+		{
+		case EParamCase::Static:
+			Process(0, Config.BlockSize, 0.5f);
+			break;
+
+		case EParamCase::PerBlock:
+			Process(0, Config.BlockSize, GetSweep(FirstSample));
+			break;
+
+		case EParamCase::PerSample:
+			for (int32 Frame = 0; Frame < Config.BlockSize; ++Frame)
+			{
+				Process(Frame, 1, GetSweep(FirstSample + Frame));
+			}
+			break;
+		}
+	}
+
+	// Floats read and written per frame by TEqualPowerCrossfader::Mix: a zero pass when nothing is live and one
+	// fused pass for up to two inputs. Beyond that the first input is written, then each other input costs
+	// read input + read/write output.
+	int32 GetMixPassFloats(int32 NumMixed)
+	{
+		if (NumMixed <= 2)
+		{
+			return NumMixed + 1;
+		}
+		return 2 + 3 * (NumMixed - 1);
+	}
+
+	// TEPXFOperator<NumInputs, NumChannels>. The gains are computed once per block whatever the channel count.
+	// bConstant is the operator built with nothing connected to the crossfade value: it sits between two inputs
+	// whatever the parameter case, and every block after the first goes through MixSettled.
+	template<int32 NumInputs, int32 NumChannels = 1>
+	class TNWayCrossfadeRunner : public IBenchRunner
+	{
+	public:
+		TNWayCrossfadeRunner(const FBenchConfig& InConfig, EGainAccuracy InAccuracy, bool bInConstant = false)
+			: Config(InConfig)
+			, Accuracy(InAccuracy)
+			, bConstant(bInConstant)
+			, Outputs(NumChannels, std::vector<float>(InConfig.BlockSize))
+		{
+			for (int32 i = 0; i < NumInputs * NumChannels; ++i)
+			{
+				Inputs.push_back(MakeNoise(Config.BlockSize, 100 + i));
+			}
+		}
+
+		void RunBlock(int64_t BlockIndex) override
+		{
+			if (bConstant)
+			{
+				for (int32 i = 0; i < NumInputs * NumChannels; ++i)
+				{
+					InputData[i] = Inputs[i].data();
+				}
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					OutputData[Channel] = Outputs[Channel].data();
+				}
+
+				if (BlockIndex == 0)
+				{
+					Crossfader.Process(0.5f * (float)(NumInputs - 1), Accuracy, InputData, OutputData, NumChannels, Config.BlockSize);
+				}
+				else
+				{
+					Crossfader.MixSettled(InputData, OutputData, NumChannels, Config.BlockSize);
+				}
+				BytesTouched += sizeof(float) * Config.BlockSize * NumChannels * GetMixPassFloats(Crossfader.GetNumMixedInputs());
+				return;
+			}
+
+			ForEachSubBlock(Config, BlockIndex, [this](int32 Offset, int32 NumFrames, float Sweep)
+			{
+				for (int32 i = 0; i < NumInputs * NumChannels; ++i)
+				{
+					InputData[i] = Inputs[i].data() + Offset;
+				}
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					OutputData[Channel] = Outputs[Channel].data() + Offset;
+				}
+
+				// Static sits between two inputs so the steady state still mixes a pair
+				const float Value = Sweep * (float)(NumInputs - 1);
+				Crossfader.Process(Value, Accuracy, InputData, OutputData, NumChannels, NumFrames);
+
+				BytesTouched += sizeof(float) * NumFrames * NumChannels * GetMixPassFloats(Crossfader.GetNumMixedInputs());
+			});
+		}
+
+		float GetOutputSample() const override
+		{
+			return Outputs[0][0];
+		}
+
+	private:
+		FBenchConfig Config;
+		EGainAccuracy Accuracy;
+		bool bConstant;
+		TEqualPowerCrossfader<NumInputs> Crossfader;
+		std::vector<std::vector<float>> Inputs;
+		std::vector<std::vector<float>> Outputs;
+		const float* InputData[NumInputs * NumChannels] = {};
+		float* OutputData[NumChannels] = {};
+	};
+
+	// TEPXFAudioRateOperator<NumInputs>. The control input is an audio buffer, so the per-sample case runs whole
+	// blocks like the others.
+	class FAudioRateCrossfadeRunner : public IBenchRunner
+	{
+	public:
+		FAudioRateCrossfadeRunner(const FBenchConfig& InConfig, int32 InNumInputs, EGainAccuracy InAccuracy)
+			: Config(InConfig)
+			, NumInputs(InNumInputs)
+			, Accuracy(InAccuracy)
+			, Crossfader(InNumInputs, InConfig.BlockSize)
+			, Control(InConfig.BlockSize)
+			, Output(InConfig.BlockSize)
+			, InputData(InNumInputs)
+		{
+			for (int32 i = 0; i < NumInputs; ++i)
+			{
+				Inputs.push_back(MakeNoise(Config.BlockSize, 100 + i));
+				InputData[i] = Inputs[i].data();
+			}
+		}
+
+		void RunBlock(int64_t BlockIndex) override
+		{
+			const int64_t FirstSample = BlockIndex * Config.BlockSize;
+			const float Scale = (float)(NumInputs - 1);
+			switch (Config.ParamCase)
+			{
+			case EParamCase::Static:
+				FillConstant(Control.data(), Config.BlockSize, 0.5f * Scale);
+				break;
+
+			case EParamCase::PerBlock:
+				FillConstant(Control.data(), Config.BlockSize, GetSweep(FirstSample) * Scale);
+				break;
+
+			case EParamCase::PerSample:
+				for (int32 Frame = 0; Frame < Config.BlockSize; ++Frame)
+				{
+					Control[Frame] = GetSweep(FirstSample + Frame) * Scale;
+				}
+				break;
+			}
+
+			Crossfader.Process(Control.data(), Accuracy, InputData.data(), Output.data(), Config.BlockSize);
+
+			const int32 NumMixed = Crossfader.GetLastActiveInput() - Crossfader.GetFirstActiveInput() + 1;
+			BytesTouched += sizeof(float) * Config.BlockSize * (1 + 3 * NumMixed);
+		}
+
+		float GetOutputSample() const override
+		{
+			return Output[0];
+		}
+
+	private:
+		FBenchConfig Config;
+		int32 NumInputs;
+		EGainAccuracy Accuracy;
+		FAudioRateEqualPowerCrossfader Crossfader;
+		std::vector<std::vector<float>> Inputs;
+		std::vector<float> Control;
+		std::vector<float> Output;
+		std::vector<const float*> InputData;
+	};
+
+	// The engine's stock Crossfade node, as a baseline: linear gains, zero the output then one
+	// ramped mix-in pass per input that has gain this block or had gain last block.
+	class FStockCrossfadeRunner : public IBenchRunner
+	{
+	public:
+		FStockCrossfadeRunner(const FBenchConfig& InConfig, int32 InNumInputs)
+			: Config(InConfig)
+			, NumInputs(InNumInputs)
+			, PrevGains(InNumInputs, 0.0f)
+			, CurrentGains(InNumInputs, 0.0f)
+			, NeedsMixing(InNumInputs, false)
+			, Output(InConfig.BlockSize)
+		{
+			for (int32 i = 0; i < NumInputs; ++i)
+			{
+				Inputs.push_back(MakeNoise(Config.BlockSize, 100 + i));
+			}
+		}
+
+		void RunBlock(int64_t BlockIndex) override
+		{
+			ForEachSubBlock(Config, BlockIndex, [this](int32 Offset, int32 NumFrames, float Sweep)
+			{
+				const FCrossfadePosition Position = GetCrossfadePosition(Sweep * (float)(NumInputs - 1), NumInputs);
+				for (int32 i = 0; i < NumInputs; ++i)
+				{
+					if (i == Position.IndexA)
+					{
+						CurrentGains[i] = 1.0f - Position.Alpha;
+						NeedsMixing[i] = true;
+					}
+					else if (i == Position.IndexB)
+					{
+						CurrentGains[i] = Position.Alpha;
+						NeedsMixing[i] = true;
+					}
+					else
+					{
+						CurrentGains[i] = 0.0f;
+						if (PrevGains[i] == 0.0f)
+						{
+							NeedsMixing[i] = false;
+						}
+					}
+				}
+
+				float* Out = Output.data() + Offset;
+				ZeroBuffer(Out, NumFrames);
+				int32 NumMixed = 0;
+				for (int32 i = 0; i < NumInputs; ++i)
+				{
+					if (NeedsMixing[i])
+					{
+						MixInRamp(Inputs[i].data() + Offset, Out, NumFrames, PrevGains[i], CurrentGains[i]);
+						++NumMixed;
+					}
+				}
+				PrevGains = CurrentGains;
+
+				BytesTouched += sizeof(float) * NumFrames * (1 + 3 * NumMixed);
+			});
+		}
+
+		float GetOutputSample() const override
+		{
+			return Output[0];
+		}
+
+	private:
+		FBenchConfig Config;
+		int32 NumInputs;
+		std::vector<float> PrevGains;
+		std::vector<float> CurrentGains;
+		std::vector<bool> NeedsMixing;
+		std::vector<std::vector<float>> Inputs;
+		std::vector<float> Output;
+	};
+
+	// FEPXFOperator
+	class FLightweightCrossfadeRunner : public IBenchRunner
+	{
+	public:
+		FLightweightCrossfadeRunner(const FBenchConfig& InConfig, EGainAccuracy InAccuracy)
+			: Config(InConfig)
+			, Accuracy(InAccuracy)
+			, InputA(MakeNoise(InConfig.BlockSize, 1))
+			, InputB(MakeNoise(InConfig.BlockSize, 2))
+			, Output(InConfig.BlockSize)
+		{
+		}
+
+		void RunBlock(int64_t BlockIndex) override
+		{
+			ForEachSubBlock(Config, BlockIndex, [this](int32 Offset, int32 NumFrames, float Sweep)
+			{
+				Crossfader.Process(Sweep, Accuracy, InputA.data() + Offset, InputB.data() + Offset, Output.data() + Offset, NumFrames);
+				const FEqualPowerGains& Gains = Crossfader.GetGains();
+				BytesTouched += sizeof(float) * NumFrames * GetMixPassFloats((Gains.A != 0.0f ? 1 : 0) + (Gains.B != 0.0f ? 1 : 0));
+			});
+		}
+
+		float GetOutputSample() const override
+		{
+			return Output[0];
+		}
+
+	private:
+		FBenchConfig Config;
+		EGainAccuracy Accuracy;
+		FEqualPowerCrossfadePair Crossfader;
+		std::vector<float> InputA;
+		std::vector<float> InputB;
+		std::vector<float> Output;
+	};
+
+	// TEPXFBankOperator<NumVoices>, or with bSeparateOperators the same voices as that many FEPXFOperators.
+	// Each voice is offset from the shared sweep so the values differ, without a sweep evaluation per voice.
+	class FCrossfadeBankRunner : public IBenchRunner
+	{
+	public:
+		FCrossfadeBankRunner(const FBenchConfig& InConfig, int32 InNumVoices, bool bInSeparateOperators, EGainAccuracy InAccuracy)
+			: Config(InConfig)
+			, Accuracy(InAccuracy)
+			, NumVoices(InNumVoices)
+			, bSeparateOperators(bInSeparateOperators)
+			, Bank(InNumVoices)
+			, Pairs(InNumVoices)
+			, Values(InNumVoices)
+			, InputDataA(InNumVoices)
+			, InputDataB(InNumVoices)
+			, OutputData(InNumVoices)
+		{
+			for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				Inputs.push_back(MakeNoise(Config.BlockSize, 200 + 2 * Voice));
+				Inputs.push_back(MakeNoise(Config.BlockSize, 201 + 2 * Voice));
+				Outputs.push_back(std::vector<float>(Config.BlockSize));
+			}
+		}
+
+		void RunBlock(int64_t BlockIndex) override
+		{
+			ForEachSubBlock(Config, BlockIndex, [this](int32 Offset, int32 NumFrames, float Sweep)
+			{
+				int32 NumMixed = 0;
+				for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+				{
+					const float Value = Sweep + 0.37f * (float)Voice;
+					Values[Voice] = Value - std::floor(Value);
+					InputDataA[Voice] = Inputs[2 * Voice].data() + Offset;
+					InputDataB[Voice] = Inputs[2 * Voice + 1].data() + Offset;
+					OutputData[Voice] = Outputs[Voice].data() + Offset;
+				}
+
+				if (bSeparateOperators)
+				{
+					for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+					{
+						Pairs[Voice].Process(Values[Voice], Accuracy, InputDataA[Voice], InputDataB[Voice], OutputData[Voice], NumFrames);
+						NumMixed += (Pairs[Voice].GetGains().A != 0.0f ? 1 : 0) + (Pairs[Voice].GetGains().B != 0.0f ? 1 : 0);
+					}
+				}
+				else
+				{
+					Bank.Process(Values.data(), Accuracy, InputDataA.data(), InputDataB.data(), OutputData.data(), NumFrames);
+					for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+					{
+						NumMixed += (Bank.GetGains(Voice).A != 0.0f ? 1 : 0) + (Bank.GetGains(Voice).B != 0.0f ? 1 : 0);
+					}
+				}
+
+				BytesTouched += sizeof(float) * NumFrames * (NumMixed + NumVoices);
+			});
+		}
+
+		float GetOutputSample() const override
+		{
+			return Outputs[0][0];
+		}
+
+	private:
+		FBenchConfig Config;
+		EGainAccuracy Accuracy;
+		int32 NumVoices;
+		bool bSeparateOperators;
+		FEqualPowerCrossfadeBank Bank;
+		std::vector<FEqualPowerCrossfadePair> Pairs;
+		std::vector<float> Values;
+		std::vector<std::vector<float>> Inputs;
+		std::vector<std::vector<float>> Outputs;
+		std::vector<const float*> InputDataA;
+		std::vector<const float*> InputDataB;
+		std::vector<float*> OutputData;
+	};
+
+	// FCBPOperator. ValueOffset moves the sweep relative to the zone, e.g. out of it entirely for the muted case.
+	// InputScale shrinks the input, down to denormals for the decaying tail case, and bFlushDenormals runs each block
+	// under FScopedFlushDenormals as the operator does.
+	class FCrossfadeByParamRunner : public IBenchRunner
+	{
+	public:
+		FCrossfadeByParamRunner(const FBenchConfig& InConfig, float InValueOffset, float InputScale = 1.0f, bool bInFlushDenormals = false)
+			: Config(InConfig)
+			, ValueOffset(InValueOffset)
+			, bFlushDenormals(bInFlushDenormals)
+			, Input(MakeNoise(InConfig.BlockSize, 3))
+			, Output(InConfig.BlockSize)
+		{
+			Zone = { 0.0f, 0.25f, 0.75f, 1.0f };
+			for (float& Sample : Input)
+			{
+				Sample *= InputScale;
+			}
+		}
+
+		void RunBlock(int64_t BlockIndex) override
+		{
+			const FScopedFlushDenormals FlushDenormals(bFlushDenormals);
+			ForEachSubBlock(Config, BlockIndex, [this](int32 Offset, int32 NumFrames, float Sweep)
+			{
+				Fader.Process(Sweep + ValueOffset, Zone, Input.data() + Offset, Output.data() + Offset, NumFrames);
+
+				// One scaled copy, or nothing once the zone is muted
+				BytesTouched += sizeof(float) * NumFrames * (Fader.IsMuted() ? 0 : 2);
+			});
+		}
+
+		float GetOutputSample() const override
+		{
+			return Output[0];
+		}
+
+	private:
+		FBenchConfig Config;
+		float ValueOffset;
+		bool bFlushDenormals;
+		FTrapezoidZone Zone;
+		FMappedRangeFader Fader;
+		std::vector<float> Input;
+		std::vector<float> Output;
+	};
+
+	// TCBPMultiZoneOperator<NumZones> with layered zones that overlap their neighbours, or with bSeparateOperators the
+	// same zones as that many FCBPOperators summed by a mixer, which adds every output whether it is silent or not
+	template<int32 NumZones>
+	class TMultiZoneCrossfadeByParamRunner : public IBenchRunner
+	{
+	public:
+		TMultiZoneCrossfadeByParamRunner(const FBenchConfig& InConfig, bool bInSeparateOperators)
+			: Config(InConfig)
+			, bSeparateOperators(bInSeparateOperators)
+			, Faders(NumZones)
+			, FadeInStarts(NumZones)
+			, FadeInEnds(NumZones)
+			, FadeOutStarts(NumZones)
+			, FadeOutEnds(NumZones)
+			, InputData(NumZones)
+			, Output(InConfig.BlockSize)
+		{
+			for (int32 Zone = 0; Zone < NumZones; ++Zone)
+			{
+				FadeInStarts[Zone] = (float)Zone - 0.5f;
+				FadeInEnds[Zone] = (float)Zone;
+				FadeOutStarts[Zone] = (float)Zone + 0.5f;
+				FadeOutEnds[Zone] = (float)Zone + 1.0f;
+				Inputs.push_back(MakeNoise(Config.BlockSize, 300 + Zone));
+				FaderOutputs.push_back(std::vector<float>(Config.BlockSize));
+			}
+		}
+
+		void RunBlock(int64_t BlockIndex) override
+		{
+			ForEachSubBlock(Config, BlockIndex, [this](int32 Offset, int32 NumFrames, float Sweep)
+			{
+				// Static sits in the overlap of two layers
+				const float Value = Sweep * (float)(NumZones - 1) + 0.25f;
+				for (int32 Zone = 0; Zone < NumZones; ++Zone)
+				{
+					InputData[Zone] = Inputs[Zone].data() + Offset;
+				}
+
+				if (bSeparateOperators)
+				{
+					for (int32 Zone = 0; Zone < NumZones; ++Zone)
+					{
+						const FTrapezoidZone ZoneEdges = { FadeInStarts[Zone], FadeInEnds[Zone], FadeOutStarts[Zone], FadeOutEnds[Zone] };
+						Faders[Zone].Process(Value, ZoneEdges, InputData[Zone], FaderOutputs[Zone].data() + Offset, NumFrames);
+						BytesTouched += sizeof(float) * NumFrames * (Faders[Zone].IsMuted() ? 0 : 2);
+					}
+
+					CopyBuffer(FaderOutputs[0].data() + Offset, Output.data() + Offset, NumFrames);
+					for (int32 Zone = 1; Zone < NumZones; ++Zone)
+					{
+						MixInConstant(FaderOutputs[Zone].data() + Offset, Output.data() + Offset, NumFrames, 1.0f);
+					}
+					BytesTouched += sizeof(float) * NumFrames * (2 + 3 * (NumZones - 1));
+				}
+				else
+				{
+					const FTrapezoidZoneArrays Zones = { FadeInStarts.data(), FadeInEnds.data(), FadeOutStarts.data(), FadeOutEnds.data() };
+					MultiZone.Process(Value, Zones, InputData.data(), Output.data() + Offset, NumFrames);
+
+					// The first active zone is a scaled copy, each other one read input + read/write output
+					const int32 NumActive = MultiZone.GetNumActiveZones();
+					BytesTouched += sizeof(float) * NumFrames * (NumActive == 0 ? 0 : 2 + 3 * (NumActive - 1));
+				}
+			});
+		}
+
+		float GetOutputSample() const override
+		{
+			return Output[0];
+		}
+
+	private:
+		FBenchConfig Config;
+		bool bSeparateOperators;
+		TMultiZoneFader<NumZones> MultiZone;
+		std::vector<FMappedRangeFader> Faders;
+		std::vector<float> FadeInStarts;
+		std::vector<float> FadeInEnds;
+		std::vector<float> FadeOutStarts;
+		std::vector<float> FadeOutEnds;
+		std::vector<std::vector<float>> Inputs;
+		std::vector<std::vector<float>> FaderOutputs;
+		std::vector<const float*> InputData;
+		std::vector<float> Output;
+	};
+
+	// FCBPOperator built with nothing connected to the value or zone, at the same value as the static case of FCrossfadeByParamRunner
+	class FConstantCrossfadeByParamRunner : public IBenchRunner
+	{
+	public:
+		explicit FConstantCrossfadeByParamRunner(const FBenchConfig& InConfig)
+			: Config(InConfig)
+			, Fader(0.5f, FTrapezoidZone{ 0.0f, 0.25f, 0.75f, 1.0f })
+			, Input(MakeNoise(InConfig.BlockSize, 3))
+			, Output(InConfig.BlockSize)
+		{
+		}
+
+		void RunBlock(int64_t) override
+		{
+			Fader.Process(Input.data(), Output.data(), Config.BlockSize);
+			BytesTouched += sizeof(float) * Config.BlockSize * 2;
+		}
+
+		float GetOutputSample() const override
+		{
+			return Output[0];
+		}
+
+	private:
+		FBenchConfig Config;
+		FFixedZoneFader Fader;
+		std::vector<float> Input;
+		std::vector<float> Output;
+	};
+
+	// FSimpleFIOperator / FSimpleFOOperator. Static leaves the envelope idle, per-block keeps it fading by
+	// restarting it as soon as it finishes, and per-sample additionally lands a trigger on every frame.
+	class FSimpleFadeRunner : public IBenchRunner
+	{
+	public:
+		FSimpleFadeRunner(const FBenchConfig& InConfig, EFadeDirection InDirection)
+			: Config(InConfig)
+			, Envelope(InDirection)
+			, EnvelopeAudio(InConfig.BlockSize)
+		{
+			Events.reserve(InConfig.BlockSize);
+		}
+
+		void RunBlock(int64_t) override
+		{
+			const float FadeSamples = Config.SampleRate * FadeTimeSeconds;
+
+			Events.clear();
+			if (Config.ParamCase == EParamCase::PerSample)
+			{
+				for (int32 Frame = 0; Frame < Config.BlockSize; ++Frame)
+				{
+					Events.push_back({ Frame, EFadeEventType::Start, FadeSamples });
+				}
+			}
+			else if (Config.ParamCase == EParamCase::PerBlock && !Envelope.IsFading())
+			{
+				Events.push_back({ 0, EFadeEventType::Start, FadeSamples });
+			}
+
+			const bool bWasFading = Envelope.IsFading();
+			Envelope.RenderBlock(EnvelopeAudio.data(), Config.BlockSize, Events.data(), (int32)Events.size(), [](int32) {});
+			Output = Envelope.GetValue();
+
+			// The audio rate envelope is only rewritten while something is happening
+			const bool bWroteAudio = bWasFading || !Events.empty();
+			BytesTouched += sizeof(float) * (bWroteAudio ? 1 + Config.BlockSize : 1);
+		}
+
+		float GetOutputSample() const override
+		{
+			return Output + EnvelopeAudio[0];
+		}
+
+	private:
+		static constexpr float FadeTimeSeconds = 0.25f;
+
+		FBenchConfig Config;
+		FFadeEnvelope Envelope;
+		std::vector<FFadeEvent> Events;
+		std::vector<float> EnvelopeAudio;
+		float Output = 0.0f;
+	};
+
+	// TFadeAudioOperator against FSimpleFIOperator followed by a separate multiply node, with the same triggers
+	// as FSimpleFadeRunner
+	class FFadeAudioRunner : public IBenchRunner
+	{
+	public:
+		FFadeAudioRunner(const FBenchConfig& InConfig, EFadeDirection InDirection, bool bInSeparateMultiply)
+			: Config(InConfig)
+			, Envelope(InDirection)
+			, bSeparateMultiply(bInSeparateMultiply)
+			, Input(MakeNoise(InConfig.BlockSize, 5))
+			, EnvelopeAudio(InConfig.BlockSize)
+			, Output(InConfig.BlockSize)
+		{
+			Events.reserve(InConfig.BlockSize);
+		}
+
+		void RunBlock(int64_t) override
+		{
+			const float FadeSamples = Config.SampleRate * FadeTimeSeconds;
+
+			Events.clear();
+			if (Config.ParamCase == EParamCase::PerSample)
+			{
+				for (int32 Frame = 0; Frame < Config.BlockSize; ++Frame)
+				{
+					Events.push_back({ Frame, EFadeEventType::Start, FadeSamples });
+				}
+			}
+			else if (Config.ParamCase == EParamCase::PerBlock && !Envelope.IsFading())
+			{
+				Events.push_back({ 0, EFadeEventType::Start, FadeSamples });
+			}
+
+			const float* InputData = Input.data();
+			if (bSeparateMultiply)
+			{
+				Envelope.RenderBlock(EnvelopeAudio.data(), Config.BlockSize, Events.data(), (int32)Events.size(), [](int32) {});
+				MultiplyBuffers(InputData, EnvelopeAudio.data(), Output.data(), Config.BlockSize);
+				BytesTouched += sizeof(float) * Config.BlockSize * 5;
+			}
+			else
+			{
+				// A settled silent output is left as it is, anything else is one scaled copy
+				const bool bWasSilent = !Envelope.IsFading() && Envelope.GetValue() == 0.0f;
+				Envelope.ApplyBlock(InputData, Output.data(), Config.BlockSize, Events.data(), (int32)Events.size(), [](int32) {});
+				BytesTouched += bWasSilent && Events.empty() ? 0 : sizeof(float) * Config.BlockSize * 2;
+			}
+		}
+
+		float GetOutputSample() const override
+		{
+			return Output[0];
+		}
+
+	private:
+		static constexpr float FadeTimeSeconds = 0.25f;
+
+		FBenchConfig Config;
+		FFadeEnvelope Envelope;
+		bool bSeparateMultiply;
+		std::vector<FFadeEvent> Events;
+		std::vector<float> Input;
+		std::vector<float> EnvelopeAudio;
+		std::vector<float> Output;
+	};
+
+	// FFadeInOutOperator. Per-block reverses the fade each time it lands, per-sample lands a fade in or out on every frame.
+	class FFadeInOutRunner : public IBenchRunner
+	{
+	public:
+		explicit FFadeInOutRunner(const FBenchConfig& InConfig)
+			: Config(InConfig)
+			, Engine(1.0f)
+			, Input(MakeNoise(InConfig.BlockSize, 6))
+			, Output(InConfig.BlockSize)
+		{
+			Commands.reserve(InConfig.BlockSize);
+		}
+
+		void RunBlock(int64_t) override
+		{
+			const float FadeSamples = Config.SampleRate * FadeTimeSeconds;
+
+			Commands.clear();
+			if (Config.ParamCase == EParamCase::PerSample)
+			{
+				for (int32 Frame = 0; Frame < Config.BlockSize; ++Frame)
+				{
+					Commands.push_back({ Frame, (Frame & 1) ? EFadeCommandType::FadeIn : EFadeCommandType::FadeOut, FadeSamples });
+				}
+			}
+			else if (Config.ParamCase == EParamCase::PerBlock && !Engine.IsFading())
+			{
+				Commands.push_back({ 0, Engine.GetValue() == 0.0f ? EFadeCommandType::FadeIn : EFadeCommandType::FadeOut, FadeSamples });
+			}
+
+			Engine.ApplyBlock(Input.data(), Output.data(), Config.BlockSize, Commands.data(), (int32)Commands.size(), [](int32, EFadeDirection) {});
+			BytesTouched += sizeof(float) * Config.BlockSize * 2;
+		}
+
+		float GetOutputSample() const override
+		{
+			return Output[0];
+		}
+
+	private:
+		static constexpr float FadeTimeSeconds = 0.25f;
+
+		FBenchConfig Config;
+		FFadeEngine Engine;
+		std::vector<FFadeCommand> Commands;
+		std::vector<float> Input;
+		std::vector<float> Output;
+	};
+
+	struct FNodeBench
+	{
+		std::string Name;
+		std::function<std::unique_ptr<IBenchRunner>(const FBenchConfig&)> Create;
+	};
+
+	// Every crossfade bench for one input count, which the N-way runner needs at compile time
+	template<int32 NumInputs>
+	void AddCrossfadeBenches(std::vector<FNodeBench>& Benches)
+	{
+		Benches.push_back({ "TEPXFOperator<" + std::to_string(NumInputs) + ">", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<TNWayCrossfadeRunner<NumInputs>>(Config, EGainAccuracy::Exact);
+		} });
+		Benches.push_back({ "TEPXFOperator<" + std::to_string(NumInputs) + ">(Fast)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<TNWayCrossfadeRunner<NumInputs>>(Config, EGainAccuracy::Fast);
+		} });
+		Benches.push_back({ "TEPXFAudioRateOperator<" + std::to_string(NumInputs) + ">", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FAudioRateCrossfadeRunner>(Config, NumInputs, EGainAccuracy::Exact);
+		} });
+		Benches.push_back({ "TEPXFAudioRateOperator<" + std::to_string(NumInputs) + ">(Fast)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FAudioRateCrossfadeRunner>(Config, NumInputs, EGainAccuracy::Fast);
+		} });
+		Benches.push_back({ "StockCrossfade<" + std::to_string(NumInputs) + ">", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FStockCrossfadeRunner>(Config, NumInputs);
+		} });
+	}
+
+	std::vector<FNodeBench> GetNodeBenches()
+	{
+		std::vector<FNodeBench> Benches;
+
+		AddCrossfadeBenches<2>(Benches);
+		AddCrossfadeBenches<3>(Benches);
+		AddCrossfadeBenches<4>(Benches);
+		AddCrossfadeBenches<5>(Benches);
+		AddCrossfadeBenches<6>(Benches);
+		AddCrossfadeBenches<7>(Benches);
+		AddCrossfadeBenches<8>(Benches);
+		AddCrossfadeBenches<16>(Benches);
+		AddCrossfadeBenches<32>(Benches);
+		AddCrossfadeBenches<64>(Benches);
+
+		Benches.push_back({ "TEPXFOperator<4, Stereo>", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<TNWayCrossfadeRunner<4, 2>>(Config, EGainAccuracy::Exact);
+		} });
+		Benches.push_back({ "TEPXFOperator<4, 7.1>", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<TNWayCrossfadeRunner<4, 8>>(Config, EGainAccuracy::Exact);
+		} });
+		Benches.push_back({ "TEPXFOperator<8>(Constant)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<TNWayCrossfadeRunner<8>>(Config, EGainAccuracy::Exact, true);
+		} });
+
+		Benches.push_back({ "FEPXFOperator", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FLightweightCrossfadeRunner>(Config, EGainAccuracy::Exact);
+		} });
+		Benches.push_back({ "FEPXFOperator(Fast)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FLightweightCrossfadeRunner>(Config, EGainAccuracy::Fast);
+		} });
+		Benches.push_back({ "TEPXFBankOperator<16>", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FCrossfadeBankRunner>(Config, 16, false, EGainAccuracy::Exact);
+		} });
+		Benches.push_back({ "TEPXFBankOperator<16>(Fast)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FCrossfadeBankRunner>(Config, 16, false, EGainAccuracy::Fast);
+		} });
+		Benches.push_back({ "FEPXFOperator x16", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FCrossfadeBankRunner>(Config, 16, true, EGainAccuracy::Exact);
+		} });
+		Benches.push_back({ "FEPXFOperator x16(Fast)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FCrossfadeBankRunner>(Config, 16, true, EGainAccuracy::Fast);
+		} });
+		Benches.push_back({ "FCBPOperator", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FCrossfadeByParamRunner>(Config, 0.0f);
+		} });
+		Benches.push_back({ "FCBPOperator(Muted)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FCrossfadeByParamRunner>(Config, 2.0f);
+		} });
+		Benches.push_back({ "FCBPOperator(Constant)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FConstantCrossfadeByParamRunner>(Config);
+		} });
+		Benches.push_back({ "FCBPOperator(DenormalTail)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FCrossfadeByParamRunner>(Config, 0.0f, 1e-38f, false);
+		} });
+		Benches.push_back({ "FCBPOperator(DenormalTail,FTZ)", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FCrossfadeByParamRunner>(Config, 0.0f, 1e-38f, true);
+		} });
+		Benches.push_back({ "TCBPMultiZoneOperator<8>", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<TMultiZoneCrossfadeByParamRunner<8>>(Config, false);
+		} });
+		Benches.push_back({ "FCBPOperator x8+Mixer", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<TMultiZoneCrossfadeByParamRunner<8>>(Config, true);
+		} });
+		Benches.push_back({ "FSimpleFIOperator", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FSimpleFadeRunner>(Config, EFadeDirection::In);
+		} });
+		Benches.push_back({ "FSimpleFOOperator", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FSimpleFadeRunner>(Config, EFadeDirection::Out);
+		} });
+
+		Benches.push_back({ "TFadeAudioOperator<In>", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FFadeAudioRunner>(Config, EFadeDirection::In, false);
+		} });
+		Benches.push_back({ "FSimpleFIOperator+Multiply", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FFadeAudioRunner>(Config, EFadeDirection::In, true);
+		} });
+
+		Benches.push_back({ "FFadeInOutOperator", [](const FBenchConfig& Config) -> std::unique_ptr<IBenchRunner>
+		{
+			return std::make_unique<FFadeInOutRunner>(Config);
+		} });
+
+		return Benches;
+	}
+
+	struct FBenchResult
+	{
+		double NanosecondsPerBlock = 0.0;
+		double NanosecondsPerSample = 0.0;
+		double BytesPerBlock = 0.0;
+	};
+
+	volatile float GSink = 0.0f;
+
+	FBenchResult RunBench(IBenchRunner& Runner, const FBenchConfig& Config, double MinSeconds)
+	{
+		using FClock = std::chrono::steady_clock;
+
+		// Warm up caches and let the gain state settle
+		int64_t BlockIndex = 0;
+		for (; BlockIndex < 16; ++BlockIndex)
+		{
+			Runner.RunBlock(BlockIndex);
+		}
+		Runner.ConsumeBytesTouched();
+
+		int64_t NumBlocks = 0;
+		int64_t BatchSize = 8;
+		const FClock::time_point Start = FClock::now();
+		double Elapsed = 0.0;
+		while (Elapsed < MinSeconds)
+		{
+			for (int64_t i = 0; i < BatchSize; ++i, ++BlockIndex)
+			{
+				Runner.RunBlock(BlockIndex);
+			}
+			NumBlocks += BatchSize;
+			BatchSize *= 2;
+			Elapsed = std::chrono::duration<double>(FClock::now() - Start).count();
+		}
+		GSink = GSink + Runner.GetOutputSample();
+
+		FBenchResult Result;
+		Result.NanosecondsPerBlock = Elapsed * 1.e9 / (double)NumBlocks;
+		Result.NanosecondsPerSample = Result.NanosecondsPerBlock / (double)Config.BlockSize;
+		Result.BytesPerBlock = (double)Runner.ConsumeBytesTouched() / (double)NumBlocks;
+		return Result;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	bool bQuick = false;
+	bool bCsv = false;
+	std::string Filter;
+	ESimdLevel SimdLevel = GetBestSimdLevel();
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--quick") == 0)
+		{
+			bQuick = true;
+		}
+		else if (std::strcmp(argv[i], "--csv") == 0)
+		{
+			bCsv = true;
+		}
+		else if (std::strncmp(argv[i], "--filter=", 9) == 0)
+		{
+			Filter = argv[i] + 9;
+		}
+		else if (std::strncmp(argv[i], "--simd=", 7) == 0)
+		{
+			const std::string Name = argv[i] + 7;
+			if (Name == "scalar") { SimdLevel = ESimdLevel::Scalar; }
+			else if (Name == "sse") { SimdLevel = ESimdLevel::SSE; }
+			else if (Name == "avx2") { SimdLevel = ESimdLevel::AVX2; }
+			else if (Name == "avx512") { SimdLevel = ESimdLevel::AVX512; }
+			else if (Name == "neon") { SimdLevel = ESimdLevel::NEON; }
+			else
+			{
+				std::printf("Unknown SIMD level '%s'\n", Name.c_str());
+				return 1;
+			}
+
+			if (!IsSimdLevelSupported(SimdLevel))
+			{
+				std::printf("%s kernels are not supported on this CPU\n", GetSimdLevelName(SimdLevel));
+				return 1;
+			}
+		}
+		else
+		{
+			std::printf("Usage: %s [--quick] [--csv] [--filter=<substring>] [--simd=scalar|sse|avx2|avx512|neon]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	SetActiveSimdLevel(SimdLevel);
+
+	const double MinSeconds = bQuick ? 0.0005 : 0.02;
+	const std::vector<int32> BlockSizes = bQuick ? std::vector<int32>{ 64, 4096 } : std::vector<int32>{ 64, 128, 256, 512, 1024, 2048, 4096 };
+	const std::vector<float> SampleRates = bQuick ? std::vector<float>{ 48000.0f } : std::vector<float>{ 44100.0f, 48000.0f, 96000.0f };
+	const EParamCase ParamCases[] = { EParamCase::Static, EParamCase::PerBlock, EParamCase::PerSample };
+
+	if (bCsv)
+	{
+		std::printf("node,sample_rate,block_size,params,ns_per_block,ns_per_sample,bytes_per_block\n");
+	}
+	else
+	{
+		std::printf("Kernels: %s\n", GetSimdLevelName(GetActiveSimdLevel()));
+		std::printf("%-32s %8s %6s %-10s %14s %12s %14s\n", "Node", "Rate", "Block", "Params", "ns/block", "ns/sample", "bytes/block");
+	}
+
+	for (const FNodeBench& Bench : GetNodeBenches())
+	{
+		if (!Filter.empty() && Bench.Name.find(Filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		for (float SampleRate : SampleRates)
+		{
+			for (int32 BlockSize : BlockSizes)
+			{
+				for (EParamCase ParamCase : ParamCases)
+				{
+					FBenchConfig Config;
+					Config.BlockSize = BlockSize;
+					Config.SampleRate = SampleRate;
+					Config.ParamCase = ParamCase;
+
+					std::unique_ptr<IBenchRunner> Runner = Bench.Create(Config);
+					const FBenchResult Result = RunBench(*Runner, Config, MinSeconds);
+
+					if (bCsv)
+					{
+						std::printf("%s,%.0f,%d,%s,%.1f,%.3f,%.0f\n", Bench.Name.c_str(), SampleRate, BlockSize, LexToString(ParamCase),
+							Result.NanosecondsPerBlock, Result.NanosecondsPerSample, Result.BytesPerBlock);
+					}
+					else
+					{
+						std::printf("%-32s %8.0f %6d %-10s %14.1f %12.3f %14.0f\n", Bench.Name.c_str(), SampleRate, BlockSize, LexToString(ParamCase),
+							Result.NanosecondsPerBlock, Result.NanosecondsPerSample, Result.BytesPerBlock);
+					}
+				}
+			}
+		}
+	}
+
+	return 0;
+}
@@ -52,6 +52,11 @@ public class MS_Utils : ModuleRules
 			);
 		
 		
+		// Per node type block counters and timers (MSUtilsDSP/NodeStats.h) and the live telemetry view
+		// (MSUtilsDSP/Telemetry.h), both left out of Shipping builds
+		PublicDefinitions.Add("MSUTILS_NODE_STATS=" + (Target.Configuration == UnrealTargetConfiguration.Shipping ? "0" : "1"));
+		PublicDefinitions.Add("MSUTILS_TELEMETRY=" + (Target.Configuration == UnrealTargetConfiguration.Shipping ? "0" : "1"));
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -2,11 +2,19 @@
 
 #include "CrossfadeByParam.h"
 
-#include "DSP/FloatArrayMath.h"
 #include "MetasoundStandardNodesCategories.h"
+#include "MSUtilsChannelLayout.h"
+#include "MSUtilsConstantInputs.h"
+#include "MSUtilsProfiling.h"
+#include "MSUtilsVertexNames.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_CrossfadeByParam"
 
+#define REGISTER_CBP_MULTI_ZONE_NODE(Number) \
+	using FCBPMultiZoneNode##Number = TCBPMultiZoneNode<Number>; \
+	METASOUND_REGISTER_NODE(FCBPMultiZoneNode##Number) \
+
+
 namespace Metasound
 {
 	//the below stores name and tooltip information for each input/output pin - Name and then description.
@@ -20,6 +28,111 @@ namespace Metasound
 		METASOUND_PARAM(InFadeOutEnd, "Fade Out End", "Fade Out End");
 		METASOUND_PARAM(InAudioParam, "Audio In", "Input Audio Channel");
 		METASOUND_PARAM(OutAudioParam, "Audio Out", "Audio Output");
+		METASOUND_PARAM(OutMutedParam, "Is Muted", "True while the input value is outside the zone, or close enough to its edge that the gain is below the silence threshold, and the output is silent");
+	}
+
+	// Zones are numbered from 0, like the inputs of the other crossfade nodes
+	namespace ECBPMultiZoneNames
+	{
+		const FVertexName GetInputName(uint32 Zone)
+		{
+			return *FString::Format(TEXT("Audio In {0}"), { Zone });
+		}
+
+		const FVertexName GetFadeInStartName(uint32 Zone)
+		{
+			return *FString::Format(TEXT("Fade In Start {0}"), { Zone });
+		}
+
+		const FVertexName GetFadeInEndName(uint32 Zone)
+		{
+			return *FString::Format(TEXT("Fade In End {0}"), { Zone });
+		}
+
+		const FVertexName GetFadeOutStartName(uint32 Zone)
+		{
+			return *FString::Format(TEXT("Fade Out Start {0}"), { Zone });
+		}
+
+		const FVertexName GetFadeOutEndName(uint32 Zone)
+		{
+			return *FString::Format(TEXT("Fade Out End {0}"), { Zone });
+		}
+
+		// Every pin name of one zone count, formatted once when the variant is first used, so creating and binding
+		// operators only looks them up
+		template<int32 NumZones>
+		struct TPinNames
+		{
+			static const TPinNames& Get()
+			{
+				static const TPinNames Names;
+				return Names;
+			}
+
+			MSUtilsVertexNames::TVertexNameArray<NumZones> Inputs{ [](int32 Zone) { return GetInputName(Zone); } };
+			MSUtilsVertexNames::TVertexNameArray<NumZones> FadeInStarts{ [](int32 Zone) { return GetFadeInStartName(Zone); } };
+			MSUtilsVertexNames::TVertexNameArray<NumZones> FadeInEnds{ [](int32 Zone) { return GetFadeInEndName(Zone); } };
+			MSUtilsVertexNames::TVertexNameArray<NumZones> FadeOutStarts{ [](int32 Zone) { return GetFadeOutStartName(Zone); } };
+			MSUtilsVertexNames::TVertexNameArray<NumZones> FadeOutEnds{ [](int32 Zone) { return GetFadeOutEndName(Zone); } };
+		};
+	}
+
+	// Shared by every channel count
+	MSUTILS_DECLARE_NODE_STATS(CrossfadeByParam, "Crossfade By Param");
+	// Shared by every zone count
+	MSUTILS_DECLARE_NODE_STATS(CrossfadeByParamMultiZone, "Crossfade By Param (Multi-Zone)");
+
+	namespace
+	{
+		// True if neither the input value nor any edge of the zone is connected, so the gain can never change
+		bool IsConstantCBPZone(const FDataReferenceCollection& InputCollection)
+		{
+			using namespace ECBPNodeNames;
+			using namespace MSUtilsConstantInputs;
+
+			return IsConstant<float>(InputCollection, METASOUND_GET_PARAM_NAME(InFloatValue))
+				&& IsConstant<float>(InputCollection, METASOUND_GET_PARAM_NAME(InFadeInStart))
+				&& IsConstant<float>(InputCollection, METASOUND_GET_PARAM_NAME(InFadeInEnd))
+				&& IsConstant<float>(InputCollection, METASOUND_GET_PARAM_NAME(InFadeOutStart))
+				&& IsConstant<float>(InputCollection, METASOUND_GET_PARAM_NAME(InFadeOutEnd));
+		}
+
+		// Binds the value and zone inputs, returning false if any of them now reads from somewhere else and a fixed
+		// zone worked out from them no longer holds
+		bool BindCBPZoneInputs(FInputVertexInterfaceData& InOutVertexData, FFloatReadRef& FloatIn, FFloatReadRef& FadeInStart, FFloatReadRef& FadeInEnd, FFloatReadRef& FadeOutStart, FFloatReadRef& FadeOutEnd)
+		{
+			using namespace ECBPNodeNames;
+			using namespace MSUtilsConstantInputs;
+
+			bool bUnchanged = BindReadVertexUnchanged(InOutVertexData, METASOUND_GET_PARAM_NAME(InFloatValue), FloatIn);
+			bUnchanged &= BindReadVertexUnchanged(InOutVertexData, METASOUND_GET_PARAM_NAME(InFadeInStart), FadeInStart);
+			bUnchanged &= BindReadVertexUnchanged(InOutVertexData, METASOUND_GET_PARAM_NAME(InFadeInEnd), FadeInEnd);
+			bUnchanged &= BindReadVertexUnchanged(InOutVertexData, METASOUND_GET_PARAM_NAME(InFadeOutStart), FadeOutStart);
+			bUnchanged &= BindReadVertexUnchanged(InOutVertexData, METASOUND_GET_PARAM_NAME(InFadeOutEnd), FadeOutEnd);
+			return bUnchanged;
+		}
+
+		// A fixed zone's gain never changes, so it is published once, from the audio thread that owns the telemetry
+		// ring, on the first block telemetry is on for
+		void PublishFixedTelemetry(MSUtilsDSP::FTelemetryPublisher& Telemetry, const MSUtilsDSP::FFixedZoneFader& FixedFader, bool& bPublished)
+		{
+			if (!bPublished && Telemetry.IsActive())
+			{
+				Telemetry.PublishGain(FixedFader.GetAmplitude());
+				Telemetry.PublishState(FixedFader.IsMuted() ? "Fixed (Muted)" : "Fixed");
+				bPublished = true;
+			}
+		}
+
+		void PublishTelemetry(MSUtilsDSP::FTelemetryPublisher& Telemetry, const MSUtilsDSP::FMappedRangeFader& Fader)
+		{
+			if (Telemetry.IsActive())
+			{
+				Telemetry.PublishGain(Fader.GetAmplitude());
+				Telemetry.PublishState(MSUtilsDSP::GetZoneGainStateName(Fader.GetGainState()));
+			}
+		}
 	}
 
 	FCBPOperator::FCBPOperator(const FOperatorSettings& InSettings,
@@ -28,7 +141,8 @@ namespace Metasound
 		const FFloatReadRef& FadeInStartIn,
 		const FFloatReadRef& FadeInEndIn,
 		const FFloatReadRef& FadeOutStartIn,
-		const FFloatReadRef& FadeOutEndIn)
+		const FFloatReadRef& FadeOutEndIn,
+		bool bConstantZone)
 		: AudioInput(InAudio),
 		FloatIn(ValueIn),
 		FadeInStart(FadeInStartIn),
@@ -36,38 +150,82 @@ namespace Metasound
 		FadeOutStart(FadeOutStartIn),
 		FadeOutEnd(FadeOutEndIn),
 		AudioOutput(FAudioBufferWriteRef::CreateNew(InSettings)),
-		NumFramesPerBlock(InSettings.GetNumFramesPerBlock())
+		OutMuted(FBoolWriteRef::CreateNew(false)),
+		NumFramesPerBlock(InSettings.GetNumFramesPerBlock()),
+		InstanceCounter(MSUtilsNodeStatsCrossfadeByParam),
+		Telemetry(MSUtilsNodeStatsCrossfadeByParam.GetName())
 	{
-
+		if (bConstantZone)
+		{
+			FixedFader.Emplace(*FloatIn, MSUtilsDSP::FTrapezoidZone{ *FadeInStart, *FadeInEnd, *FadeOutStart, *FadeOutEnd }, MSUtilsDSP::GetSilenceThreshold());
+			*OutMuted = FixedFader->IsMuted();
+		}
 	};
 
-	void FCBPOperator::Execute()
+	IOperator::FExecuteFunction FCBPOperator::GetExecuteFunction()
 	{
-		FMemory::Memcpy(AudioOutput->GetData(), AudioInput->GetData(), sizeof(float) * AudioInput->Num());
-
-		if (*FloatIn != FloatInPrev || bInit == false)
+		if (!FixedFader.IsSet())
 		{
-			if (!bInit)
-			{
-				bInit = true;
-			}
+			return TExecutableOperator<FCBPOperator>::GetExecuteFunction();
+		}
 
-			float FadeInValue = FMath::GetMappedRangeValueClamped(FVector2D(*FadeInStart, *FadeInEnd), FVector2D(0.f, 1.f), *FloatIn);
-			float FadeOutValue = FMath::GetMappedRangeValueClamped(FVector2D(*FadeOutStart, *FadeOutEnd), FVector2D(1.f, 0.f), *FloatIn);
+		return &FCBPOperator::ExecuteFixedFunction;
+	}
 
-			Amplitude = FadeInValue * FadeOutValue;
+	void FCBPOperator::ExecuteFixedFunction(IOperator* InOperator)
+	{
+		static_cast<FCBPOperator*>(InOperator)->ExecuteFixed();
+	}
+
+	void FCBPOperator::ExecuteFixed()
+	{
+		if (!FixedFader.IsSet())
+		{
+			// BindInputs connected something the fixed zone was worked out from after this function was handed out
+			Execute();
+			return;
+		}
 
-			Audio::ArrayFade(*AudioOutput, AmplitudePrev, Amplitude);
+		MSUTILS_NODE_EXECUTE_SCOPE(CrossfadeByParam);
+		MSUTILS_NODE_FAST_PATH(true);
+		PublishFixedTelemetry(Telemetry, *FixedFader, bFixedTelemetryPublished);
+		// The output is created silent and a zone muted for good never writes to it
+		if (!FixedFader->IsMuted())
+		{
+			const MSUtilsDSP::FScopedFlushDenormals FlushDenormals(MSUtilsDSP::IsDenormalFlushEnabled());
+			FixedFader->Process(AudioInput->GetData(), AudioOutput->GetData(), NumFramesPerBlock);
+		}
+	}
 
-			FloatInPrev = *FloatIn;
-			AmplitudePrev = Amplitude;
+	void FCBPOperator::Reset(const IOperator::FResetParams& InParams)
+	{
+		AudioOutput->Zero();
+		if (FixedFader.IsSet())
+		{
+			// The zone is constant, so only the ramp in from silence has to happen again
+			FixedFader->Reset();
+			*OutMuted = FixedFader->IsMuted();
 		}
 		else
 		{
-			Audio::ArrayFade(*AudioOutput, AmplitudePrev, Amplitude);
+			Fader.Reset();
+			*OutMuted = false;
 		}
 	}
 
+	void FCBPOperator::Execute()
+	{
+		MSUTILS_NODE_EXECUTE_SCOPE(CrossfadeByParam);
+		const MSUtilsDSP::FScopedFlushDenormals FlushDenormals(MSUtilsDSP::IsDenormalFlushEnabled());
+		Fader.SetSilenceThreshold(MSUtilsDSP::GetSilenceThreshold());
+
+		const MSUtilsDSP::FTrapezoidZone Zone = { *FadeInStart, *FadeInEnd, *FadeOutStart, *FadeOutEnd };
+		Fader.Process(*FloatIn, Zone, AudioInput->GetData(), AudioOutput->GetData(), NumFramesPerBlock);
+		*OutMuted = Fader.IsMuted();
+		PublishTelemetry(Telemetry, Fader);
+		MSUTILS_NODE_FAST_PATH(Fader.GetGainState() == MSUtilsDSP::EZoneGainState::Muted || Fader.GetGainState() == MSUtilsDSP::EZoneGainState::Unity);
+	}
+
 	const FVertexInterface& FCBPOperator::DeclareVertexInterface()
 	{
 		using namespace ECBPNodeNames;
@@ -82,7 +240,8 @@ namespace Metasound
 				TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InAudioParam))
 			),
 			FOutputVertexInterface(
-				TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutAudioParam))
+				TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutAudioParam)),
+				TOutputDataVertexModel<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutMutedParam))
 			)
 		);
 
@@ -99,7 +258,7 @@ namespace Metasound
 				{
 						{ TEXT("UE"), TEXT("CrossfadeByParam"), TEXT("Audio") },
 						1, // Major Version
-						0, // Minor Version
+						1, // Minor Version
 						METASOUND_LOCTEXT("CBPDisplayName", "Crossfade By Param (Mono)"),
 						METASOUND_LOCTEXT("CPTestNodeDesc", "Fades in and out a single audio channel by a mapped range"),
 						PluginAuthor,
@@ -120,11 +279,12 @@ namespace Metasound
 	void FCBPOperator::BindInputs(FInputVertexInterfaceData& InOutVertexData)
 	{
 		using namespace ECBPNodeNames;
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFloatValue), FloatIn);
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFadeInStart), FadeInStart);
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFadeInEnd), FadeInEnd);
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFadeOutStart), FadeOutStart);
-		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFadeOutEnd), FadeOutEnd);
+		if (!BindCBPZoneInputs(InOutVertexData, FloatIn, FadeInStart, FadeInEnd, FadeOutStart, FadeOutEnd) && FixedFader.IsSet())
+		{
+			// The zone can change now, so it goes back to being worked out every block
+			FixedFader.Reset();
+			*OutMuted = false;
+		}
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InAudioParam), AudioInput);
 	}
 
@@ -132,6 +292,7 @@ namespace Metasound
 	{
 		using namespace ECBPNodeNames;
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutAudioParam), AudioOutput);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutMutedParam), OutMuted);
 	}
 
 	TUniquePtr<IOperator> FCBPOperator::CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
@@ -149,12 +310,515 @@ namespace Metasound
 
 		FAudioBufferReadRef AudioIn1 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InAudioParam), InParams.OperatorSettings);
 
+		const bool bConstantZone = IsConstantCBPZone(InputCollection);
+
 		//this class is FCBPOperator, which inherits from TExecutableOperator, which inherits from IOperator. IOperator type is returned
-		return MakeUnique<FCBPOperator>(InParams.OperatorSettings, AudioIn1, FloatInputA, FadeInStartFloat, FadeInEndFloat, FadeOutStartFloat, FadeOutEndFloat);
+		return MakeUnique<FCBPOperator>(InParams.OperatorSettings, AudioIn1, FloatInputA, FadeInStartFloat, FadeInEndFloat, FadeOutStartFloat, FadeOutEndFloat, bConstantZone);
 	}
 
+	//------------------------------------------------------------------------------------
+	// TCBPMultichannelOperator
+	//------------------------------------------------------------------------------------
+
+	// Crossfade By Param on a planar multichannel signal. The zone gain is computed once per block and applied to every channel.
+	template<int32 NumChannels>
+	class TCBPMultichannelOperator : public TExecutableOperator<TCBPMultichannelOperator<NumChannels>>
+	{
+	public:
+		// Fixed capacity, so building the operator never allocates for its input references
+		using FAudioInputArray = TArray<FAudioBufferReadRef, TFixedAllocator<NumChannels>>;
+
+		TCBPMultichannelOperator(const FOperatorSettings& InSettings,
+			FAudioInputArray&& InAudio,
+			const FFloatReadRef& ValueIn,
+			const FFloatReadRef& FadeInStartIn,
+			const FFloatReadRef& FadeInEndIn,
+			const FFloatReadRef& FadeOutStartIn,
+			const FFloatReadRef& FadeOutEndIn,
+			bool bConstantZone = false)
+			: FloatIn(ValueIn),
+			FadeInStart(FadeInStartIn),
+			FadeInEnd(FadeInEndIn),
+			FadeOutStart(FadeOutStartIn),
+			FadeOutEnd(FadeOutEndIn),
+			AudioInputs(MoveTemp(InAudio)),
+			OutMuted(FBoolWriteRef::CreateNew(false)),
+			NumFramesPerBlock(InSettings.GetNumFramesPerBlock()),
+			InstanceCounter(MSUtilsNodeStatsCrossfadeByParam),
+			Telemetry(MSUtilsNodeStatsCrossfadeByParam.GetName())
+		{
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				AudioOutputs.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+				OutputData[Channel] = AudioOutputs[Channel]->GetData();
+			}
+			GatherInputData();
+
+			if (bConstantZone)
+			{
+				FixedFader.Emplace(*FloatIn, MSUtilsDSP::FTrapezoidZone{ *FadeInStart, *FadeInEnd, *FadeOutStart, *FadeOutEnd }, MSUtilsDSP::GetSilenceThreshold());
+				*OutMuted = FixedFader->IsMuted();
+			}
+		}
+
+		static const FVertexInterface& DeclareVertexInterface()
+		{
+			using namespace ECBPNodeNames;
+
+			auto CreateVertexInterface = []() -> FVertexInterface
+				{
+					FInputVertexInterface InputInterface;
+					InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFloatValue)));
+					InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFadeInStart)));
+					InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFadeInEnd)));
+					InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFadeOutStart)));
+					InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFadeOutEnd)));
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+					{
+						InputInterface.Add(TInputDataVertex<FAudioBuffer>(MSUtilsChannelLayout::GetChannelVertexName(METASOUND_GET_PARAM_NAME(InAudioParam), NumChannels, Channel), MSUtilsChannelLayout::GetChannelVertexMetadata(METASOUND_GET_PARAM_TT(InAudioParam), NumChannels, Channel)));
+					}
+
+					FOutputVertexInterface OutputInterface;
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+					{
+						OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(MSUtilsChannelLayout::GetChannelVertexName(METASOUND_GET_PARAM_NAME(OutAudioParam), NumChannels, Channel), MSUtilsChannelLayout::GetChannelVertexMetadata(METASOUND_GET_PARAM_TT(OutAudioParam), NumChannels, Channel)));
+					}
+					OutputInterface.Add(TOutputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutMutedParam)));
+
+					return FVertexInterface(InputInterface, OutputInterface);
+				};
+
+			static const FVertexInterface Interface = CreateVertexInterface();
+			return Interface;
+		}
+
+		static const FNodeClassMetadata& GetNodeInfo()
+		{
+			auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+				{
+					FVertexInterface NodeInterface = DeclareVertexInterface();
+
+					FNodeClassMetadata Metadata
+					{
+							{ TEXT("UE"), TEXT("CrossfadeByParam"), *FString::Printf(TEXT("Audio %s"), MSUtilsChannelLayout::GetLayoutName(NumChannels)) },
+							1, // Major Version
+							0, // Minor Version
+							FText::Format(METASOUND_LOCTEXT("CBPMultichannelDisplayName", "Crossfade By Param ({0})"), MSUtilsChannelLayout::GetLayoutDisplayName(NumChannels)),
+							METASOUND_LOCTEXT("CBPMultichannelNodeDesc", "Fades in and out a multichannel signal by a mapped range"),
+							PluginAuthor,
+							PluginNodeMissingPrompt,
+							NodeInterface,
+							{ NodeCategories::Envelopes },
+							{ },
+							FNodeDisplayStyle{}
+					};
+
+					return Metadata;
+				};
+
+			static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+			return Metadata;
+		}
+
+		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+		{
+			if (!BindCBPZoneInputs(InOutVertexData, FloatIn, FadeInStart, FadeInEnd, FadeOutStart, FadeOutEnd) && FixedFader.IsSet())
+			{
+				FixedFader.Reset();
+				*OutMuted = false;
+			}
+			const FPinNames& Names = GetPinNames();
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InOutVertexData.BindReadVertex(Names.AudioInputs[Channel], AudioInputs[Channel]);
+			}
+			GatherInputData();
+		}
+
+		virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace ECBPNodeNames;
+			const FPinNames& Names = GetPinNames();
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InOutVertexData.BindReadVertex(Names.AudioOutputs[Channel], AudioOutputs[Channel]);
+			}
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutMutedParam), OutMuted);
+		}
+
+		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+		{
+			using namespace ECBPNodeNames;
+
+			const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
+			const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+
+			TDataReadReference<float> FloatInputA = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InFloatValue), InParams.OperatorSettings);
+			TDataReadReference<float> FadeInStartFloat = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InFadeInStart), InParams.OperatorSettings);
+			TDataReadReference<float> FadeInEndFloat = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InFadeInEnd), InParams.OperatorSettings);
+			TDataReadReference<float> FadeOutStartFloat = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InFadeOutStart), InParams.OperatorSettings);
+			TDataReadReference<float> FadeOutEndFloat = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InFadeOutEnd), InParams.OperatorSettings);
+
+			const FPinNames& Names = GetPinNames();
+			FAudioInputArray AudioIn;
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				AudioIn.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, Names.AudioInputs[Channel], InParams.OperatorSettings));
+			}
+
+			return MakeUnique<TCBPMultichannelOperator<NumChannels>>(InParams.OperatorSettings, MoveTemp(AudioIn), FloatInputA, FadeInStartFloat, FadeInEndFloat, FadeOutStartFloat, FadeOutEndFloat, IsConstantCBPZone(InputCollection));
+		}
+
+		void Execute()
+		{
+			MSUTILS_NODE_EXECUTE_SCOPE(CrossfadeByParam);
+			const MSUtilsDSP::FScopedFlushDenormals FlushDenormals(MSUtilsDSP::IsDenormalFlushEnabled());
+			Fader.SetSilenceThreshold(MSUtilsDSP::GetSilenceThreshold());
+
+			const MSUtilsDSP::FTrapezoidZone Zone = { *FadeInStart, *FadeInEnd, *FadeOutStart, *FadeOutEnd };
+			Fader.Process(*FloatIn, Zone, InputData, OutputData, NumChannels, NumFramesPerBlock);
+			*OutMuted = Fader.IsMuted();
+			PublishTelemetry(Telemetry, Fader);
+			MSUTILS_NODE_FAST_PATH(Fader.GetGainState() == MSUtilsDSP::EZoneGainState::Muted || Fader.GetGainState() == MSUtilsDSP::EZoneGainState::Unity);
+		}
+
+		void Reset(const IOperator::FResetParams& InParams)
+		{
+			for (FAudioBufferWriteRef& AudioOutput : AudioOutputs)
+			{
+				AudioOutput->Zero();
+			}
+			if (FixedFader.IsSet())
+			{
+				FixedFader->Reset();
+				*OutMuted = FixedFader->IsMuted();
+			}
+			else
+			{
+				Fader.Reset();
+				*OutMuted = false;
+			}
+		}
+
+		// Same fixed gain path as FCBPOperator
+		virtual IOperator::FExecuteFunction GetExecuteFunction() override
+		{
+			if (!FixedFader.IsSet())
+			{
+				return TExecutableOperator<TCBPMultichannelOperator<NumChannels>>::GetExecuteFunction();
+			}
+			return &TCBPMultichannelOperator<NumChannels>::ExecuteFixedFunction;
+		}
+
+	private:
+		// Channel pin names, formatted once per layout
+		struct FPinNames
+		{
+			MSUtilsChannelLayout::TChannelVertexNames<NumChannels> AudioInputs;
+			MSUtilsChannelLayout::TChannelVertexNames<NumChannels> AudioOutputs;
+		};
+
+		static const FPinNames& GetPinNames()
+		{
+			using namespace ECBPNodeNames;
+			static const FPinNames Names
+			{
+				MSUtilsChannelLayout::TChannelVertexNames<NumChannels>(METASOUND_GET_PARAM_NAME(InAudioParam)),
+				MSUtilsChannelLayout::TChannelVertexNames<NumChannels>(METASOUND_GET_PARAM_NAME(OutAudioParam))
+			};
+			return Names;
+		}
+
+		static void ExecuteFixedFunction(IOperator* InOperator)
+		{
+			static_cast<TCBPMultichannelOperator<NumChannels>*>(InOperator)->ExecuteFixed();
+		}
+
+		void ExecuteFixed()
+		{
+			if (!FixedFader.IsSet())
+			{
+				Execute();
+				return;
+			}
+
+			MSUTILS_NODE_EXECUTE_SCOPE(CrossfadeByParam);
+			MSUTILS_NODE_FAST_PATH(true);
+			PublishFixedTelemetry(Telemetry, *FixedFader, bFixedTelemetryPublished);
+			if (!FixedFader->IsMuted())
+			{
+				const MSUtilsDSP::FScopedFlushDenormals FlushDenormals(MSUtilsDSP::IsDenormalFlushEnabled());
+				FixedFader->Process(InputData, OutputData, NumChannels, NumFramesPerBlock);
+			}
+		}
+
+		void GatherInputData()
+		{
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InputData[Channel] = AudioInputs[Channel]->GetData();
+			}
+		}
+
+		FFloatReadRef FloatIn;
+		FFloatReadRef FadeInStart;
+		FFloatReadRef FadeInEnd;
+		FFloatReadRef FadeOutStart;
+		FFloatReadRef FadeOutEnd;
+		FAudioInputArray AudioInputs;
+		TArray<FAudioBufferWriteRef, TFixedAllocator<NumChannels>> AudioOutputs;
+		FBoolWriteRef OutMuted;
+		int32 NumFramesPerBlock = 0;
+		const float* InputData[NumChannels] = {};
+		float* OutputData[NumChannels] = {};
+		MSUtilsDSP::FMappedRangeFader Fader;
+		TOptional<MSUtilsDSP::FFixedZoneFader> FixedFader;
+		bool bFixedTelemetryPublished = false;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+		MSUtilsDSP::FTelemetryPublisher Telemetry;
+	};
+
+	template<int32 NumChannels>
+	class TCBPMultichannelNode : public FNodeFacade
+	{
+	public:
+		//MetaSound frontend constructor
+		TCBPMultichannelNode(const FNodeInitData& InitData) : FNodeFacade(InitData.InstanceName, InitData.InstanceID,
+			TFacadeOperatorClass<TCBPMultichannelOperator<NumChannels>>())
+		{
+		}
+	};
+
+	using FCBPStereoNode = TCBPMultichannelNode<2>;
+	using FCBPFivePointOneNode = TCBPMultichannelNode<6>;
+	using FCBPSevenPointOneNode = TCBPMultichannelNode<8>;
+
+	//------------------------------------------------------------------------------------
+	// TCBPMultiZoneOperator
+	//------------------------------------------------------------------------------------
+
+	// Several Crossfade By Param zones, one input each, driven by a single value and mixed into one output, for layer
+	// stacks that would otherwise be a Crossfade By Param per layer feeding a mixer. Every zone's gain is worked out
+	// in one pass and only the zones the value is in are mixed.
+	template<int32 NumZones>
+	class TCBPMultiZoneOperator : public TExecutableOperator<TCBPMultiZoneOperator<NumZones>>
+	{
+	public:
+		// Fixed capacity, so building the operator never allocates for its input references
+		using FEdgeArray = TArray<FFloatReadRef, TFixedAllocator<NumZones>>;
+		using FAudioInputArray = TArray<FAudioBufferReadRef, TFixedAllocator<NumZones>>;
+
+		TCBPMultiZoneOperator(const FOperatorSettings& InSettings,
+			const FFloatReadRef& ValueIn,
+			FAudioInputArray&& InAudio,
+			FEdgeArray&& InFadeInStarts,
+			FEdgeArray&& InFadeInEnds,
+			FEdgeArray&& InFadeOutStarts,
+			FEdgeArray&& InFadeOutEnds)
+			: FloatIn(ValueIn),
+			AudioInputs(MoveTemp(InAudio)),
+			FadeInStarts(MoveTemp(InFadeInStarts)),
+			FadeInEnds(MoveTemp(InFadeInEnds)),
+			FadeOutStarts(MoveTemp(InFadeOutStarts)),
+			FadeOutEnds(MoveTemp(InFadeOutEnds)),
+			AudioOutput(FAudioBufferWriteRef::CreateNew(InSettings)),
+			OutMuted(FBoolWriteRef::CreateNew(false)),
+			NumFramesPerBlock(InSettings.GetNumFramesPerBlock()),
+			InstanceCounter(MSUtilsNodeStatsCrossfadeByParamMultiZone),
+			Telemetry(MSUtilsNodeStatsCrossfadeByParamMultiZone.GetName())
+		{
+			GatherInputData();
+		}
+
+		static const FVertexInterface& DeclareVertexInterface()
+		{
+			using namespace ECBPNodeNames;
+			using namespace ECBPMultiZoneNames;
+
+			auto CreateVertexInterface = []() -> FVertexInterface
+				{
+					FInputVertexInterface InputInterface;
+					InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFloatValue)));
+					for (uint32 Zone = 0; Zone < NumZones; ++Zone)
+					{
+						InputInterface.Add(TInputDataVertex<FAudioBuffer>(GetInputName(Zone), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("CBPMultiZoneInputDesc", "Input of zone {0}", Zone) }));
+						InputInterface.Add(TInputDataVertex<float>(GetFadeInStartName(Zone), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("CBPMultiZoneFadeInStartDesc", "Fade In Start of zone {0}", Zone) }));
+						InputInterface.Add(TInputDataVertex<float>(GetFadeInEndName(Zone), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("CBPMultiZoneFadeInEndDesc", "Fade In End of zone {0}", Zone) }));
+						InputInterface.Add(TInputDataVertex<float>(GetFadeOutStartName(Zone), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("CBPMultiZoneFadeOutStartDesc", "Fade Out Start of zone {0}", Zone) }));
+						InputInterface.Add(TInputDataVertex<float>(GetFadeOutEndName(Zone), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("CBPMultiZoneFadeOutEndDesc", "Fade Out End of zone {0}", Zone) }));
+					}
+
+					FOutputVertexInterface OutputInterface;
+					OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutAudioParam)));
+					OutputInterface.Add(TOutputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutMutedParam)));
+
+					return FVertexInterface(InputInterface, OutputInterface);
+				};
+
+			static const FVertexInterface Interface = CreateVertexInterface();
+			return Interface;
+		}
+
+		static const FNodeClassMetadata& GetNodeInfo()
+		{
+			auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+				{
+					FNodeClassMetadata Metadata
+					{
+							{ TEXT("UE"), TEXT("CrossfadeByParamMultiZone"), *FString::Printf(TEXT("Audio %d"), NumZones) },
+							1, // Major Version
+							0, // Minor Version
+							METASOUND_LOCTEXT_FORMAT("CBPMultiZoneDisplayName", "Crossfade By Param ({0} Zones)", NumZones),
+							METASOUND_LOCTEXT("CBPMultiZoneNodeDesc", "Fades several inputs in and out by their own mapped ranges of one value and mixes them into a single output"),
+							PluginAuthor,
+							PluginNodeMissingPrompt,
+							DeclareVertexInterface(),
+							{ NodeCategories::Envelopes },
+							{ },
+							FNodeDisplayStyle{}
+					};
+
+					return Metadata;
+				};
+
+			static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+			return Metadata;
+		}
+
+		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace ECBPNodeNames;
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFloatValue), FloatIn);
+
+			const ECBPMultiZoneNames::TPinNames<NumZones>& Names = ECBPMultiZoneNames::TPinNames<NumZones>::Get();
+			for (int32 Zone = 0; Zone < NumZones; ++Zone)
+			{
+				InOutVertexData.BindReadVertex(Names.Inputs[Zone], AudioInputs[Zone]);
+				InOutVertexData.BindReadVertex(Names.FadeInStarts[Zone], FadeInStarts[Zone]);
+				InOutVertexData.BindReadVertex(Names.FadeInEnds[Zone], FadeInEnds[Zone]);
+				InOutVertexData.BindReadVertex(Names.FadeOutStarts[Zone], FadeOutStarts[Zone]);
+				InOutVertexData.BindReadVertex(Names.FadeOutEnds[Zone], FadeOutEnds[Zone]);
+			}
+			GatherInputData();
+		}
+
+		virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace ECBPNodeNames;
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutAudioParam), AudioOutput);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutMutedParam), OutMuted);
+		}
+
+		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+		{
+			using namespace ECBPNodeNames;
+
+			const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
+			const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+
+			TDataReadReference<float> FloatInputA = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InFloatValue), InParams.OperatorSettings);
+
+			const ECBPMultiZoneNames::TPinNames<NumZones>& Names = ECBPMultiZoneNames::TPinNames<NumZones>::Get();
+			FAudioInputArray AudioIn;
+			FEdgeArray FadeInStartFloats;
+			FEdgeArray FadeInEndFloats;
+			FEdgeArray FadeOutStartFloats;
+			FEdgeArray FadeOutEndFloats;
+			for (int32 Zone = 0; Zone < NumZones; ++Zone)
+			{
+				AudioIn.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, Names.Inputs[Zone], InParams.OperatorSettings));
+				FadeInStartFloats.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, Names.FadeInStarts[Zone], InParams.OperatorSettings));
+				FadeInEndFloats.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, Names.FadeInEnds[Zone], InParams.OperatorSettings));
+				FadeOutStartFloats.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, Names.FadeOutStarts[Zone], InParams.OperatorSettings));
+				FadeOutEndFloats.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, Names.FadeOutEnds[Zone], InParams.OperatorSettings));
+			}
+
+			return MakeUnique<TCBPMultiZoneOperator<NumZones>>(InParams.OperatorSettings, FloatInputA, MoveTemp(AudioIn),
+				MoveTemp(FadeInStartFloats), MoveTemp(FadeInEndFloats), MoveTemp(FadeOutStartFloats), MoveTemp(FadeOutEndFloats));
+		}
+
+		void Execute()
+		{
+			MSUTILS_NODE_EXECUTE_SCOPE(CrossfadeByParamMultiZone);
+			const MSUtilsDSP::FScopedFlushDenormals FlushDenormals(MSUtilsDSP::IsDenormalFlushEnabled());
+			Fader.SetSilenceThreshold(MSUtilsDSP::GetSilenceThreshold());
+
+			// The zone edges are read into contiguous arrays so the fader can work out every zone's gain in a single pass
+			for (int32 Zone = 0; Zone < NumZones; ++Zone)
+			{
+				FadeInStartData[Zone] = *FadeInStarts[Zone];
+				FadeInEndData[Zone] = *FadeInEnds[Zone];
+				FadeOutStartData[Zone] = *FadeOutStarts[Zone];
+				FadeOutEndData[Zone] = *FadeOutEnds[Zone];
+			}
+			const MSUtilsDSP::FTrapezoidZoneArrays Zones = { FadeInStartData, FadeInEndData, FadeOutStartData, FadeOutEndData };
+
+			Fader.Process(*FloatIn, Zones, InputData, AudioOutput->GetData(), NumFramesPerBlock);
+			*OutMuted = Fader.IsMuted();
+			if (Telemetry.IsActive())
+			{
+				Telemetry.PublishState(Fader.IsMuted() ? "Muted" : "Mixing");
+			}
+			MSUTILS_NODE_FAST_PATH(Fader.GetNumActiveZones() <= 1);
+		}
+
+		void Reset(const IOperator::FResetParams& InParams)
+		{
+			AudioOutput->Zero();
+			Fader.Reset();
+			*OutMuted = false;
+		}
+
+	private:
+		void GatherInputData()
+		{
+			for (int32 Zone = 0; Zone < NumZones; ++Zone)
+			{
+				InputData[Zone] = AudioInputs[Zone]->GetData();
+			}
+		}
+
+		FFloatReadRef FloatIn;
+		FAudioInputArray AudioInputs;
+		FEdgeArray FadeInStarts;
+		FEdgeArray FadeInEnds;
+		FEdgeArray FadeOutStarts;
+		FEdgeArray FadeOutEnds;
+		FAudioBufferWriteRef AudioOutput;
+		FBoolWriteRef OutMuted;
+		int32 NumFramesPerBlock = 0;
+		const float* InputData[NumZones] = {};
+		float FadeInStartData[NumZones] = {};
+		float FadeInEndData[NumZones] = {};
+		float FadeOutStartData[NumZones] = {};
+		float FadeOutEndData[NumZones] = {};
+		MSUtilsDSP::TMultiZoneFader<NumZones> Fader;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+		MSUtilsDSP::FTelemetryPublisher Telemetry;
+	};
+
+	template<int32 NumZones>
+	class TCBPMultiZoneNode : public FNodeFacade
+	{
+	public:
+		//MetaSound frontend constructor
+		TCBPMultiZoneNode(const FNodeInitData& InitData) : FNodeFacade(InitData.InstanceName, InitData.InstanceID,
+			TFacadeOperatorClass<TCBPMultiZoneOperator<NumZones>>())
+		{
+		}
+	};
+
 	// Register node
 	METASOUND_REGISTER_NODE(FCBPNode);
+	METASOUND_REGISTER_NODE(FCBPStereoNode);
+	METASOUND_REGISTER_NODE(FCBPFivePointOneNode);
+	METASOUND_REGISTER_NODE(FCBPSevenPointOneNode);
+
+	REGISTER_CBP_MULTI_ZONE_NODE(2);
+	REGISTER_CBP_MULTI_ZONE_NODE(4);
+	REGISTER_CBP_MULTI_ZONE_NODE(6);
+	REGISTER_CBP_MULTI_ZONE_NODE(8);
+	REGISTER_CBP_MULTI_ZONE_NODE(12);
 }
 
 #undef LOCTEXT_NAMESPACE
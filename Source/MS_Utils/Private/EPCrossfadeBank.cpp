@@ -0,0 +1,288 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#include "CoreMinimal.h"
+
+#include "Internationalization/Text.h"
+#include "MetasoundAudioBuffer.h"
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundFacade.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundStandardNodesCategories.h"
+#include "MetasoundStandardNodesNames.h"
+#include "MetasoundVertex.h"
+#include "MSUtilsDSP/CrossfadeBank.h"
+#include "MSUtilsEnums.h"
+#include "MSUtilsProfiling.h"
+#include "MSUtilsVertexNames.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_EPCrossfade_Bank"
+
+#define REGISTER_EPCROSSFADE_BANK_NODE(Number) \
+	using FEPXFBankNode##Number = TEPXFBankNode<Number>; \
+	METASOUND_REGISTER_NODE(FEPXFBankNode##Number) \
+
+
+namespace Metasound
+{
+	// Shared by every bank size
+	MSUTILS_DECLARE_NODE_STATS(EPCrossfadeBank, "EP Crossfade Bank");
+
+	namespace EPXFBankVertexNames
+	{
+		METASOUND_PARAM(InputGainAccuracy, "Gain Accuracy", "Exact evaluates the cosine gains directly. Fast uses a polynomial approximation that is cheaper when the crossfade values move constantly.");
+		METASOUND_PARAM(InputCurve, "Curve", "Shape of the crossfade, shared by every voice.");
+
+		const FVertexName GetValueName(uint32 Voice)
+		{
+			return *FString::Format(TEXT("Crossfade Value {0}"), { Voice });
+		}
+
+		// Inputs and their activity outputs are numbered by the crossfade value at which they play alone, as on the EP Crossfade node
+		const FVertexName GetInputName(uint32 Voice, uint32 InputIndex)
+		{
+			return *FString::Format(TEXT("Audio In {0} {1}"), { InputIndex, Voice });
+		}
+
+		const FVertexName GetActiveName(uint32 Voice, uint32 InputIndex)
+		{
+			return *FString::Format(TEXT("Is Active {0} {1}"), { InputIndex, Voice });
+		}
+
+		const FVertexName GetOutputName(uint32 Voice)
+		{
+			return *FString::Format(TEXT("Audio Out {0}"), { Voice });
+		}
+
+		// Every pin name of one voice count, formatted once when the variant is first used, so creating and binding
+		// operators only looks them up. Inputs and activity outputs are indexed 2 * Voice + InputIndex.
+		template<int32 NumVoices>
+		struct TPinNames
+		{
+			static const TPinNames& Get()
+			{
+				static const TPinNames Names;
+				return Names;
+			}
+
+			MSUtilsVertexNames::TVertexNameArray<NumVoices> Values{ [](int32 Voice) { return GetValueName(Voice); } };
+			MSUtilsVertexNames::TVertexNameArray<2 * NumVoices> Inputs{ [](int32 Index) { return GetInputName(Index / 2, Index % 2); } };
+			MSUtilsVertexNames::TVertexNameArray<NumVoices> Outputs{ [](int32 Voice) { return GetOutputName(Voice); } };
+			MSUtilsVertexNames::TVertexNameArray<2 * NumVoices> Actives{ [](int32 Index) { return GetActiveName(Index / 2, Index % 2); } };
+		};
+	}
+
+	// K independent lightweight crossfades in one operator, for systems that would otherwise run many FEPXFOperators side by side
+	template<int32 NumVoices>
+	class TEPXFBankOperator : public TExecutableOperator<TEPXFBankOperator<NumVoices>>
+	{
+	public:
+		// Fixed capacity, so building the operator never allocates for its input references
+		using FValueArray = TArray<FFloatReadRef, TFixedAllocator<NumVoices>>;
+		using FInputArray = TArray<FAudioBufferReadRef, TFixedAllocator<2 * NumVoices>>;
+
+		static const FVertexInterface& DeclareVertexInterface()
+		{
+			using namespace EPXFBankVertexNames;
+
+			auto CreateVertexInterface = []() -> FVertexInterface
+				{
+					FInputVertexInterface InputInterface;
+					InputInterface.Add(TInputDataVertex<FEnumGainAccuracy>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGainAccuracy), (int32)MSUtilsDSP::EGainAccuracy::Exact));
+					InputInterface.Add(TInputDataVertex<FEnumCrossfadeCurve>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputCurve), (int32)MSUtilsDSP::ECrossfadeCurve::EqualPower));
+
+					FOutputVertexInterface OutputInterface;
+					for (uint32 Voice = 0; Voice < NumVoices; ++Voice)
+					{
+						InputInterface.Add(TInputDataVertex<float>(GetValueName(Voice), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("EPXFBankValueDesc", "Crossfade value of voice {0}", Voice) }));
+						InputInterface.Add(TInputDataVertex<FAudioBuffer>(GetInputName(Voice, 0), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("EPXFBankInput1Desc", "First input of voice {0}", Voice) }));
+						InputInterface.Add(TInputDataVertex<FAudioBuffer>(GetInputName(Voice, 1), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("EPXFBankInput2Desc", "Second input of voice {0}", Voice) }));
+						OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(GetOutputName(Voice), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("EPXFBankOutputDesc", "Output of voice {0}", Voice) }));
+						OutputInterface.Add(TOutputDataVertex<bool>(GetActiveName(Voice, 0), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("EPXFBankActive1Desc", "True while the first input of voice {0} is audible or fading out", Voice) }));
+						OutputInterface.Add(TOutputDataVertex<bool>(GetActiveName(Voice, 1), FDataVertexMetadata{ METASOUND_LOCTEXT_FORMAT("EPXFBankActive2Desc", "True while the second input of voice {0} is audible or fading out", Voice) }));
+					}
+
+					return FVertexInterface(InputInterface, OutputInterface);
+				};
+
+			static const FVertexInterface Interface = CreateVertexInterface();
+			return Interface;
+		}
+
+		static const FNodeClassMetadata& GetNodeInfo()
+		{
+			auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+				{
+					FNodeClassMetadata Metadata
+					{
+						{ TEXT("UE"), TEXT("EPLightBank"), *FString::Printf(TEXT("Audio %d"), NumVoices) },
+						1, // Major Version
+						1, // Minor Version
+						METASOUND_LOCTEXT_FORMAT("EPXFBankDisplayName", "EP Crossfade Bank ({0} Voices)", NumVoices),
+						METASOUND_LOCTEXT("EPXFBankDescription", "Runs several independent two input equal power crossfades in one node."),
+						PluginAuthor,
+						PluginNodeMissingPrompt,
+						DeclareVertexInterface(),
+						{ NodeCategories::Envelopes },
+						{ },
+						FNodeDisplayStyle{}
+					};
+
+					return Metadata;
+				};
+
+			static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+			return Metadata;
+		}
+
+		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+		{
+			using namespace EPXFBankVertexNames;
+
+			const FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+			const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
+
+			FEnumGainAccuracyReadRef GainAccuracy = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumGainAccuracy>(InputInterface, METASOUND_GET_PARAM_NAME(InputGainAccuracy), InParams.OperatorSettings);
+			FEnumCrossfadeCurveReadRef Curve = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumCrossfadeCurve>(InputInterface, METASOUND_GET_PARAM_NAME(InputCurve), InParams.OperatorSettings);
+
+			const TPinNames<NumVoices>& Names = TPinNames<NumVoices>::Get();
+			FValueArray CrossfadeValues;
+			FInputArray InputValues;
+			for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				CrossfadeValues.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, Names.Values[Voice], InParams.OperatorSettings));
+				InputValues.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, Names.Inputs[2 * Voice], InParams.OperatorSettings));
+				InputValues.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, Names.Inputs[2 * Voice + 1], InParams.OperatorSettings));
+			}
+
+			return MakeUnique<TEPXFBankOperator<NumVoices>>(InParams.OperatorSettings, GainAccuracy, Curve, MoveTemp(CrossfadeValues), MoveTemp(InputValues));
+		}
+
+		TEPXFBankOperator(const FOperatorSettings& InSettings, const FEnumGainAccuracyReadRef& InGainAccuracy, const FEnumCrossfadeCurveReadRef& InCurve, FValueArray&& InCrossfadeValues, FInputArray&& InInputValues)
+			: GainAccuracy(InGainAccuracy)
+			, Curve(InCurve)
+			, CrossfadeValues(MoveTemp(InCrossfadeValues))
+			, InputValues(MoveTemp(InInputValues))
+			, NumFramesPerBlock(InSettings.GetNumFramesPerBlock())
+			, Crossfader(NumVoices)
+			, InstanceCounter(MSUtilsNodeStatsEPCrossfadeBank)
+		{
+			for (uint32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				OutputValues.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+				OutputData[Voice] = OutputValues[Voice]->GetData();
+				ActiveOutputs.Add(FBoolWriteRef::CreateNew(false));
+				ActiveOutputs.Add(FBoolWriteRef::CreateNew(false));
+			}
+			GatherInputData();
+		}
+
+		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace EPXFBankVertexNames;
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputGainAccuracy), GainAccuracy);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputCurve), Curve);
+
+			const TPinNames<NumVoices>& Names = TPinNames<NumVoices>::Get();
+			for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				InOutVertexData.BindReadVertex(Names.Values[Voice], CrossfadeValues[Voice]);
+				InOutVertexData.BindReadVertex(Names.Inputs[2 * Voice], InputValues[2 * Voice]);
+				InOutVertexData.BindReadVertex(Names.Inputs[2 * Voice + 1], InputValues[2 * Voice + 1]);
+			}
+
+			GatherInputData();
+		}
+
+		virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace EPXFBankVertexNames;
+			const TPinNames<NumVoices>& Names = TPinNames<NumVoices>::Get();
+			for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				InOutVertexData.BindReadVertex(Names.Outputs[Voice], OutputValues[Voice]);
+				InOutVertexData.BindReadVertex(Names.Actives[2 * Voice], ActiveOutputs[2 * Voice]);
+				InOutVertexData.BindReadVertex(Names.Actives[2 * Voice + 1], ActiveOutputs[2 * Voice + 1]);
+			}
+		}
+
+		// Puts the operator back as it was constructed, so a cached graph can be reused for a new sound. Allocation free.
+		void Reset(const IOperator::FResetParams& InParams)
+		{
+			Crossfader.Reset();
+			for (FAudioBufferWriteRef& OutputValue : OutputValues)
+			{
+				OutputValue->Zero();
+			}
+			for (FBoolWriteRef& ActiveOutput : ActiveOutputs)
+			{
+				*ActiveOutput = false;
+			}
+		}
+
+		void Execute()
+		{
+			MSUTILS_NODE_EXECUTE_SCOPE(EPCrossfadeBank);
+			// The control values are read into one contiguous array so the bank can update every voice's gains in a single pass
+			for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				ValueData[Voice] = *CrossfadeValues[Voice];
+			}
+			Crossfader.SetCurve(*Curve);
+			Crossfader.Process(ValueData, *GainAccuracy, InputDataA, InputDataB, OutputData, NumFramesPerBlock);
+			for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				*ActiveOutputs[2 * Voice] = Crossfader.IsInputActive(Voice, 0);
+				*ActiveOutputs[2 * Voice + 1] = Crossfader.IsInputActive(Voice, 1);
+			}
+			MSUTILS_NODE_FAST_PATH(Crossfader.IsSettled());
+		}
+
+	private:
+		void GatherInputData()
+		{
+			for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				InputDataA[Voice] = InputValues[2 * Voice]->GetData();
+				InputDataB[Voice] = InputValues[2 * Voice + 1]->GetData();
+			}
+		}
+
+		FEnumGainAccuracyReadRef GainAccuracy;
+		FEnumCrossfadeCurveReadRef Curve;
+		FValueArray CrossfadeValues;
+		FInputArray InputValues;
+		TArray<FAudioBufferWriteRef, TFixedAllocator<NumVoices>> OutputValues;
+		TArray<FBoolWriteRef, TFixedAllocator<2 * NumVoices>> ActiveOutputs;
+
+		int32 NumFramesPerBlock = 0;
+		float ValueData[NumVoices] = {};
+		const float* InputDataA[NumVoices] = {};
+		const float* InputDataB[NumVoices] = {};
+		float* OutputData[NumVoices] = {};
+		MSUtilsDSP::FEqualPowerCrossfadeBank Crossfader;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+	};
+
+	template<int32 NumVoices>
+	class TEPXFBankNode : public FNodeFacade
+	{
+	public:
+		/**
+		 * Constructor used by the Metasound Frontend.
+		 */
+		TEPXFBankNode(const FNodeInitData& InInitData)
+			: FNodeFacade(InInitData.InstanceName, InInitData.InstanceID, TFacadeOperatorClass<TEPXFBankOperator<NumVoices>>())
+		{}
+
+		virtual ~TEPXFBankNode() = default;
+	};
+
+	REGISTER_EPCROSSFADE_BANK_NODE(4);
+	REGISTER_EPCROSSFADE_BANK_NODE(8);
+	REGISTER_EPCROSSFADE_BANK_NODE(16);
+	REGISTER_EPCROSSFADE_BANK_NODE(32);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -2,8 +2,9 @@
 
 #include "EPLightWeight.h"
 
-#include "DSP/FloatArrayMath.h"
 #include "MetasoundStandardNodesCategories.h"
+#include "MSUtilsChannelLayout.h"
+#include "MSUtilsProfiling.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_EPCrossfade_Lightweight"
 
@@ -14,51 +15,69 @@ namespace Metasound
 	namespace EPXFNodeNames
 	{
 		METASOUND_PARAM(InFloatValue, "Crossfade Value", "Crossfade Value");
+		METASOUND_PARAM(InGainAccuracy, "Gain Accuracy", "Exact evaluates the cosine gains directly. Fast uses a polynomial approximation that is cheaper when the crossfade value moves constantly.");
+		METASOUND_PARAM(InCurve, "Curve", "Shape of the crossfade");
 		METASOUND_PARAM(InAudioParam, "Audio In 1", "Input Audio Channel 1");
 		METASOUND_PARAM(InAudioParam2, "Audio In 2", "Input Audio Channel 2");
 		METASOUND_PARAM(OutAudioParam, "Audio Out", "Audio Output");
+		// Numbered like the EP Crossfade node's Is Active outputs, by the crossfade value at which the input plays alone
+		METASOUND_PARAM(OutActiveParam, "Is Active 0", "True while Audio In 1 is audible or fading out");
+		METASOUND_PARAM(OutActiveParam2, "Is Active 1", "True while Audio In 2 is audible or fading out");
+	}
+
+	// Shared by every channel count
+	MSUTILS_DECLARE_NODE_STATS(EPCrossfadeLightweight, "EP Crossfade Lightweight");
+
+	namespace
+	{
+		void PublishTelemetry(MSUtilsDSP::FTelemetryPublisher& Telemetry, float CrossfadeValue, const MSUtilsDSP::FEqualPowerCrossfadePair& Crossfader)
+		{
+			if (Telemetry.IsActive())
+			{
+				const MSUtilsDSP::FEqualPowerGains& Gains = Crossfader.GetGains();
+				Telemetry.PublishCrossfade(CrossfadeValue, MSUtilsDSP::GetCrossfadePosition(CrossfadeValue, 2), Gains.A, Gains.B);
+			}
+		}
 	}
 
 	FEPXFOperator::FEPXFOperator(const FOperatorSettings& InSettings,
 		const FAudioBufferReadRef& InAudio,
 		const FAudioBufferReadRef& InAudio2,
-		const FFloatReadRef& ValueIn)
+		const FFloatReadRef& ValueIn,
+		const FEnumGainAccuracyReadRef& GainAccuracyIn,
+		const FEnumCrossfadeCurveReadRef& CurveIn)
 		: AudioInput(InAudio),
 		AudioInput2(InAudio2),
 		FloatIn(ValueIn),
+		GainAccuracy(GainAccuracyIn),
+		Curve(CurveIn),
 		AudioOutput(FAudioBufferWriteRef::CreateNew(InSettings)),
-		NumFramesPerBlock(InSettings.GetNumFramesPerBlock())
+		OutActive(FBoolWriteRef::CreateNew(false)),
+		OutActive2(FBoolWriteRef::CreateNew(false)),
+		NumFramesPerBlock(InSettings.GetNumFramesPerBlock()),
+		InstanceCounter(MSUtilsNodeStatsEPCrossfadeLightweight),
+		Telemetry(MSUtilsNodeStatsEPCrossfadeLightweight.GetName())
 	{
 
 	};
 
-	void FEPXFOperator::Execute()
+	void FEPXFOperator::Reset(const IOperator::FResetParams& InParams)
 	{
-		if (*FloatIn != FloatInPrev)
-		{
-			SignalOneFloat = FMath::Clamp(FMath::Cos(*FloatIn * HALF_PI), 0.f, 1.f);
-			SignalTwoFloat = FMath::Clamp(FMath::Cos((1 - *FloatIn) * (HALF_PI)), 0.f, 1.f);
-		}
-	
-			FAudioBuffer& OutputBuffer = *AudioOutput;
-			OutputBuffer.Zero();
-			TArrayView<float> OutAudioBufferView(OutputBuffer.GetData(), OutputBuffer.Num());
-
-			MixInInput(AudioInput, OutAudioBufferView, SignalOnePreviousGain, SignalOneFloat);
-			MixInInput(AudioInput2, OutAudioBufferView, SignalTwoPreviousGain, SignalTwoFloat);
-		
-		if (*FloatIn != FloatInPrev)
-		{
-			FloatInPrev = *FloatIn;
-			SignalOnePreviousGain = SignalOneFloat;
-			SignalTwoPreviousGain = SignalTwoFloat;
-		}
+		Crossfader.Reset();
+		AudioOutput->Zero();
+		*OutActive = false;
+		*OutActive2 = false;
 	}
 
-	void FEPXFOperator::MixInInput(FAudioBufferReadRef& InBuffer, TArrayView<float>& OutBufferView, float PrevGain, float NewGain)
+	void FEPXFOperator::Execute()
 	{
-		TArrayView<const float> BufferView((*InBuffer).GetData(), NumFramesPerBlock);
-		Audio::ArrayMixIn(BufferView, OutBufferView, PrevGain, NewGain);
+		MSUTILS_NODE_EXECUTE_SCOPE(EPCrossfadeLightweight);
+		Crossfader.SetCurve(*Curve);
+		Crossfader.Process(*FloatIn, *GainAccuracy, AudioInput->GetData(), AudioInput2->GetData(), AudioOutput->GetData(), NumFramesPerBlock);
+		*OutActive = Crossfader.IsInputActive(0);
+		*OutActive2 = Crossfader.IsInputActive(1);
+		MSUTILS_NODE_FAST_PATH(*OutActive != *OutActive2);
+		PublishTelemetry(Telemetry, *FloatIn, Crossfader);
 	}
 
 	const FVertexInterface& FEPXFOperator::DeclareVertexInterface()
@@ -68,11 +87,15 @@ namespace Metasound
 		static const FVertexInterface Interface(
 			FInputVertexInterface(
 				TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFloatValue)),
+				TInputDataVertexModel<FEnumGainAccuracy>(METASOUND_GET_PARAM_NAME_AND_METADATA(InGainAccuracy), (int32)MSUtilsDSP::EGainAccuracy::Exact),
+				TInputDataVertexModel<FEnumCrossfadeCurve>(METASOUND_GET_PARAM_NAME_AND_METADATA(InCurve), (int32)MSUtilsDSP::ECrossfadeCurve::EqualPower),
 				TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InAudioParam)),
 				TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InAudioParam2))
 			),
 			FOutputVertexInterface(
-				TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutAudioParam))
+				TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutAudioParam)),
+				TOutputDataVertexModel<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutActiveParam)),
+				TOutputDataVertexModel<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutActiveParam2))
 			)
 		);
 
@@ -89,7 +112,7 @@ namespace Metasound
 				{
 						{ TEXT("UE"), TEXT("EPLight"), TEXT("Audio") },
 						1, // Major Version
-						0, // Minor Version
+						3, // Minor Version
 						METASOUND_LOCTEXT("EPTestDisplayName", "EP Crossfade Lightweight"),
 						METASOUND_LOCTEXT("EPTestNodeDesc", "Crossfades between two audio channels by the cos equal power function"),
 						PluginAuthor,
@@ -111,6 +134,8 @@ namespace Metasound
 	{
 		using namespace EPXFNodeNames;
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFloatValue), FloatIn);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InGainAccuracy), GainAccuracy);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InCurve), Curve);
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InAudioParam), AudioInput);
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InAudioParam2), AudioInput2);
 	}
@@ -119,6 +144,8 @@ namespace Metasound
 	{
 		using namespace EPXFNodeNames;
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutAudioParam), AudioOutput);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutActiveParam), OutActive);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutActiveParam2), OutActive2);
 	}
 
 	TUniquePtr<IOperator> FEPXFOperator::CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
@@ -129,15 +156,253 @@ namespace Metasound
 		const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
 
 		TDataReadReference<float> FloatInputA = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InFloatValue), InParams.OperatorSettings);
+		FEnumGainAccuracyReadRef GainAccuracyIn = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumGainAccuracy>(InputInterface, METASOUND_GET_PARAM_NAME(InGainAccuracy), InParams.OperatorSettings);
+		FEnumCrossfadeCurveReadRef CurveIn = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumCrossfadeCurve>(InputInterface, METASOUND_GET_PARAM_NAME(InCurve), InParams.OperatorSettings);
 		FAudioBufferReadRef AudioIn1 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InAudioParam), InParams.OperatorSettings);
 		FAudioBufferReadRef AudioIn2 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InAudioParam2), InParams.OperatorSettings);
 
 		//this class is FEPXFOperator, which inherits from TExecutableOperator, which inherits from IOperator. IOperator type is returned
-		return MakeUnique<FEPXFOperator>(InParams.OperatorSettings, AudioIn1, AudioIn2, FloatInputA);
+		return MakeUnique<FEPXFOperator>(InParams.OperatorSettings, AudioIn1, AudioIn2, FloatInputA, GainAccuracyIn, CurveIn);
 	}
 
+	//------------------------------------------------------------------------------------
+	// TEPXFMultichannelOperator
+	//------------------------------------------------------------------------------------
+
+	// Lightweight crossfade of two planar multichannel signals. Gains are computed once per block and applied to every channel.
+	template<int32 NumChannels>
+	class TEPXFMultichannelOperator : public TExecutableOperator<TEPXFMultichannelOperator<NumChannels>>
+	{
+	public:
+		// Fixed capacity, so building the operator never allocates for its input references
+		using FAudioInputArray = TArray<FAudioBufferReadRef, TFixedAllocator<NumChannels>>;
+
+		TEPXFMultichannelOperator(const FOperatorSettings& InSettings,
+			FAudioInputArray&& InAudio,
+			FAudioInputArray&& InAudio2,
+			const FFloatReadRef& ValueIn,
+			const FEnumGainAccuracyReadRef& GainAccuracyIn,
+			const FEnumCrossfadeCurveReadRef& CurveIn)
+			: FloatIn(ValueIn),
+			GainAccuracy(GainAccuracyIn),
+			Curve(CurveIn),
+			AudioInputs(MoveTemp(InAudio)),
+			AudioInputs2(MoveTemp(InAudio2)),
+			OutActive(FBoolWriteRef::CreateNew(false)),
+			OutActive2(FBoolWriteRef::CreateNew(false)),
+			NumFramesPerBlock(InSettings.GetNumFramesPerBlock()),
+			InstanceCounter(MSUtilsNodeStatsEPCrossfadeLightweight),
+			Telemetry(MSUtilsNodeStatsEPCrossfadeLightweight.GetName())
+		{
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				AudioOutputs.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+				OutputData[Channel] = AudioOutputs[Channel]->GetData();
+			}
+			GatherInputData();
+		}
+
+		static const FVertexInterface& DeclareVertexInterface()
+		{
+			using namespace EPXFNodeNames;
+
+			auto CreateVertexInterface = []() -> FVertexInterface
+				{
+					FInputVertexInterface InputInterface;
+					InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFloatValue)));
+					InputInterface.Add(TInputDataVertex<FEnumGainAccuracy>(METASOUND_GET_PARAM_NAME_AND_METADATA(InGainAccuracy), (int32)MSUtilsDSP::EGainAccuracy::Exact));
+					InputInterface.Add(TInputDataVertex<FEnumCrossfadeCurve>(METASOUND_GET_PARAM_NAME_AND_METADATA(InCurve), (int32)MSUtilsDSP::ECrossfadeCurve::EqualPower));
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+					{
+						InputInterface.Add(TInputDataVertex<FAudioBuffer>(MSUtilsChannelLayout::GetChannelVertexName(METASOUND_GET_PARAM_NAME(InAudioParam), NumChannels, Channel), MSUtilsChannelLayout::GetChannelVertexMetadata(METASOUND_GET_PARAM_TT(InAudioParam), NumChannels, Channel)));
+					}
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+					{
+						InputInterface.Add(TInputDataVertex<FAudioBuffer>(MSUtilsChannelLayout::GetChannelVertexName(METASOUND_GET_PARAM_NAME(InAudioParam2), NumChannels, Channel), MSUtilsChannelLayout::GetChannelVertexMetadata(METASOUND_GET_PARAM_TT(InAudioParam2), NumChannels, Channel)));
+					}
+
+					FOutputVertexInterface OutputInterface;
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+					{
+						OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(MSUtilsChannelLayout::GetChannelVertexName(METASOUND_GET_PARAM_NAME(OutAudioParam), NumChannels, Channel), MSUtilsChannelLayout::GetChannelVertexMetadata(METASOUND_GET_PARAM_TT(OutAudioParam), NumChannels, Channel)));
+					}
+					OutputInterface.Add(TOutputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutActiveParam)));
+					OutputInterface.Add(TOutputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutActiveParam2)));
+
+					return FVertexInterface(InputInterface, OutputInterface);
+				};
+
+			static const FVertexInterface Interface = CreateVertexInterface();
+			return Interface;
+		}
+
+		static const FNodeClassMetadata& GetNodeInfo()
+		{
+			auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+				{
+					FVertexInterface NodeInterface = DeclareVertexInterface();
+
+					FNodeClassMetadata Metadata
+					{
+							{ TEXT("UE"), TEXT("EPLight"), *FString::Printf(TEXT("Audio %s"), MSUtilsChannelLayout::GetLayoutName(NumChannels)) },
+							1, // Major Version
+							1, // Minor Version
+							FText::Format(METASOUND_LOCTEXT("EPMultichannelDisplayName", "EP Crossfade Lightweight ({0})"), MSUtilsChannelLayout::GetLayoutDisplayName(NumChannels)),
+							METASOUND_LOCTEXT("EPMultichannelNodeDesc", "Crossfades between two multichannel signals by the cos equal power function"),
+							PluginAuthor,
+							PluginNodeMissingPrompt,
+							NodeInterface,
+							{ NodeCategories::Envelopes },
+							{ },
+							FNodeDisplayStyle{}
+					};
+
+					return Metadata;
+				};
+
+			static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+			return Metadata;
+		}
+
+		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace EPXFNodeNames;
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFloatValue), FloatIn);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InGainAccuracy), GainAccuracy);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InCurve), Curve);
+			const FPinNames& Names = GetPinNames();
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InOutVertexData.BindReadVertex(Names.AudioInputs[Channel], AudioInputs[Channel]);
+				InOutVertexData.BindReadVertex(Names.AudioInputs2[Channel], AudioInputs2[Channel]);
+			}
+			GatherInputData();
+		}
+
+		virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace EPXFNodeNames;
+			const FPinNames& Names = GetPinNames();
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InOutVertexData.BindReadVertex(Names.AudioOutputs[Channel], AudioOutputs[Channel]);
+			}
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutActiveParam), OutActive);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutActiveParam2), OutActive2);
+		}
+
+		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+		{
+			using namespace EPXFNodeNames;
+
+			const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
+			const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+
+			TDataReadReference<float> FloatInputA = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InFloatValue), InParams.OperatorSettings);
+			FEnumGainAccuracyReadRef GainAccuracyIn = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumGainAccuracy>(InputInterface, METASOUND_GET_PARAM_NAME(InGainAccuracy), InParams.OperatorSettings);
+			FEnumCrossfadeCurveReadRef CurveIn = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumCrossfadeCurve>(InputInterface, METASOUND_GET_PARAM_NAME(InCurve), InParams.OperatorSettings);
+
+			const FPinNames& Names = GetPinNames();
+			FAudioInputArray AudioIn1;
+			FAudioInputArray AudioIn2;
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				AudioIn1.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, Names.AudioInputs[Channel], InParams.OperatorSettings));
+				AudioIn2.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, Names.AudioInputs2[Channel], InParams.OperatorSettings));
+			}
+
+			return MakeUnique<TEPXFMultichannelOperator<NumChannels>>(InParams.OperatorSettings, MoveTemp(AudioIn1), MoveTemp(AudioIn2), FloatInputA, GainAccuracyIn, CurveIn);
+		}
+
+		void Reset(const IOperator::FResetParams& InParams)
+		{
+			Crossfader.Reset();
+			for (FAudioBufferWriteRef& AudioOutput : AudioOutputs)
+			{
+				AudioOutput->Zero();
+			}
+			*OutActive = false;
+			*OutActive2 = false;
+		}
+
+		void Execute()
+		{
+			MSUTILS_NODE_EXECUTE_SCOPE(EPCrossfadeLightweight);
+			Crossfader.SetCurve(*Curve);
+			Crossfader.Process(*FloatIn, *GainAccuracy, InputData, InputData2, OutputData, NumChannels, NumFramesPerBlock);
+			*OutActive = Crossfader.IsInputActive(0);
+			*OutActive2 = Crossfader.IsInputActive(1);
+			MSUTILS_NODE_FAST_PATH(*OutActive != *OutActive2);
+			PublishTelemetry(Telemetry, *FloatIn, Crossfader);
+		}
+
+	private:
+		// Channel pin names, formatted once per layout
+		struct FPinNames
+		{
+			MSUtilsChannelLayout::TChannelVertexNames<NumChannels> AudioInputs;
+			MSUtilsChannelLayout::TChannelVertexNames<NumChannels> AudioInputs2;
+			MSUtilsChannelLayout::TChannelVertexNames<NumChannels> AudioOutputs;
+		};
+
+		static const FPinNames& GetPinNames()
+		{
+			using namespace EPXFNodeNames;
+			static const FPinNames Names
+			{
+				MSUtilsChannelLayout::TChannelVertexNames<NumChannels>(METASOUND_GET_PARAM_NAME(InAudioParam)),
+				MSUtilsChannelLayout::TChannelVertexNames<NumChannels>(METASOUND_GET_PARAM_NAME(InAudioParam2)),
+				MSUtilsChannelLayout::TChannelVertexNames<NumChannels>(METASOUND_GET_PARAM_NAME(OutAudioParam))
+			};
+			return Names;
+		}
+
+		void GatherInputData()
+		{
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InputData[Channel] = AudioInputs[Channel]->GetData();
+				InputData2[Channel] = AudioInputs2[Channel]->GetData();
+			}
+		}
+
+		FFloatReadRef FloatIn;
+		FEnumGainAccuracyReadRef GainAccuracy;
+		FEnumCrossfadeCurveReadRef Curve;
+		FAudioInputArray AudioInputs;
+		FAudioInputArray AudioInputs2;
+		TArray<FAudioBufferWriteRef, TFixedAllocator<NumChannels>> AudioOutputs;
+		FBoolWriteRef OutActive;
+		FBoolWriteRef OutActive2;
+		int32 NumFramesPerBlock = 0;
+		const float* InputData[NumChannels] = {};
+		const float* InputData2[NumChannels] = {};
+		float* OutputData[NumChannels] = {};
+		MSUtilsDSP::FEqualPowerCrossfadePair Crossfader;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+		MSUtilsDSP::FTelemetryPublisher Telemetry;
+	};
+
+	template<int32 NumChannels>
+	class TEPXFMultichannelNode : public FNodeFacade
+	{
+	public:
+		//MetaSound frontend constructor
+		TEPXFMultichannelNode(const FNodeInitData& InitData) : FNodeFacade(InitData.InstanceName, InitData.InstanceID,
+			TFacadeOperatorClass<TEPXFMultichannelOperator<NumChannels>>())
+		{
+		}
+	};
+
+	using FEPXFStereoNode = TEPXFMultichannelNode<2>;
+	using FEPXFFivePointOneNode = TEPXFMultichannelNode<6>;
+	using FEPXFSevenPointOneNode = TEPXFMultichannelNode<8>;
+
 	// Register node
 	METASOUND_REGISTER_NODE(FEPXFNode);
+	METASOUND_REGISTER_NODE(FEPXFStereoNode);
+	METASOUND_REGISTER_NODE(FEPXFFivePointOneNode);
+	METASOUND_REGISTER_NODE(FEPXFSevenPointOneNode);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -14,6 +14,13 @@
 #include "MetasoundStandardNodesNames.h"
 #include "MetasoundTrigger.h"
 #include "MetasoundVertex.h"
+#include "MSUtilsChannelLayout.h"
+#include "MSUtilsConstantInputs.h"
+#include "MSUtilsDSP/EqualPowerCrossfader.h"
+#include "MSUtilsDSP/Telemetry.h"
+#include "MSUtilsEnums.h"
+#include "MSUtilsProfiling.h"
+#include "MSUtilsVertexNames.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_EPCrossfade"
 
@@ -21,12 +28,37 @@
 	using FEPCrossfadeNode##Number = TEPCrossfadeNode<Number>; \
 	METASOUND_REGISTER_NODE(FEPCrossfadeNode##Number) \
 
+#define REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(Number) \
+	using FEPCrossfadeAudioRateNode##Number = TEPCrossfadeAudioRateNode<Number>; \
+	METASOUND_REGISTER_NODE(FEPCrossfadeAudioRateNode##Number) \
+
+#define REGISTER_EPCROSSFADE_MULTICHANNEL_NODES(Number) \
+	using FEPCrossfadeNode##Number##Stereo = TEPCrossfadeNode<Number, 2>; \
+	using FEPCrossfadeNode##Number##FivePointOne = TEPCrossfadeNode<Number, 6>; \
+	using FEPCrossfadeNode##Number##SevenPointOne = TEPCrossfadeNode<Number, 8>; \
+	using FEPCrossfadeAudioRateNode##Number##Stereo = TEPCrossfadeAudioRateNode<Number, 2>; \
+	using FEPCrossfadeAudioRateNode##Number##FivePointOne = TEPCrossfadeAudioRateNode<Number, 6>; \
+	using FEPCrossfadeAudioRateNode##Number##SevenPointOne = TEPCrossfadeAudioRateNode<Number, 8>; \
+	METASOUND_REGISTER_NODE(FEPCrossfadeNode##Number##Stereo) \
+	METASOUND_REGISTER_NODE(FEPCrossfadeNode##Number##FivePointOne) \
+	METASOUND_REGISTER_NODE(FEPCrossfadeNode##Number##SevenPointOne) \
+	METASOUND_REGISTER_NODE(FEPCrossfadeAudioRateNode##Number##Stereo) \
+	METASOUND_REGISTER_NODE(FEPCrossfadeAudioRateNode##Number##FivePointOne) \
+	METASOUND_REGISTER_NODE(FEPCrossfadeAudioRateNode##Number##SevenPointOne) \
+
 
 namespace Metasound
 {
+	// Shared by every input and channel count
+	MSUTILS_DECLARE_NODE_STATS(EPCrossfade, "EP Crossfade");
+	MSUTILS_DECLARE_NODE_STATS(EPCrossfadeAudioRate, "EP Crossfade (Audio Rate)");
+
 	namespace EPXFVertexNames
 	{
 		METASOUND_PARAM(InputCrossfadeValue, "Crossfade Value", "Crossfade value to crossfade between inputs.")
+			METASOUND_PARAM(InputCrossfadeAudio, "Crossfade Value", "Audio rate crossfade value to crossfade between inputs, evaluated every sample.")
+			METASOUND_PARAM(InputGainAccuracy, "Gain Accuracy", "Exact evaluates the cosine gains directly. Fast uses a polynomial approximation that is cheaper when the crossfade value moves constantly.")
+			METASOUND_PARAM(InputCurve, "Curve", "Shape of the crossfade between neighbouring inputs.")
 			METASOUND_PARAM(OutputTrigger, "Out", "Output value.")
 
 			const FVertexName GetInputName(uint32 InIndex)
@@ -43,93 +75,243 @@ namespace Metasound
 		{
 			return METASOUND_LOCTEXT_FORMAT("EPXFInputDisplayName", "In {0}", InIndex);
 		}
-	}
 
-	class TEPXFHelper
-	{
-	public:
-		TEPXFHelper(int32 InNumFramesPerBlock, int32 NumInputs)
-			: NumFramesPerBlock(InNumFramesPerBlock), InputAmount(NumInputs)
+		// Multichannel nodes have one pin per input and channel, named e.g. "In 0 L". Mono keeps the plain names.
+		const FVertexName GetInputName(uint32 InIndex, uint32 NumChannels, uint32 Channel)
 		{
-			PrevGains.AddZeroed(NumInputs);
-			CurrentGains.AddZeroed(NumInputs);
-			NeedsMixing.AddZeroed(NumInputs);
+			if (NumChannels == 1)
+			{
+				return GetInputName(InIndex);
+			}
+			return *FString::Format(TEXT("In {0} {1}"), { InIndex, MSUtilsChannelLayout::GetChannelSuffix(NumChannels, Channel) });
 		}
 
-		void GetCrossfadeOutput(int32 IndexA, int32 IndexB, float Alpha, const TArray<FAudioBufferReadRef>& InAudioBuffersValues, FAudioBuffer& OutAudioBuffer)
+		const FVertexName GetOutputName(uint32 NumChannels, uint32 Channel)
 		{
-			float EPXFValueA = FMath::Clamp(FMath::Cos(Alpha * HALF_PI), 0.f, 1.f);
-			float EPXFValueB = FMath::Clamp(FMath::Cos((1 - Alpha) * (HALF_PI)), 0.f, 1.f);
-			//Uncomment below to turn on debug of crossfade values
-			/*GEngine->AddOnScreenDebugMessage(1, 15.0f, FColor::Red, FString::Printf(TEXT("EPXFValueA: %f"), EPXFValueA));
-			GEngine->AddOnScreenDebugMessage(2, 15.0f, FColor::Blue, FString::Printf(TEXT("EPXFValueB: %f"), EPXFValueB));*/
+			if (NumChannels == 1)
+			{
+				return METASOUND_GET_PARAM_NAME(OutputTrigger);
+			}
+			return *FString::Format(TEXT("Out {0}"), { MSUtilsChannelLayout::GetChannelSuffix(NumChannels, Channel) });
+		}
 
-			// Determine the gains
-			for (int32 i = 0; i < InputAmount; ++i)
+		void AddInputAudioVertices(FInputVertexInterface& InputInterface, uint32 NumInputs, uint32 NumChannels)
+		{
+			for (uint32 i = 0; i < NumInputs; ++i)
 			{
-				// Cycling through the inputs, if the we come to IndexA, the resulting volume is set to the inputs number - 1.
-				// so for example, if the alpha is 0.4 and IndexA is 3, set index 3 to 1.0 - alpha which is 0.6.
-				if (i == IndexA)
-				{
-					CurrentGains[i] = EPXFValueA;
-					NeedsMixing[i] = true;
-				}
-				// Cycling through the inputs, if the we come to IndexB, the resulting volume is set to the Alpha.
-				// so for example, if the alpha is 0.4 and IndexB is 4, set index 4 to 0.4.
-				else if (i == IndexB)
+				for (uint32 Channel = 0; Channel < NumChannels; ++Channel)
 				{
-					CurrentGains[i] = EPXFValueB;
-					NeedsMixing[i] = true;
-				}
-				else
-				{
-					CurrentGains[i] = 0.0f;
+					if (NumChannels == 1)
+					{
+						const FDataVertexMetadata InputMetadata
+						{
+							GetInputDescription(i),
+							GetInputDisplayName(i)
+						};
 
-					// If we were already at 0.0f, don't need to do any mixing!
-					if (PrevGains[i] == 0.0f)
+						InputInterface.Add(TInputDataVertex<FAudioBuffer>(GetInputName(i), InputMetadata));
+					}
+					else
 					{
-						NeedsMixing[i] = false;
+						const FText Suffix = FText::FromString(MSUtilsChannelLayout::GetChannelSuffix(NumChannels, Channel));
+						const FDataVertexMetadata InputMetadata
+						{
+							METASOUND_LOCTEXT_FORMAT("EPXFInputChannelDesc", "Crossfade {0} input, {1} channel.", i, Suffix),
+							METASOUND_LOCTEXT_FORMAT("EPXFInputChannelDisplayName", "In {0} {1}", i, Suffix)
+						};
+
+						InputInterface.Add(TInputDataVertex<FAudioBuffer>(GetInputName(i, NumChannels, Channel), InputMetadata));
 					}
 				}
 			}
+		}
 
-			// Zero the output buffer so we can mix into it
-			OutAudioBuffer.Zero();
-			TArrayView<float> OutAudioBufferView(OutAudioBuffer.GetData(), OutAudioBuffer.Num());
+		void AddOutputAudioVertices(FOutputVertexInterface& OutputInterface, uint32 NumChannels)
+		{
+			if (NumChannels == 1)
+			{
+				OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputTrigger)));
+				return;
+			}
 
-			// Now write to the scratch buffers w/ fade buffer fast given the new inputs
-			for (int32 i = 0; i < InputAmount; ++i)
+			for (uint32 Channel = 0; Channel < NumChannels; ++Channel)
 			{
-				// Only need to do anything on an input if either curr or prev is non-zero
-				if (NeedsMixing[i])
+				const FText Suffix = FText::FromString(MSUtilsChannelLayout::GetChannelSuffix(NumChannels, Channel));
+				const FDataVertexMetadata OutputMetadata
 				{
-					// Copy the input to the output
-					const FAudioBufferReadRef& InBuff = InAudioBuffersValues[i];
-					TArrayView<const float> BufferView((*InBuff).GetData(), NumFramesPerBlock);
-					//The below is not used anywhere
-					const float* BufferPtr = (*InBuff).GetData();
-
-					// mix in and fade to the target gain values
-					Audio::ArrayMixIn(BufferView, OutAudioBufferView, PrevGains[i], CurrentGains[i]);
-				}
+					METASOUND_LOCTEXT_FORMAT("EPXFOutputChannelDesc", "Output value, {0} channel.", Suffix),
+					METASOUND_LOCTEXT_FORMAT("EPXFOutputChannelDisplayName", "Out {0}", Suffix)
+				};
+
+				OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(GetOutputName(NumChannels, Channel), OutputMetadata));
 			}
+		}
 
-			// Copy the CurrentGains to PrevGains
-			PrevGains = CurrentGains;
+		// Class name of a node variant, e.g. "Trigger Route (Audio, 4, Stereo)". Mono keeps the original names.
+		FName GetOperatorName(const TCHAR* Prefix, uint32 NumInputs, uint32 NumChannels)
+		{
+			const FString DataTypeName = GetMetasoundDataTypeName<FAudioBuffer>().ToString();
+			if (NumChannels == 1)
+			{
+				return *FString::Printf(TEXT("%s (%s, %d)"), Prefix, *DataTypeName, NumInputs);
+			}
+			return *FString::Printf(TEXT("%s (%s, %d, %s)"), Prefix, *DataTypeName, NumInputs, MSUtilsChannelLayout::GetLayoutName(NumChannels));
+		}
+
+		const FVertexName GetOutputActiveName(uint32 InIndex)
+		{
+			return *FString::Format(TEXT("Is Active {0}"), { InIndex });
+		}
+
+		const FText GetOutputActiveDescription(uint32 InIndex)
+		{
+			return METASOUND_LOCTEXT_FORMAT("EPXFActiveDesc", "True while input {0} is audible or fading out. Use it to stop the sources feeding a silent input.", InIndex);
+		}
+
+		const FText GetOutputActiveDisplayName(uint32 InIndex)
+		{
+			return METASOUND_LOCTEXT_FORMAT("EPXFActiveDisplayName", "Is Active {0}", InIndex);
+		}
+
+		void AddOutputActiveVertices(FOutputVertexInterface& OutputInterface, uint32 NumInputs)
+		{
+			for (uint32 i = 0; i < NumInputs; ++i)
+			{
+				const FDataVertexMetadata OutputMetadata
+				{
+					GetOutputActiveDescription(i),
+					GetOutputActiveDisplayName(i)
+				};
+
+				OutputInterface.Add(TOutputDataVertex<bool>(GetOutputActiveName(i), OutputMetadata));
+			}
+		}
+
+		// Every pin name of one input and channel count, formatted once when the variant is first used. Operators are
+		// created and bound for every instance of every graph built, so they only look their names up here. Inputs are
+		// indexed InIndex * NumChannels + Channel.
+		template<int32 NumInputs, int32 NumChannels>
+		struct TPinNames
+		{
+			static const TPinNames& Get()
+			{
+				static const TPinNames Names;
+				return Names;
+			}
+
+			MSUtilsVertexNames::TVertexNameArray<NumInputs * NumChannels> Inputs{ [](int32 Index) { return GetInputName(Index / NumChannels, NumChannels, Index % NumChannels); } };
+			MSUtilsVertexNames::TVertexNameArray<NumChannels> Outputs{ [](int32 Channel) { return GetOutputName(NumChannels, Channel); } };
+			MSUtilsVertexNames::TVertexNameArray<NumInputs> OutputActives{ [](int32 InIndex) { return GetOutputActiveName(InIndex); } };
+		};
+	}
+
+	template<int32 NumInputs, int32 NumChannels>
+	class TEPXFHelper
+	{
+	public:
+		TEPXFHelper(int32 InNumFramesPerBlock)
+			: NumFramesPerBlock(InNumFramesPerBlock)
+			, Telemetry(MSUtilsNodeStatsEPCrossfade.GetName())
+		{
+		}
+
+		// Caches the buffer pointers, one per input and channel with the channels of each input together.
+		// Must be called again whenever the input references are rebound.
+		void SetBuffers(TArrayView<const FAudioBufferReadRef> InAudioBuffersValues, TArrayView<const FAudioBufferWriteRef> OutAudioBuffers)
+		{
+			for (int32 i = 0; i < NumInputs * NumChannels; ++i)
+			{
+				InputData[i] = InAudioBuffersValues[i]->GetData();
+			}
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				OutputData[Channel] = OutAudioBuffers[Channel]->GetData();
+			}
+		}
+
+		void GetCrossfadeOutput(float CrossfadeValue, MSUtilsDSP::EGainAccuracy Accuracy, MSUtilsDSP::ECrossfadeCurve Curve)
+		{
+			// Inputs fading towards silence are flushed rather than mixed as denormals, and dropped once below the threshold
+			const MSUtilsDSP::FScopedFlushDenormals FlushDenormals(MSUtilsDSP::IsDenormalFlushEnabled());
+			Crossfader.SetSilenceThreshold(MSUtilsDSP::GetSilenceThreshold());
+			Crossfader.SetCurve(Curve);
+			// Determine the gains once and mix every input with non-zero current or previous gain into each channel, fading to the target gain values
+			Crossfader.Process(CrossfadeValue, Accuracy, InputData, OutputData, NumChannels, NumFramesPerBlock);
+		}
+
+		// Shown on screen by the game thread while au.MSUtils.Telemetry is on. Only called from Execute, so the
+		// audio thread stays the telemetry ring's one producer even though the constructor mixes a block too.
+		void PublishTelemetry(float CrossfadeValue)
+		{
+			if (Telemetry.IsActive())
+			{
+				const MSUtilsDSP::FCrossfadePosition& Position = Crossfader.GetPosition();
+				Telemetry.PublishCrossfade(CrossfadeValue, Position, Crossfader.GetCurrentGain(Position.IndexA), Crossfader.GetCurrentGain(Position.IndexB));
+			}
+		}
+
+		// Mixes with the gains the last GetCrossfadeOutput settled on, for a crossfade value, accuracy and curve that can never change
+		void MixSettledOutput()
+		{
+			const MSUtilsDSP::FScopedFlushDenormals FlushDenormals(MSUtilsDSP::IsDenormalFlushEnabled());
+			Crossfader.MixSettled(InputData, OutputData, NumChannels, NumFramesPerBlock);
+		}
+
+		// Back to the state the helper was constructed in, with every active output cleared
+		void Reset(TArrayView<FBoolWriteRef> OutputActive)
+		{
+			Crossfader.Reset();
+			for (FBoolWriteRef& Active : OutputActive)
+			{
+				*Active = false;
+			}
+			NumPrevMixedInputs = 0;
+		}
+
+		bool IsTelemetryActive() const
+		{
+			return Telemetry.IsActive();
+		}
+
+		// Inputs mixed by the last block. 1 when the crossfade value sits on a single input.
+		int32 GetNumMixedInputs() const
+		{
+			return Crossfader.GetNumMixedInputs();
+		}
+
+		// Only the inputs mixed last block or this block can have changed activity, so only those outputs are written
+		void UpdateActiveOutputs(TArrayView<FBoolWriteRef> OutputActive)
+		{
+			for (int32 i = 0; i < NumPrevMixedInputs; ++i)
+			{
+				*OutputActive[PrevMixedInputs[i]] = false;
+			}
+
+			NumPrevMixedInputs = Crossfader.GetNumMixedInputs();
+			for (int32 i = 0; i < NumPrevMixedInputs; ++i)
+			{
+				PrevMixedInputs[i] = Crossfader.GetMixedInputs()[i];
+				*OutputActive[PrevMixedInputs[i]] = true;
+			}
 		}
 
 	private:
-		int32 InputAmount;
 		int32 NumFramesPerBlock = 0;
-		TArray<float> PrevGains;
-		TArray<float> CurrentGains;
-		TArray<bool> NeedsMixing;
+		MSUtilsDSP::TEqualPowerCrossfader<NumInputs> Crossfader;
+		const float* InputData[NumInputs * NumChannels] = {};
+		float* OutputData[NumChannels] = {};
+		int32 PrevMixedInputs[MSUtilsDSP::TEqualPowerCrossfader<NumInputs>::MaxMixedInputs] = {};
+		int32 NumPrevMixedInputs = 0;
+		MSUtilsDSP::FTelemetryPublisher Telemetry;
 	};
 
-	template<int32 NumInputs>
-	class TEPXFOperator : public TExecutableOperator<TEPXFOperator<NumInputs>>
+	template<int32 NumInputs, int32 NumChannels>
+	class TEPXFOperator : public TExecutableOperator<TEPXFOperator<NumInputs, NumChannels>>
 	{
 	public:
+		// Fixed capacity, so building the operator never allocates for its input references
+		using FInputArray = TArray<FAudioBufferReadRef, TFixedAllocator<NumInputs * NumChannels>>;
+
 		static const FVertexInterface& GetVertexInterface()
 		{
 			using namespace EPXFVertexNames;
@@ -139,20 +321,14 @@ namespace Metasound
 					FInputVertexInterface InputInterface;
 
 					InputInterface.Add(TInputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputCrossfadeValue)));
+					InputInterface.Add(TInputDataVertex<FEnumGainAccuracy>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGainAccuracy), (int32)MSUtilsDSP::EGainAccuracy::Exact));
+					InputInterface.Add(TInputDataVertex<FEnumCrossfadeCurve>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputCurve), (int32)MSUtilsDSP::ECrossfadeCurve::EqualPower));
 
-					for (uint32 i = 0; i < NumInputs; ++i)
-					{
-						const FDataVertexMetadata InputMetadata
-						{
-							GetInputDescription(i),
-							GetInputDisplayName(i)
-						};
-
-						InputInterface.Add(TInputDataVertex<FAudioBuffer>(GetInputName(i), InputMetadata));
-					}
+					AddInputAudioVertices(InputInterface, NumInputs, NumChannels);
 
 					FOutputVertexInterface OutputInterface;
-					OutputInterface.Add(TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputTrigger)));
+					AddOutputAudioVertices(OutputInterface, NumChannels);
+					AddOutputActiveVertices(OutputInterface, NumInputs);
 
 					return FVertexInterface(InputInterface, OutputInterface);
 				};
@@ -166,8 +342,10 @@ namespace Metasound
 			auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
 				{
 					FName DataTypeName = GetMetasoundDataTypeName<FAudioBuffer>();
-					FName OperatorName = *FString::Printf(TEXT("Trigger Route (%s, %d)"), *DataTypeName.ToString(), NumInputs);
-					FText NodeDisplayName = METASOUND_LOCTEXT_FORMAT("EPXFDisplayNamePattern", "EP Crossfade ({0}, {1})", GetMetasoundDataTypeDisplayText<FAudioBuffer>(), NumInputs);
+					FName OperatorName = EPXFVertexNames::GetOperatorName(TEXT("Trigger Route"), NumInputs, NumChannels);
+					FText NodeDisplayName = NumChannels == 1
+						? METASOUND_LOCTEXT_FORMAT("EPXFDisplayNamePattern", "EP Crossfade ({0}, {1})", GetMetasoundDataTypeDisplayText<FAudioBuffer>(), NumInputs)
+						: METASOUND_LOCTEXT_FORMAT("EPXFMultichannelDisplayNamePattern", "EP Crossfade ({0}, {1}, {2})", GetMetasoundDataTypeDisplayText<FAudioBuffer>(), NumInputs, MSUtilsChannelLayout::GetLayoutDisplayName(NumChannels));
 					const FText NodeDescription = METASOUND_LOCTEXT("EPXFDescription", "Crossfades inputs by equal power to outputs.");
 					FVertexInterface NodeInterface = GetVertexInterface();
 
@@ -175,7 +353,7 @@ namespace Metasound
 					{
 						FNodeClassName { "EPXF", OperatorName, DataTypeName },
 						1, // Major Version
-						0, // Minor Version
+						3, // Minor Version
 						NodeDisplayName,
 						NodeDescription,
 						PluginAuthor,
@@ -200,24 +378,49 @@ namespace Metasound
 			const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
 
 			FFloatReadRef CrossfadeValue = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputCrossfadeValue), InParams.OperatorSettings);
+			FEnumGainAccuracyReadRef GainAccuracy = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumGainAccuracy>(InputInterface, METASOUND_GET_PARAM_NAME(InputGainAccuracy), InParams.OperatorSettings);
+			FEnumCrossfadeCurveReadRef Curve = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumCrossfadeCurve>(InputInterface, METASOUND_GET_PARAM_NAME(InputCurve), InParams.OperatorSettings);
 
-			TArray<TDataReadReference<FAudioBuffer>> InputValues;
-			for (uint32 i = 0; i < NumInputs; ++i)
+			const TPinNames<NumInputs, NumChannels>& Names = TPinNames<NumInputs, NumChannels>::Get();
+			FInputArray InputValues;
+			for (int32 i = 0; i < NumInputs; ++i)
 			{
-				InputValues.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, GetInputName(i), InParams.OperatorSettings));
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					InputValues.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, Names.Inputs[i * NumChannels + Channel], InParams.OperatorSettings));
+				}
 			}
 
-			return MakeUnique<TEPXFOperator<NumInputs>>(InParams.OperatorSettings, CrossfadeValue, MoveTemp(InputValues));
+			// Nothing connected to the value, accuracy or curve means the gains the constructor settles on are final
+			const bool bConstantCrossfade = MSUtilsConstantInputs::IsConstant<float>(InputCollection, METASOUND_GET_PARAM_NAME(InputCrossfadeValue))
+				&& MSUtilsConstantInputs::IsConstant<FEnumGainAccuracy>(InputCollection, METASOUND_GET_PARAM_NAME(InputGainAccuracy))
+				&& MSUtilsConstantInputs::IsConstant<FEnumCrossfadeCurve>(InputCollection, METASOUND_GET_PARAM_NAME(InputCurve));
+
+			return MakeUnique<TEPXFOperator<NumInputs, NumChannels>>(InParams.OperatorSettings, CrossfadeValue, GainAccuracy, Curve, MoveTemp(InputValues), bConstantCrossfade);
 		}
 
 
-		TEPXFOperator(const FOperatorSettings& InSettings, const FFloatReadRef& InCrossfadeValue, TArray<TDataReadReference<FAudioBuffer>>&& InInputValues)
+		TEPXFOperator(const FOperatorSettings& InSettings, const FFloatReadRef& InCrossfadeValue, const FEnumGainAccuracyReadRef& InGainAccuracy, const FEnumCrossfadeCurveReadRef& InCurve, FInputArray&& InInputValues, bool bInConstantCrossfade = false)
 			: CrossfadeValue(InCrossfadeValue)
+			, GainAccuracy(InGainAccuracy)
+			, Curve(InCurve)
 			, InputValues(MoveTemp(InInputValues))
-			, OutputValue(TDataWriteReferenceFactory<FAudioBuffer>::CreateAny(InSettings))
-			, Crossfader(InSettings.GetNumFramesPerBlock(), NumInputs)
-
+			, Crossfader(InSettings.GetNumFramesPerBlock())
+			, bConstantCrossfade(bInConstantCrossfade)
+			, InstanceCounter(MSUtilsNodeStatsEPCrossfade)
 		{
+			for (uint32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				OutputValues.Add(TDataWriteReferenceFactory<FAudioBuffer>::CreateAny(InSettings));
+			}
+
+			for (uint32 i = 0; i < NumInputs; ++i)
+			{
+				OutputActive.Add(FBoolWriteRef::CreateNew(false));
+			}
+
+			GatherInputData();
+
 			PerformCrossfadeOutput();
 		}
 
@@ -227,18 +430,290 @@ namespace Metasound
 		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
 		{
 			using namespace EPXFVertexNames;
-			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputCrossfadeValue), CrossfadeValue);
+			using namespace MSUtilsConstantInputs;
+			bool bUnchanged = BindReadVertexUnchanged(InOutVertexData, METASOUND_GET_PARAM_NAME(InputCrossfadeValue), CrossfadeValue);
+			bUnchanged &= BindReadVertexUnchanged(InOutVertexData, METASOUND_GET_PARAM_NAME(InputGainAccuracy), GainAccuracy);
+			bUnchanged &= BindReadVertexUnchanged(InOutVertexData, METASOUND_GET_PARAM_NAME(InputCurve), Curve);
+			// A crossfade that can change again goes back to being worked out every block
+			bConstantCrossfade = bConstantCrossfade && bUnchanged;
+
+			const TPinNames<NumInputs, NumChannels>& Names = TPinNames<NumInputs, NumChannels>::Get();
+			for (int32 i = 0; i < NumInputs; ++i)
+			{
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					InOutVertexData.BindReadVertex(Names.Inputs[i * NumChannels + Channel], InputValues[i * NumChannels + Channel]);
+				}
+			}
+
+			GatherInputData();
+		}
+
+		virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace EPXFVertexNames;
+			const TPinNames<NumInputs, NumChannels>& Names = TPinNames<NumInputs, NumChannels>::Get();
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InOutVertexData.BindReadVertex(Names.Outputs[Channel], OutputValues[Channel]);
+			}
+
+			for (int32 i = 0; i < NumInputs; ++i)
+			{
+				InOutVertexData.BindReadVertex(Names.OutputActives[i], OutputActive[i]);
+			}
+		}
+
+		virtual FDataReferenceCollection GetInputs() const override
+		{
+			// This should never be called. Bind(...) is called instead. This method
+			// exists as a stop-gap until the API can be deprecated and removed.
+			checkNoEntry();
+			return {};
+		}
+
+		virtual FDataReferenceCollection GetOutputs() const override
+		{
+			// This should never be called. Bind(...) is called instead. This method
+			// exists as a stop-gap until the API can be deprecated and removed.
+			checkNoEntry();
+			return {};
+		}
+
+		// The input buffers only move when the inputs are rebound, so their data pointers are cached rather than gathered every block
+		void GatherInputData()
+		{
+			Crossfader.SetBuffers(InputValues, OutputValues);
+		}
+
+		void PerformCrossfadeOutput()
+		{
+			Crossfader.GetCrossfadeOutput(*CrossfadeValue, *GainAccuracy, *Curve);
+			Crossfader.UpdateActiveOutputs(OutputActive);
+		}
+
+		// Puts the operator back as it was constructed, so a cached graph can be reused for a new sound. The first
+		// block ramps in from silence again, which is also what the constant path expects to have already happened.
+		void Reset(const IOperator::FResetParams& InParams)
+		{
+			Crossfader.Reset(OutputActive);
+			PerformCrossfadeOutput();
+		}
+
+		void Execute()
+		{
+			MSUTILS_NODE_EXECUTE_SCOPE(EPCrossfade);
+			PerformCrossfadeOutput();
+			Crossfader.PublishTelemetry(*CrossfadeValue);
+			MSUTILS_NODE_FAST_PATH(Crossfader.GetNumMixedInputs() == 1);
+		}
+
+		// With a constant crossfade the constructor's block has already ramped the gains in, and the active outputs never change again
+		virtual IOperator::FExecuteFunction GetExecuteFunction() override
+		{
+			return bConstantCrossfade ? &TEPXFOperator<NumInputs, NumChannels>::ExecuteFixedFunction : TExecutableOperator<TEPXFOperator<NumInputs, NumChannels>>::GetExecuteFunction();
+		}
+
+	private:
+		static void ExecuteFixedFunction(IOperator* InOperator)
+		{
+			static_cast<TEPXFOperator<NumInputs, NumChannels>*>(InOperator)->ExecuteFixed();
+		}
+
+		void ExecuteFixed()
+		{
+			if (!bConstantCrossfade)
+			{
+				// BindInputs connected the value, accuracy or curve after this function was handed out
+				Execute();
+				return;
+			}
+
+			MSUTILS_NODE_EXECUTE_SCOPE(EPCrossfade);
+			MSUTILS_NODE_FAST_PATH(true);
+			// The settled gains never change, so they are published once, on the first block telemetry is on for
+			if (!bFixedTelemetryPublished && Crossfader.IsTelemetryActive())
+			{
+				Crossfader.PublishTelemetry(*CrossfadeValue);
+				bFixedTelemetryPublished = true;
+			}
+			Crossfader.MixSettledOutput();
+		}
+
+		FFloatReadRef CrossfadeValue;
+		FEnumGainAccuracyReadRef GainAccuracy;
+		FEnumCrossfadeCurveReadRef Curve;
+		FInputArray InputValues;
+		TArray<FAudioBufferWriteRef, TFixedAllocator<NumChannels>> OutputValues;
+		TArray<FBoolWriteRef, TFixedAllocator<NumInputs>> OutputActive;
+
+		TEPXFHelper<NumInputs, NumChannels> Crossfader;
+		// Cleared if BindInputs connects the value, accuracy or curve
+		bool bConstantCrossfade = false;
+		bool bFixedTelemetryPublished = false;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+	};
+
+	template<uint32 NumInputs, uint32 NumChannels = 1>
+	class TEPCrossfadeNode : public FNodeFacade
+	{
+	public:
+		/**
+		 * Constructor used by the Metasound Frontend.
+		 */
+		TEPCrossfadeNode(const FNodeInitData& InInitData)
+			: FNodeFacade(InInitData.InstanceName, InInitData.InstanceID, TFacadeOperatorClass<TEPXFOperator<NumInputs, NumChannels>>())
+		{}
+
+		virtual ~TEPCrossfadeNode() = default;
+	};
+
+	template<int32 NumInputs, int32 NumChannels>
+	class TEPXFAudioRateOperator : public TExecutableOperator<TEPXFAudioRateOperator<NumInputs, NumChannels>>
+	{
+	public:
+		// Fixed capacity, so building the operator never allocates for its input references
+		using FInputArray = TArray<FAudioBufferReadRef, TFixedAllocator<NumInputs * NumChannels>>;
+
+		static const FVertexInterface& GetVertexInterface()
+		{
+			using namespace EPXFVertexNames;
+
+			auto CreateDefaultInterface = []() -> FVertexInterface
+				{
+					FInputVertexInterface InputInterface;
+
+					InputInterface.Add(TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputCrossfadeAudio)));
+					InputInterface.Add(TInputDataVertex<FEnumGainAccuracy>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGainAccuracy), (int32)MSUtilsDSP::EGainAccuracy::Exact));
+					InputInterface.Add(TInputDataVertex<FEnumCrossfadeCurve>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputCurve), (int32)MSUtilsDSP::ECrossfadeCurve::EqualPower));
+
+					AddInputAudioVertices(InputInterface, NumInputs, NumChannels);
+
+					FOutputVertexInterface OutputInterface;
+					AddOutputAudioVertices(OutputInterface, NumChannels);
+					AddOutputActiveVertices(OutputInterface, NumInputs);
+
+					return FVertexInterface(InputInterface, OutputInterface);
+				};
+
+			static const FVertexInterface DefaultInterface = CreateDefaultInterface();
+			return DefaultInterface;
+		}
+
+		static const FNodeClassMetadata& GetNodeInfo()
+		{
+			auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+				{
+					FName DataTypeName = GetMetasoundDataTypeName<FAudioBuffer>();
+					FName OperatorName = EPXFVertexNames::GetOperatorName(TEXT("Audio Rate"), NumInputs, NumChannels);
+					FText NodeDisplayName = NumChannels == 1
+						? METASOUND_LOCTEXT_FORMAT("EPXFAudioRateDisplayNamePattern", "EP Crossfade Audio Rate ({0}, {1})", GetMetasoundDataTypeDisplayText<FAudioBuffer>(), NumInputs)
+						: METASOUND_LOCTEXT_FORMAT("EPXFAudioRateMultichannelDisplayNamePattern", "EP Crossfade Audio Rate ({0}, {1}, {2})", GetMetasoundDataTypeDisplayText<FAudioBuffer>(), NumInputs, MSUtilsChannelLayout::GetLayoutDisplayName(NumChannels));
+					const FText NodeDescription = METASOUND_LOCTEXT("EPXFAudioRateDescription", "Crossfades inputs by equal power to outputs, with the crossfade value read every sample from an audio signal.");
+					FVertexInterface NodeInterface = GetVertexInterface();
+
+					FNodeClassMetadata Metadata
+					{
+						FNodeClassName { "EPXFAudioRate", OperatorName, DataTypeName },
+						1, // Major Version
+						2, // Minor Version
+						NodeDisplayName,
+						NodeDescription,
+						PluginAuthor,
+						PluginNodeMissingPrompt,
+						NodeInterface,
+						{ NodeCategories::Envelopes },
+						{ },
+						FNodeDisplayStyle()
+					};
+					return Metadata;
+				};
+
+			static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+			return Metadata;
+		}
+
+		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, TArray<TUniquePtr<IOperatorBuildError>>& OutErrors)
+		{
+			using namespace EPXFVertexNames;
+
+			const FInputVertexInterface& InputInterface = InParams.Node.GetVertexInterface().GetInputInterface();
+			const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
+
+			FAudioBufferReadRef CrossfadeValue = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputCrossfadeAudio), InParams.OperatorSettings);
+			FEnumGainAccuracyReadRef GainAccuracy = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumGainAccuracy>(InputInterface, METASOUND_GET_PARAM_NAME(InputGainAccuracy), InParams.OperatorSettings);
+			FEnumCrossfadeCurveReadRef Curve = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FEnumCrossfadeCurve>(InputInterface, METASOUND_GET_PARAM_NAME(InputCurve), InParams.OperatorSettings);
+
+			const TPinNames<NumInputs, NumChannels>& Names = TPinNames<NumInputs, NumChannels>::Get();
+			FInputArray InputValues;
+			for (int32 i = 0; i < NumInputs; ++i)
+			{
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					InputValues.Add(InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, Names.Inputs[i * NumChannels + Channel], InParams.OperatorSettings));
+				}
+			}
+
+			return MakeUnique<TEPXFAudioRateOperator<NumInputs, NumChannels>>(InParams.OperatorSettings, CrossfadeValue, GainAccuracy, Curve, MoveTemp(InputValues));
+		}
+
+		TEPXFAudioRateOperator(const FOperatorSettings& InSettings, const FAudioBufferReadRef& InCrossfadeValue, const FEnumGainAccuracyReadRef& InGainAccuracy, const FEnumCrossfadeCurveReadRef& InCurve, FInputArray&& InInputValues)
+			: CrossfadeValue(InCrossfadeValue)
+			, GainAccuracy(InGainAccuracy)
+			, Curve(InCurve)
+			, InputValues(MoveTemp(InInputValues))
+			, Crossfader(NumInputs, InSettings.GetNumFramesPerBlock())
+			, InstanceCounter(MSUtilsNodeStatsEPCrossfadeAudioRate)
+		{
+			for (uint32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				OutputValues.Add(TDataWriteReferenceFactory<FAudioBuffer>::CreateAny(InSettings));
+			}
 
 			for (uint32 i = 0; i < NumInputs; ++i)
 			{
-				InOutVertexData.BindReadVertex(GetInputName(i), InputValues[i]);
+				OutputActive.Add(FBoolWriteRef::CreateNew(false));
+			}
+
+			GatherInputData();
+
+			PerformCrossfadeOutput();
+		}
+
+		virtual ~TEPXFAudioRateOperator() = default;
+
+		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace EPXFVertexNames;
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputCrossfadeAudio), CrossfadeValue);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputGainAccuracy), GainAccuracy);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputCurve), Curve);
+
+			const TPinNames<NumInputs, NumChannels>& Names = TPinNames<NumInputs, NumChannels>::Get();
+			for (int32 i = 0; i < NumInputs; ++i)
+			{
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					InOutVertexData.BindReadVertex(Names.Inputs[i * NumChannels + Channel], InputValues[i * NumChannels + Channel]);
+				}
 			}
+
+			GatherInputData();
 		}
 
 		virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
 		{
 			using namespace EPXFVertexNames;
-			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger), OutputValue);
+			const TPinNames<NumInputs, NumChannels>& Names = TPinNames<NumInputs, NumChannels>::Get();
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				InOutVertexData.BindReadVertex(Names.Outputs[Channel], OutputValues[Channel]);
+			}
+
+			for (int32 i = 0; i < NumInputs; ++i)
+			{
+				InOutVertexData.BindReadVertex(Names.OutputActives[i], OutputActive[i]);
+			}
 		}
 
 		virtual FDataReferenceCollection GetInputs() const override
@@ -257,62 +732,86 @@ namespace Metasound
 			return {};
 		}
 
+		// The input buffers only move when the inputs are rebound, so their data pointers are cached rather than gathered every block
+		void GatherInputData()
+		{
+			for (int32 i = 0; i < NumInputs * NumChannels; ++i)
+			{
+				InputData[i] = InputValues[i]->GetData();
+			}
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				OutputData[Channel] = OutputValues[Channel]->GetData();
+			}
+		}
+
 		void PerformCrossfadeOutput()
 		{
-			// Clamp the cross fade value based on the number of inputs
-			float CurrentCrossfadeValue = FMath::Clamp(*CrossfadeValue, 0.0f, (float)(NumInputs - 1));
+			Crossfader.SetCurve(*Curve);
+			Crossfader.Process(CrossfadeValue->GetData(), *GainAccuracy, InputData, OutputData, NumChannels, CrossfadeValue->Num());
 
-			// Only update the cross fade state if anything has changed
-			if (!FMath::IsNearlyEqual(CurrentCrossfadeValue, PrevCrossfadeValue))
+			// Only the inputs in last block's or this block's active range can have changed activity
+			for (int32 i = PrevFirstActiveInput; i <= PrevLastActiveInput; ++i)
 			{
-				PrevCrossfadeValue = CurrentCrossfadeValue;
-				//Set IndexA to the integer below the currentcrossfadevalue.
-				IndexA = (int32)FMath::Floor(CurrentCrossfadeValue);
-				//Set IndexB to the integer above Index A giving a range between them, for example, 3 - 4.
-				IndexB = FMath::Clamp(IndexA + 1, 0.0f, (float)(NumInputs - 1));
-				//Alpha is the float value between the two integers. So if the crossfade value is 3.4, the alpha will be 0.4.
-				Alpha = CurrentCrossfadeValue - (float)IndexA;
+				*OutputActive[i] = false;
 			}
 
-			// Need to call this each block in case inputs have changed
-			//Input values is an array of input types such as a float of a FAudioBufferReadRef
-			Crossfader.GetCrossfadeOutput(IndexA, IndexB, Alpha, InputValues, *OutputValue);
+			PrevFirstActiveInput = Crossfader.GetFirstActiveInput();
+			PrevLastActiveInput = Crossfader.GetLastActiveInput();
+			for (int32 i = PrevFirstActiveInput; i <= PrevLastActiveInput; ++i)
+			{
+				*OutputActive[i] = true;
+			}
 		}
 
+		// Puts the operator back as it was constructed, so a cached graph can be reused for a new sound
 		void Reset(const IOperator::FResetParams& InParams)
 		{
+			Crossfader.Reset();
+			for (FBoolWriteRef& Active : OutputActive)
+			{
+				*Active = false;
+			}
+			PrevFirstActiveInput = 0;
+			PrevLastActiveInput = -1;
 			PerformCrossfadeOutput();
 		}
 
 		void Execute()
 		{
+			MSUTILS_NODE_EXECUTE_SCOPE(EPCrossfadeAudioRate);
 			PerformCrossfadeOutput();
+			MSUTILS_NODE_FAST_PATH(PrevFirstActiveInput == PrevLastActiveInput);
 		}
 
 	private:
-		FFloatReadRef CrossfadeValue;
-		TArray<TDataReadReference<FAudioBuffer>> InputValues;
-		TDataWriteReference<FAudioBuffer> OutputValue;
-
-		float PrevCrossfadeValue = -1.0f;
-		int32 IndexA = 0;
-		int32 IndexB = 0;
-		float Alpha = 0.0f;
-		TEPXFHelper Crossfader;
+		FAudioBufferReadRef CrossfadeValue;
+		FEnumGainAccuracyReadRef GainAccuracy;
+		FEnumCrossfadeCurveReadRef Curve;
+		FInputArray InputValues;
+		TArray<FAudioBufferWriteRef, TFixedAllocator<NumChannels>> OutputValues;
+		TArray<FBoolWriteRef, TFixedAllocator<NumInputs>> OutputActive;
+
+		const float* InputData[NumInputs * NumChannels] = {};
+		float* OutputData[NumChannels] = {};
+		MSUtilsDSP::FAudioRateEqualPowerCrossfader Crossfader;
+		int32 PrevFirstActiveInput = 0;
+		int32 PrevLastActiveInput = -1;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
 	};
 
-	template<uint32 NumInputs>
-	class TEPCrossfadeNode : public FNodeFacade
+	template<uint32 NumInputs, uint32 NumChannels = 1>
+	class TEPCrossfadeAudioRateNode : public FNodeFacade
 	{
 	public:
 		/**
 		 * Constructor used by the Metasound Frontend.
 		 */
-		TEPCrossfadeNode(const FNodeInitData& InInitData)
-			: FNodeFacade(InInitData.InstanceName, InInitData.InstanceID, TFacadeOperatorClass<TEPXFOperator<NumInputs>>())
+		TEPCrossfadeAudioRateNode(const FNodeInitData& InInitData)
+			: FNodeFacade(InInitData.InstanceName, InInitData.InstanceID, TFacadeOperatorClass<TEPXFAudioRateOperator<NumInputs, NumChannels>>())
 		{}
 
-		virtual ~TEPCrossfadeNode() = default;
+		virtual ~TEPCrossfadeAudioRateNode() = default;
 	};
 
 	REGISTER_EPCROSSFADE_NODE(2);
@@ -322,6 +821,34 @@ namespace Metasound
 	REGISTER_EPCROSSFADE_NODE(6);
 	REGISTER_EPCROSSFADE_NODE(7);
 	REGISTER_EPCROSSFADE_NODE(8);
+	REGISTER_EPCROSSFADE_NODE(12);
+	REGISTER_EPCROSSFADE_NODE(16);
+	REGISTER_EPCROSSFADE_NODE(24);
+	REGISTER_EPCROSSFADE_NODE(32);
+	REGISTER_EPCROSSFADE_NODE(48);
+	REGISTER_EPCROSSFADE_NODE(64);
+
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(2);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(3);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(4);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(5);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(6);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(7);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(8);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(12);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(16);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(24);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(32);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(48);
+	REGISTER_EPCROSSFADE_AUDIO_RATE_NODE(64);
+
+	REGISTER_EPCROSSFADE_MULTICHANNEL_NODES(2);
+	REGISTER_EPCROSSFADE_MULTICHANNEL_NODES(3);
+	REGISTER_EPCROSSFADE_MULTICHANNEL_NODES(4);
+	REGISTER_EPCROSSFADE_MULTICHANNEL_NODES(5);
+	REGISTER_EPCROSSFADE_MULTICHANNEL_NODES(6);
+	REGISTER_EPCROSSFADE_MULTICHANNEL_NODES(7);
+	REGISTER_EPCROSSFADE_MULTICHANNEL_NODES(8);
 
 }
 
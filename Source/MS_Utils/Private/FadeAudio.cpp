@@ -0,0 +1,233 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#include "CoreMinimal.h"
+
+#include "Internationalization/Text.h"
+#include "MetasoundAudioBuffer.h"
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundFacade.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundStandardNodesCategories.h"
+#include "MetasoundStandardNodesNames.h"
+#include "MetasoundTime.h"
+#include "MetasoundTrigger.h"
+#include "MSUtilsDSP/FadeEnvelope.h"
+#include "MSUtilsFadeEvents.h"
+#include "MSUtilsProfiling.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_FadeAudio"
+
+namespace Metasound
+{
+	// Shared by both directions
+	MSUTILS_DECLARE_NODE_STATS(FadeAudio, "Fade Audio");
+
+	namespace FadeAudioNodeNames
+	{
+		//Inputs
+		METASOUND_PARAM(InAudio, "Audio In", "Audio to fade");
+		METASOUND_PARAM(InTrigger, "Trigger Fade", "Triggers the fade to begin");
+		METASOUND_PARAM(InResetFade, "Reset Fade", "Snaps the fade back to where it started");
+		METASOUND_PARAM(InFadeTime, "Fade Time", "Fade Time");
+
+		//Outputs
+		METASOUND_PARAM(OutAudio, "Audio Out", "The input audio with the fade applied");
+		METASOUND_PARAM(OutEnvParam, "Envelope Out", "Fade value at the end of the block");
+		METASOUND_PARAM(OutTriggerStart, "On Fade Start", "Triggers when the fade starts");
+		METASOUND_PARAM(OutTriggerFinished, "On Fade Finished", "Triggers when the fade finishes");
+	}
+
+	//Simple Fade In/Out with the multiply built in. The envelope is applied to the audio as it is generated, so a faded
+	//voice needs no separate multiply node and no envelope buffer, and a finished fade is a straight copy.
+	template<MSUtilsDSP::EFadeDirection Direction>
+	class TFadeAudioOperator : public TExecutableOperator<TFadeAudioOperator<Direction>>
+	{
+	public:
+		static const FVertexInterface& GetVertexInterface()
+		{
+			using namespace FadeAudioNodeNames;
+
+			static const FVertexInterface Interface(
+				FInputVertexInterface(
+					TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InAudio)),
+					TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InTrigger)),
+					TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InResetFade)),
+					TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFadeTime), 1.0f)
+				),
+				FOutputVertexInterface(
+					TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutAudio)),
+					TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutTriggerStart)),
+					TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutTriggerFinished)),
+					TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutEnvParam))
+				)
+			);
+
+			return Interface;
+		}
+
+		static const FNodeClassMetadata& GetNodeInfo()
+		{
+			auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+				{
+					const bool bFadeIn = Direction == MSUtilsDSP::EFadeDirection::In;
+
+					FNodeClassMetadata Metadata
+					{
+						{ TEXT("UE"), bFadeIn ? TEXT("FadeAudioIn") : TEXT("FadeAudioOut"), TEXT("Audio") },
+						1, // Major Version
+						0, // Minor Version
+						bFadeIn ? METASOUND_LOCTEXT("FadeAudioInDisplayName", "Fade Audio In") : METASOUND_LOCTEXT("FadeAudioOutDisplayName", "Fade Audio Out"),
+						bFadeIn ? METASOUND_LOCTEXT("FadeAudioInNodeDesc", "Fades audio in from silence over a given time")
+							: METASOUND_LOCTEXT("FadeAudioOutNodeDesc", "Fades audio out to silence over a given time"),
+						PluginAuthor,
+						PluginNodeMissingPrompt,
+						GetVertexInterface(),
+						{ NodeCategories::Envelopes },
+						{ },
+						FNodeDisplayStyle{}
+					};
+
+					return Metadata;
+				};
+
+			static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+			return Metadata;
+		}
+
+		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+		{
+			using namespace FadeAudioNodeNames;
+
+			const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
+			const FInputVertexInterface& InputInterface = GetVertexInterface().GetInputInterface();
+
+			FAudioBufferReadRef AudioIn = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InAudio), InParams.OperatorSettings);
+			FTimeReadRef FadeTimeIn = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(InputInterface, METASOUND_GET_PARAM_NAME(InFadeTime), InParams.OperatorSettings);
+			FTriggerReadRef TriggerIn = InputCollection.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(InTrigger), InParams.OperatorSettings);
+			FTriggerReadRef TriggerResetIn = InputCollection.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(InResetFade), InParams.OperatorSettings);
+
+			return MakeUnique<TFadeAudioOperator<Direction>>(InParams.OperatorSettings, AudioIn, FadeTimeIn, TriggerIn, TriggerResetIn);
+		}
+
+		TFadeAudioOperator(const FOperatorSettings& InSettings,
+			const FAudioBufferReadRef& InAudio,
+			const FTimeReadRef& InFadeTime,
+			const FTriggerReadRef& InTriggerFade,
+			const FTriggerReadRef& InTriggerReset)
+			: AudioIn(InAudio)
+			, TriggerFade(InTriggerFade)
+			, ResetFade(InTriggerReset)
+			, FadeTime(InFadeTime)
+			, AudioOut(FAudioBufferWriteRef::CreateNew(InSettings))
+			, TriggerStart(FTriggerWriteRef::CreateNew(InSettings))
+			, TriggerFinished(FTriggerWriteRef::CreateNew(InSettings))
+			, OutEnvelope(FFloatWriteRef::CreateNew(Direction == MSUtilsDSP::EFadeDirection::In ? 0.0f : 1.0f))
+			, SampleRate(InSettings.GetSampleRate())
+			, NumFramesPerBlock(InSettings.GetNumFramesPerBlock())
+			, Envelope(Direction)
+			, InstanceCounter(MSUtilsNodeStatsFadeAudio)
+			, Telemetry(MSUtilsNodeStatsFadeAudio.GetName())
+		{
+		}
+
+		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace FadeAudioNodeNames;
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InAudio), AudioIn);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InTrigger), TriggerFade);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InResetFade), ResetFade);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFadeTime), FadeTime);
+		}
+
+		virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace FadeAudioNodeNames;
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutAudio), AudioOut);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutTriggerStart), TriggerStart);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutTriggerFinished), TriggerFinished);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutEnvParam), OutEnvelope);
+		}
+
+		// Puts the operator back as it was constructed, so a cached graph can be reused for a new sound
+		void Reset(const IOperator::FResetParams& InParams)
+		{
+			SampleRate = InParams.OperatorSettings.GetSampleRate();
+			Envelope.Reset();
+			FadeEvents.Reset();
+			TriggerStart->Reset();
+			TriggerFinished->Reset();
+			*OutEnvelope = Envelope.GetValue();
+			AudioOut->Zero();
+		}
+
+		void Execute()
+		{
+			MSUTILS_NODE_EXECUTE_SCOPE(FadeAudio);
+
+			TriggerStart->AdvanceBlock();
+			TriggerFinished->AdvanceBlock();
+
+			GatherFadeEvents(*TriggerFade, *ResetFade, SampleRate * FadeTime->GetSeconds(), FadeEvents);
+			for (const MSUtilsDSP::FFadeEvent& Event : FadeEvents)
+			{
+				if (Event.Type == MSUtilsDSP::EFadeEventType::Start)
+				{
+					TriggerStart->TriggerFrame(Event.Frame);
+				}
+			}
+
+			// With nothing to do the block is a copy, a constant gain or silence
+			MSUTILS_NODE_FAST_PATH(FadeEvents.Num() == 0 && !Envelope.IsFading());
+
+			Envelope.ApplyBlock(AudioIn->GetData(), AudioOut->GetData(), NumFramesPerBlock, FadeEvents.GetData(), FadeEvents.Num(),
+				[this](int32 FinishedFrame)
+				{
+					TriggerFinished->TriggerFrame(FinishedFrame);
+				});
+
+			*OutEnvelope = Envelope.GetValue();
+			PublishFadeTelemetry(Telemetry, Envelope);
+		}
+
+	private:
+		FAudioBufferReadRef AudioIn;
+		FTriggerReadRef TriggerFade;
+		FTriggerReadRef ResetFade;
+		FTimeReadRef FadeTime;
+		FAudioBufferWriteRef AudioOut;
+		FTriggerWriteRef TriggerStart;
+		FTriggerWriteRef TriggerFinished;
+		FFloatWriteRef OutEnvelope;
+		float SampleRate = 0.0f;
+		int32 NumFramesPerBlock = 0;
+		MSUtilsDSP::FFadeEnvelope Envelope;
+		// Inline capacity, so gathering a block's triggers on the render thread does not allocate
+		TArray<MSUtilsDSP::FFadeEvent, TInlineAllocator<16>> FadeEvents;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+		MSUtilsDSP::FTelemetryPublisher Telemetry;
+	};
+
+	template<MSUtilsDSP::EFadeDirection Direction>
+	class TFadeAudioNode : public FNodeFacade
+	{
+	public:
+		/**
+		 * Constructor used by the Metasound Frontend.
+		 */
+		TFadeAudioNode(const FNodeInitData& InInitData)
+			: FNodeFacade(InInitData.InstanceName, InInitData.InstanceID, TFacadeOperatorClass<TFadeAudioOperator<Direction>>())
+		{}
+
+		virtual ~TFadeAudioNode() = default;
+	};
+
+	using FFadeAudioInNode = TFadeAudioNode<MSUtilsDSP::EFadeDirection::In>;
+	METASOUND_REGISTER_NODE(FFadeAudioInNode)
+
+	using FFadeAudioOutNode = TFadeAudioNode<MSUtilsDSP::EFadeDirection::Out>;
+	METASOUND_REGISTER_NODE(FFadeAudioOutNode)
+}
+
+#undef LOCTEXT_NAMESPACE
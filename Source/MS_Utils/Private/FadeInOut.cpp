@@ -0,0 +1,244 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved.
+
+#include "CoreMinimal.h"
+
+#include "Internationalization/Text.h"
+#include "MetasoundAudioBuffer.h"
+#include "MetasoundExecutableOperator.h"
+#include "MetasoundFacade.h"
+#include "MetasoundNodeRegistrationMacro.h"
+#include "MetasoundParamHelper.h"
+#include "MetasoundPrimitives.h"
+#include "MetasoundStandardNodesCategories.h"
+#include "MetasoundStandardNodesNames.h"
+#include "MetasoundTime.h"
+#include "MetasoundTrigger.h"
+#include "MSUtilsDSP/FadeEngine.h"
+#include "MSUtilsFadeEvents.h"
+#include "MSUtilsProfiling.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_FadeInOut"
+
+namespace Metasound
+{
+	MSUTILS_DECLARE_NODE_STATS(FadeInOut, "Fade In/Out");
+
+	namespace FadeInOutNodeNames
+	{
+		//Inputs
+		METASOUND_PARAM(InAudio, "Audio In", "Audio to fade");
+		METASOUND_PARAM(InFadeIn, "Fade In", "Fades in from the current value");
+		METASOUND_PARAM(InFadeOut, "Fade Out", "Fades out from the current value");
+		METASOUND_PARAM(InHold, "Hold", "Stops the fade where it is");
+		METASOUND_PARAM(InFadeInTime, "Fade In Time", "Time a fade in from silence takes. Fades in from part way take proportionally less.");
+		METASOUND_PARAM(InFadeOutTime, "Fade Out Time", "Time a fade out from full level takes. Fades out from part way take proportionally less.");
+		METASOUND_PARAM(InStartFadedIn, "Start Faded In", "Starts at full level rather than silent");
+
+		//Outputs
+		METASOUND_PARAM(OutAudio, "Audio Out", "The input audio with the fade applied");
+		METASOUND_PARAM(OutEnvParam, "Envelope Out", "Fade value at the end of the block");
+		METASOUND_PARAM(OutTriggerFadedIn, "On Fade In Finished", "Triggers when a fade in reaches full level");
+		METASOUND_PARAM(OutTriggerFadedOut, "On Fade Out Finished", "Triggers when a fade out reaches silence");
+	}
+
+	//Fade in, fade out and hold in one node, replacing a Simple Fade In, a Simple Fade Out and the logic between them.
+	//Every trigger continues from wherever the fade currently is, so reversing a fade part way through does not click.
+	class FFadeInOutOperator : public TExecutableOperator<FFadeInOutOperator>
+	{
+	public:
+		static const FVertexInterface& GetVertexInterface()
+		{
+			using namespace FadeInOutNodeNames;
+
+			static const FVertexInterface Interface(
+				FInputVertexInterface(
+					TInputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InAudio)),
+					TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFadeIn)),
+					TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFadeOut)),
+					TInputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(InHold)),
+					TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFadeInTime), 1.0f),
+					TInputDataVertex<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InFadeOutTime), 1.0f),
+					TInputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InStartFadedIn), false)
+				),
+				FOutputVertexInterface(
+					TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutAudio)),
+					TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutTriggerFadedIn)),
+					TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutTriggerFadedOut)),
+					TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutEnvParam))
+				)
+			);
+
+			return Interface;
+		}
+
+		static const FNodeClassMetadata& GetNodeInfo()
+		{
+			auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+				{
+					FNodeClassMetadata Metadata
+					{
+						{ TEXT("UE"), TEXT("FadeInOut"), TEXT("Audio") },
+						1, // Major Version
+						0, // Minor Version
+						METASOUND_LOCTEXT("FadeInOutDisplayName", "Fade In/Out"),
+						METASOUND_LOCTEXT("FadeInOutNodeDesc", "Fades audio in and out, continuing from the current level whenever it is retriggered"),
+						PluginAuthor,
+						PluginNodeMissingPrompt,
+						GetVertexInterface(),
+						{ NodeCategories::Envelopes },
+						{ },
+						FNodeDisplayStyle{}
+					};
+
+					return Metadata;
+				};
+
+			static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+			return Metadata;
+		}
+
+		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+		{
+			using namespace FadeInOutNodeNames;
+
+			const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
+			const FInputVertexInterface& InputInterface = GetVertexInterface().GetInputInterface();
+
+			FAudioBufferReadRef AudioIn = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InAudio), InParams.OperatorSettings);
+			FTriggerReadRef FadeInTrigger = InputCollection.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(InFadeIn), InParams.OperatorSettings);
+			FTriggerReadRef FadeOutTrigger = InputCollection.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(InFadeOut), InParams.OperatorSettings);
+			FTriggerReadRef HoldTrigger = InputCollection.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(InHold), InParams.OperatorSettings);
+			FTimeReadRef FadeInTime = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(InputInterface, METASOUND_GET_PARAM_NAME(InFadeInTime), InParams.OperatorSettings);
+			FTimeReadRef FadeOutTime = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(InputInterface, METASOUND_GET_PARAM_NAME(InFadeOutTime), InParams.OperatorSettings);
+			FBoolReadRef StartFadedIn = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<bool>(InputInterface, METASOUND_GET_PARAM_NAME(InStartFadedIn), InParams.OperatorSettings);
+
+			return MakeUnique<FFadeInOutOperator>(InParams.OperatorSettings, AudioIn, FadeInTrigger, FadeOutTrigger, HoldTrigger, FadeInTime, FadeOutTime, StartFadedIn);
+		}
+
+		FFadeInOutOperator(const FOperatorSettings& InSettings,
+			const FAudioBufferReadRef& InAudio,
+			const FTriggerReadRef& InFadeInTrigger,
+			const FTriggerReadRef& InFadeOutTrigger,
+			const FTriggerReadRef& InHoldTrigger,
+			const FTimeReadRef& InFadeInTime,
+			const FTimeReadRef& InFadeOutTime,
+			const FBoolReadRef& InStartFadedIn)
+			: AudioIn(InAudio)
+			, FadeInTrigger(InFadeInTrigger)
+			, FadeOutTrigger(InFadeOutTrigger)
+			, HoldTrigger(InHoldTrigger)
+			, FadeInTime(InFadeInTime)
+			, FadeOutTime(InFadeOutTime)
+			, StartFadedIn(InStartFadedIn)
+			, AudioOut(FAudioBufferWriteRef::CreateNew(InSettings))
+			, TriggerFadedIn(FTriggerWriteRef::CreateNew(InSettings))
+			, TriggerFadedOut(FTriggerWriteRef::CreateNew(InSettings))
+			, OutEnvelope(FFloatWriteRef::CreateNew(*InStartFadedIn ? 1.0f : 0.0f))
+			, SampleRate(InSettings.GetSampleRate())
+			, NumFramesPerBlock(InSettings.GetNumFramesPerBlock())
+			, Engine(*InStartFadedIn ? 1.0f : 0.0f)
+			, InstanceCounter(MSUtilsNodeStatsFadeInOut)
+			, Telemetry(MSUtilsNodeStatsFadeInOut.GetName())
+		{
+		}
+
+		virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace FadeInOutNodeNames;
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InAudio), AudioIn);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFadeIn), FadeInTrigger);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFadeOut), FadeOutTrigger);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InHold), HoldTrigger);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFadeInTime), FadeInTime);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InFadeOutTime), FadeOutTime);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InStartFadedIn), StartFadedIn);
+		}
+
+		virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+		{
+			using namespace FadeInOutNodeNames;
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutAudio), AudioOut);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutTriggerFadedIn), TriggerFadedIn);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutTriggerFadedOut), TriggerFadedOut);
+			InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutEnvParam), OutEnvelope);
+		}
+
+		// Puts the operator back as it was constructed, so a cached graph can be reused for a new sound. Start Faded In
+		// is read again, as the constructor does.
+		void Reset(const IOperator::FResetParams& InParams)
+		{
+			SampleRate = InParams.OperatorSettings.GetSampleRate();
+			Engine.Reset(*StartFadedIn ? 1.0f : 0.0f);
+			FadeCommands.Reset();
+			TriggerFadedIn->Reset();
+			TriggerFadedOut->Reset();
+			*OutEnvelope = Engine.GetValue();
+			AudioOut->Zero();
+		}
+
+		void Execute()
+		{
+			MSUTILS_NODE_EXECUTE_SCOPE(FadeInOut);
+
+			TriggerFadedIn->AdvanceBlock();
+			TriggerFadedOut->AdvanceBlock();
+
+			GatherFadeCommands(*FadeInTrigger, *FadeOutTrigger, *HoldTrigger, SampleRate * FadeInTime->GetSeconds(), SampleRate * FadeOutTime->GetSeconds(), FadeCommands);
+
+			MSUTILS_NODE_FAST_PATH(FadeCommands.Num() == 0 && !Engine.IsFading());
+
+			Engine.ApplyBlock(AudioIn->GetData(), AudioOut->GetData(), NumFramesPerBlock, FadeCommands.GetData(), FadeCommands.Num(),
+				[this](int32 FinishedFrame, MSUtilsDSP::EFadeDirection Direction)
+				{
+					if (Direction == MSUtilsDSP::EFadeDirection::In)
+					{
+						TriggerFadedIn->TriggerFrame(FinishedFrame);
+					}
+					else
+					{
+						TriggerFadedOut->TriggerFrame(FinishedFrame);
+					}
+				});
+
+			*OutEnvelope = Engine.GetValue();
+			PublishFadeTelemetry(Telemetry, Engine);
+		}
+
+	private:
+		FAudioBufferReadRef AudioIn;
+		FTriggerReadRef FadeInTrigger;
+		FTriggerReadRef FadeOutTrigger;
+		FTriggerReadRef HoldTrigger;
+		FTimeReadRef FadeInTime;
+		FTimeReadRef FadeOutTime;
+		FBoolReadRef StartFadedIn;
+		FAudioBufferWriteRef AudioOut;
+		FTriggerWriteRef TriggerFadedIn;
+		FTriggerWriteRef TriggerFadedOut;
+		FFloatWriteRef OutEnvelope;
+		float SampleRate = 0.0f;
+		int32 NumFramesPerBlock = 0;
+		MSUtilsDSP::FFadeEngine Engine;
+		// Inline capacity, so gathering a block's triggers on the render thread does not allocate
+		TArray<MSUtilsDSP::FFadeCommand, TInlineAllocator<16>> FadeCommands;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+		MSUtilsDSP::FTelemetryPublisher Telemetry;
+	};
+
+	class FFadeInOutNode : public FNodeFacade
+	{
+	public:
+		/**
+		 * Constructor used by the Metasound Frontend.
+		 */
+		FFadeInOutNode(const FNodeInitData& InInitData)
+			: FNodeFacade(InInitData.InstanceName, InInitData.InstanceID, TFacadeOperatorClass<FFadeInOutOperator>())
+		{}
+
+		virtual ~FFadeInOutNode() = default;
+	};
+
+	METASOUND_REGISTER_NODE(FFadeInOutNode)
+}
+
+#undef LOCTEXT_NAMESPACE
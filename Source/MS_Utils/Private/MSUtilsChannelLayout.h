@@ -0,0 +1,74 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Internationalization/Text.h"
+#include "MetasoundVertex.h"
+#include "MSUtilsVertexNames.h"
+
+namespace Metasound
+{
+	//Speaker layouts of the multichannel node variants. Channels are planar, one audio pin per speaker, in the
+	//usual L, R, C, LFE, surround order.
+	namespace MSUtilsChannelLayout
+	{
+		//Suffix added to a pin name for the given channel, e.g. "In 0 L"
+		inline const TCHAR* GetChannelSuffix(int32 NumChannels, int32 Channel)
+		{
+			static const TCHAR* StereoSuffixes[] = { TEXT("L"), TEXT("R") };
+			static const TCHAR* SurroundSuffixes[] = { TEXT("L"), TEXT("R"), TEXT("C"), TEXT("LFE"), TEXT("SL"), TEXT("SR"), TEXT("BL"), TEXT("BR") };
+
+			check(Channel >= 0 && Channel < NumChannels);
+			return NumChannels == 2 ? StereoSuffixes[Channel] : SurroundSuffixes[Channel];
+		}
+
+		//Pin name for one channel of a pin, e.g. "Audio Out" and channel 1 of stereo give "Audio Out R"
+		inline FVertexName GetChannelVertexName(const FVertexName& BaseName, int32 NumChannels, int32 Channel)
+		{
+			return *FString::Printf(TEXT("%s %s"), *BaseName.ToString(), GetChannelSuffix(NumChannels, Channel));
+		}
+
+		inline FDataVertexMetadata GetChannelVertexMetadata(const FText& Description, int32 NumChannels, int32 Channel)
+		{
+			return FDataVertexMetadata{ FText::Format(NSLOCTEXT("MSUtilsChannelLayout", "ChannelDescription", "{0}, {1} channel."), Description, FText::FromString(GetChannelSuffix(NumChannels, Channel))) };
+		}
+
+		//GetChannelVertexName for every channel of a pin, formatted once and held as a function local static
+		template<int32 NumChannels>
+		class TChannelVertexNames : public MSUtilsVertexNames::TVertexNameArray<NumChannels>
+		{
+		public:
+			explicit TChannelVertexNames(const FVertexName& BaseName)
+				: MSUtilsVertexNames::TVertexNameArray<NumChannels>([&BaseName](int32 Channel) { return GetChannelVertexName(BaseName, NumChannels, Channel); })
+			{
+			}
+		};
+
+		//Used in node class names, so must not change once a layout has shipped
+		inline const TCHAR* GetLayoutName(int32 NumChannels)
+		{
+			switch (NumChannels)
+			{
+			case 1: return TEXT("Mono");
+			case 2: return TEXT("Stereo");
+			case 6: return TEXT("5.1");
+			case 8: return TEXT("7.1");
+			default: checkNoEntry(); return TEXT("");
+			}
+		}
+
+		inline FText GetLayoutDisplayName(int32 NumChannels)
+		{
+			switch (NumChannels)
+			{
+			case 1: return NSLOCTEXT("MSUtilsChannelLayout", "MonoLayout", "Mono");
+			case 2: return NSLOCTEXT("MSUtilsChannelLayout", "StereoLayout", "Stereo");
+			case 6: return NSLOCTEXT("MSUtilsChannelLayout", "FivePointOneLayout", "5.1");
+			case 8: return NSLOCTEXT("MSUtilsChannelLayout", "SevenPointOneLayout", "7.1");
+			default: checkNoEntry(); return FText::GetEmpty();
+			}
+		}
+	}
+}
@@ -0,0 +1,35 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MetasoundDataReferenceCollection.h"
+#include "MetasoundVertex.h"
+#include "MetasoundVertexData.h"
+
+namespace Metasound
+{
+	//An input with nothing connected to it is constructed from its default (or the literal set on the node) when the
+	//operator is built, and nothing writes to it afterwards. Anything worked out only from such inputs can be worked
+	//out once in CreateOperator instead of every block.
+	namespace MSUtilsConstantInputs
+	{
+		template<typename DataType>
+		bool IsConstant(const FDataReferenceCollection& InputCollection, const FVertexName& VertexName)
+		{
+			return !InputCollection.ContainsDataReadReference<DataType>(VertexName);
+		}
+
+		//BindInputs can hand an operator different references after it is built, so anything worked out from the
+		//constant ones only still holds if they are bound again. Binds the vertex and returns false if it now reads
+		//from different data.
+		template<typename DataType>
+		bool BindReadVertexUnchanged(FInputVertexInterfaceData& InOutVertexData, const FVertexName& VertexName, TDataReadReference<DataType>& InOutReference)
+		{
+			const DataType* const PreviousData = &*InOutReference;
+			InOutVertexData.BindReadVertex(VertexName, InOutReference);
+			return &*InOutReference == PreviousData;
+		}
+	}
+}
@@ -0,0 +1,25 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#include "MSUtilsEnums.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_MSUtilsEnums"
+
+namespace Metasound
+{
+	DEFINE_METASOUND_ENUM_BEGIN(MSUtilsDSP::EGainAccuracy, FEnumGainAccuracy, "MSUtilsGainAccuracy")
+		DEFINE_METASOUND_ENUM_ENTRY(MSUtilsDSP::EGainAccuracy::Exact, "GainAccuracyExactDescription", "Exact", "GainAccuracyExactDescriptionTT", "Gains use the exact cosine. Best when gains change once per block."),
+		DEFINE_METASOUND_ENUM_ENTRY(MSUtilsDSP::EGainAccuracy::Fast, "GainAccuracyFastDescription", "Fast", "GainAccuracyFastDescriptionTT", "Gains use a polynomial approximation accurate to within 2e-7. Much cheaper when gains change every sample."),
+	DEFINE_METASOUND_ENUM_END()
+
+	DEFINE_METASOUND_ENUM_BEGIN(MSUtilsDSP::ECrossfadeCurve, FEnumCrossfadeCurve, "MSUtilsCrossfadeCurve")
+		DEFINE_METASOUND_ENUM_ENTRY(MSUtilsDSP::ECrossfadeCurve::EqualPower, "CrossfadeCurveEqualPowerDescription", "Equal Power", "CrossfadeCurveEqualPowerDescriptionTT", "Cosine crossfade. Keeps the power constant, so uncorrelated inputs stay at the same loudness."),
+		DEFINE_METASOUND_ENUM_ENTRY(MSUtilsDSP::ECrossfadeCurve::Linear, "CrossfadeCurveLinearDescription", "Linear", "CrossfadeCurveLinearDescriptionTT", "Equal gain crossfade. Keeps the amplitude constant, for correlated inputs."),
+		DEFINE_METASOUND_ENUM_ENTRY(MSUtilsDSP::ECrossfadeCurve::SCurve, "CrossfadeCurveSCurveDescription", "S-Curve", "CrossfadeCurveSCurveDescriptionTT", "Equal gain crossfade that eases in and out of each input."),
+		DEFINE_METASOUND_ENUM_ENTRY(MSUtilsDSP::ECrossfadeCurve::Sqrt, "CrossfadeCurveSqrtDescription", "Square Root", "CrossfadeCurveSqrtDescriptionTT", "Constant power crossfade with a sharper fade in than the cosine."),
+		DEFINE_METASOUND_ENUM_ENTRY(MSUtilsDSP::ECrossfadeCurve::PanLaw3dB, "CrossfadeCurvePanLaw3dBDescription", "-3 dB Pan Law", "CrossfadeCurvePanLaw3dBDescriptionTT", "Each input is at -3 dB halfway. The same gains as Equal Power."),
+		DEFINE_METASOUND_ENUM_ENTRY(MSUtilsDSP::ECrossfadeCurve::PanLaw4p5dB, "CrossfadeCurvePanLaw4p5dBDescription", "-4.5 dB Pan Law", "CrossfadeCurvePanLaw4p5dBDescriptionTT", "Each input is at -4.5 dB halfway, a compromise between constant power and constant amplitude."),
+		DEFINE_METASOUND_ENUM_ENTRY(MSUtilsDSP::ECrossfadeCurve::PanLaw6dB, "CrossfadeCurvePanLaw6dBDescription", "-6 dB Pan Law", "CrossfadeCurvePanLaw6dBDescriptionTT", "Each input is at -6 dB halfway. Constant amplitude with a smooth start and end."),
+	DEFINE_METASOUND_ENUM_END()
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,94 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MetasoundTrigger.h"
+#include "MSUtilsDSP/FadeEngine.h"
+#include "MSUtilsDSP/FadeEnvelope.h"
+#include "MSUtilsDSP/Telemetry.h"
+
+namespace Metasound
+{
+	//Merges a fade's start and reset triggers for this block into frame ordered events for MSUtilsDSP::FFadeEnvelope.
+	//A reset on the same frame as a start is applied first, so the fade restarts from its rest value. Callers hold
+	//OutEvents with inline capacity, so this does not allocate on the render thread.
+	template<typename AllocatorType>
+	void GatherFadeEvents(const FTrigger& StartTrigger, const FTrigger& ResetTrigger, float FadeSamples, TArray<MSUtilsDSP::FFadeEvent, AllocatorType>& OutEvents)
+	{
+		OutEvents.Reset();
+
+		const int32 NumStarts = StartTrigger.NumTriggeredInBlock();
+		const int32 NumResets = ResetTrigger.NumTriggeredInBlock();
+		int32 StartIndex = 0;
+		int32 ResetIndex = 0;
+
+		while (StartIndex < NumStarts || ResetIndex < NumResets)
+		{
+			MSUtilsDSP::FFadeEvent Event;
+			if (StartIndex >= NumStarts || (ResetIndex < NumResets && ResetTrigger[ResetIndex] <= StartTrigger[StartIndex]))
+			{
+				Event.Frame = ResetTrigger[ResetIndex++];
+				Event.Type = MSUtilsDSP::EFadeEventType::Reset;
+			}
+			else
+			{
+				Event.Frame = StartTrigger[StartIndex++];
+				Event.Type = MSUtilsDSP::EFadeEventType::Start;
+				Event.FadeSamples = FadeSamples;
+			}
+			OutEvents.Add(Event);
+		}
+	}
+
+	//Merges the Fade In/Out node's triggers for this block into frame ordered commands for MSUtilsDSP::FFadeEngine.
+	//Commands on the same frame are applied fade in, fade out, hold, so the last of those wins. Like GatherFadeEvents,
+	//callers hold OutCommands with inline capacity.
+	template<typename AllocatorType>
+	void GatherFadeCommands(const FTrigger& FadeInTrigger, const FTrigger& FadeOutTrigger, const FTrigger& HoldTrigger,
+		float FadeInSamples, float FadeOutSamples, TArray<MSUtilsDSP::FFadeCommand, AllocatorType>& OutCommands)
+	{
+		OutCommands.Reset();
+
+		for (int32 Index = 0; Index < FadeInTrigger.NumTriggeredInBlock(); ++Index)
+		{
+			OutCommands.Add({ FadeInTrigger[Index], MSUtilsDSP::EFadeCommandType::FadeIn, FadeInSamples });
+		}
+		for (int32 Index = 0; Index < FadeOutTrigger.NumTriggeredInBlock(); ++Index)
+		{
+			OutCommands.Add({ FadeOutTrigger[Index], MSUtilsDSP::EFadeCommandType::FadeOut, FadeOutSamples });
+		}
+		for (int32 Index = 0; Index < HoldTrigger.NumTriggeredInBlock(); ++Index)
+		{
+			OutCommands.Add({ HoldTrigger[Index], MSUtilsDSP::EFadeCommandType::Hold, 0.0f });
+		}
+
+		if (OutCommands.Num() > 1)
+		{
+			OutCommands.StableSort([](const MSUtilsDSP::FFadeCommand& A, const MSUtilsDSP::FFadeCommand& B)
+				{
+					return A.Frame < B.Frame;
+				});
+		}
+	}
+
+	//Publishes the envelope value and whether it is fading, for the telemetry view
+	inline void PublishFadeTelemetry(MSUtilsDSP::FTelemetryPublisher& Telemetry, const MSUtilsDSP::FFadeEnvelope& Envelope)
+	{
+		if (Telemetry.IsActive())
+		{
+			Telemetry.PublishGain(Envelope.GetValue());
+			Telemetry.PublishState(Envelope.IsFading() ? "Fading" : "Holding");
+		}
+	}
+
+	inline void PublishFadeTelemetry(MSUtilsDSP::FTelemetryPublisher& Telemetry, const MSUtilsDSP::FFadeEngine& Engine)
+	{
+		if (Telemetry.IsActive())
+		{
+			Telemetry.PublishGain(Engine.GetValue());
+			Telemetry.PublishState(MSUtilsDSP::GetFadeStateName(Engine.GetState()));
+		}
+	}
+}
@@ -0,0 +1,36 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MSUtilsDSP/NodeStats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("MS_Utils"), STATGROUP_MSUtils, STATCAT_Advanced);
+
+//Per node type profiling. MSUTILS_DECLARE_NODE_STATS(Id, "Name") goes once in the node's .cpp and declares
+//STAT_MSUtils<Id>, shown by "stat MSUtils", and MSUtilsNodeStats<Id>, the block counters au.MSUtils.Stats prints
+//and each operator's FNodeInstanceCounter counts into.
+#define MSUTILS_DECLARE_NODE_STATS(Id, Name) \
+	DECLARE_CYCLE_STAT(TEXT(Name), STAT_MSUtils##Id, STATGROUP_MSUtils); \
+	static MSUtilsDSP::FNodeStats MSUtilsNodeStats##Id(Name)
+
+#if MSUTILS_NODE_STATS
+
+//Goes at the top of an operator's execute function: an Unreal Insights scope, the cycle counter and the block timer
+#define MSUTILS_NODE_EXECUTE_SCOPE(Id) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(MSUtils##Id); \
+	SCOPE_CYCLE_COUNTER(STAT_MSUtils##Id); \
+	MSUtilsDSP::FScopedNodeBlockTimer MSUtilsNodeBlockTimer(MSUtilsNodeStats##Id)
+
+//Marks whether the block being timed took the node's fast path
+#define MSUTILS_NODE_FAST_PATH(bFastPath) MSUtilsNodeBlockTimer.SetFastPath(bFastPath)
+
+#else
+
+#define MSUTILS_NODE_EXECUTE_SCOPE(Id)
+#define MSUTILS_NODE_FAST_PATH(bFastPath)
+
+#endif
@@ -0,0 +1,38 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MetasoundVertex.h"
+
+namespace Metasound
+{
+	namespace MSUtilsVertexNames
+	{
+		//NumNames pin names, Format(Index) for each, formatted once. A node variant keeps its tables in a function
+		//local static, so creating and binding operators only looks the names up. The numbers in generated pin names
+		//start from 0.
+		template<int32 NumNames>
+		class TVertexNameArray
+		{
+		public:
+			template<typename FormatFuncType>
+			explicit TVertexNameArray(FormatFuncType Format)
+			{
+				for (int32 Index = 0; Index < NumNames; ++Index)
+				{
+					Names[Index] = Format(Index);
+				}
+			}
+
+			const FVertexName& operator[](int32 Index) const
+			{
+				return Names[Index];
+			}
+
+		private:
+			FVertexName Names[NumNames];
+		};
+	}
+}
@@ -1,20 +1,227 @@
 // Copyright Dale Grinsell 2024. All Rights Reserved. 
 
 #include "MS_Utils.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
 #include "MetasoundNodeRegistrationMacro.h"
+#include "Misc/EngineVersionComparison.h"
+
+// The MetaSound operator cache, and UMetaSoundCacheSubsystem::PrecacheMetaSound with it, arrived in 5.4
+#define MSUTILS_WITH_OPERATOR_CACHE !UE_VERSION_OLDER_THAN(5, 4, 0)
+
+#if MSUTILS_WITH_OPERATOR_CACHE
+#include "AudioDevice.h"
+#include "MetasoundOperatorCacheSubsystem.h"
+#include "MetasoundSource.h"
+#endif
+#include "MSUtilsDSP/Denormals.h"
+#include "MSUtilsDSP/GainKernelDispatch.h"
+#include "MSUtilsDSP/NodeStats.h"
+#include "MSUtilsDSP/Telemetry.h"
 
 #define LOCTEXT_NAMESPACE "FMS_UtilsModule"
 
+static float MSUtilsSilenceThresholdCVar = MSUtilsDSP::DefaultSilenceThreshold;
+FAutoConsoleVariableRef CVarMSUtilsSilenceThreshold(
+	TEXT("au.MSUtils.SilenceThreshold"),
+	MSUtilsSilenceThresholdCVar,
+	TEXT("Linear gain below which the MS_Utils fades and crossfades snap to silence and report it (default 1e-6, about -120 dB). 0 disables snapping."),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*) { MSUtilsDSP::SetSilenceThreshold(MSUtilsSilenceThresholdCVar); }),
+	ECVF_Default);
+
+static int32 MSUtilsFlushDenormalsCVar = 1;
+FAutoConsoleVariableRef CVarMSUtilsFlushDenormals(
+	TEXT("au.MSUtils.FlushDenormals"),
+	MSUtilsFlushDenormalsCVar,
+	TEXT("1: MS_Utils operators flush denormals to zero while they render (default). 0: leave the floating point mode alone."),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*) { MSUtilsDSP::SetDenormalFlushEnabled(MSUtilsFlushDenormalsCVar != 0); }),
+	ECVF_Default);
+
+static int32 MSUtilsTelemetryCVar = 0;
+FAutoConsoleVariableRef CVarMSUtilsTelemetry(
+	TEXT("au.MSUtils.Telemetry"),
+	MSUtilsTelemetryCVar,
+	TEXT("1: MS_Utils operators created from now on publish their gains, envelope values and state changes, shown on screen per node. 0: off (default)."),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*) { MSUtilsDSP::SetTelemetryEnabled(MSUtilsTelemetryCVar != 0); }),
+	ECVF_Default);
+
+#if MSUTILS_TELEMETRY
+// Shows the latest values each operator published, one line per operator and event type. The render threads
+// only ever push into their own lock-free rings; this runs on the game thread and is the only reader.
+static bool TickTelemetry(float DeltaTime)
+{
+	MSUtilsDSP::DrainTelemetry([](const MSUtilsDSP::FTelemetryChannel& Channel, const MSUtilsDSP::FTelemetryEvent& Event)
+		{
+			if (!GEngine)
+			{
+				return;
+			}
+
+			FString Message;
+			FColor Color = FColor::Cyan;
+			switch (Event.Type)
+			{
+			case MSUtilsDSP::ETelemetryEventType::Crossfade:
+				Message = FString::Printf(TEXT("%s #%u: value %.3f, In %d %.3f, In %d %.3f (alpha %.3f)"), ANSI_TO_TCHAR(Channel.GetNodeName()), Channel.GetId(),
+					Event.Value, Event.IndexA, Event.GainA, Event.IndexB, Event.GainB, Event.Alpha);
+				break;
+
+			case MSUtilsDSP::ETelemetryEventType::Gain:
+				Message = FString::Printf(TEXT("%s #%u: gain %.3f"), ANSI_TO_TCHAR(Channel.GetNodeName()), Channel.GetId(), Event.Value);
+				break;
+
+			default:
+				Message = FString::Printf(TEXT("%s #%u: %s"), ANSI_TO_TCHAR(Channel.GetNodeName()), Channel.GetId(), ANSI_TO_TCHAR(Event.State));
+				Color = FColor::Yellow;
+				break;
+			}
+
+			if (Channel.GetNumDropped() > 0)
+			{
+				Message += FString::Printf(TEXT(" [%llu dropped]"), (unsigned long long)Channel.GetNumDropped());
+			}
+
+			// Keys well clear of the small ones game code tends to use, so each line is replaced rather than stacked
+			const uint64 Key = 0x4D53550000000000ull | ((uint64)Channel.GetId() << 8) | (uint64)Event.Type;
+			GEngine->AddOnScreenDebugMessage(Key, 2.0f, Color, Message);
+		});
+
+	return true;
+}
+#endif
+
+// Prints the counters of every node type, or clears them with "reset"
+static void DumpNodeStats(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+	{
+		MSUtilsDSP::ResetNodeStats();
+		Ar.Log(TEXT("MS_Utils node stats reset"));
+		return;
+	}
+
+#if !MSUTILS_NODE_STATS
+	Ar.Log(TEXT("MS_Utils node stats are compiled out of this build"));
+#endif
+
+	TArray<MSUtilsDSP::FNodeStatsSnapshot> Snapshots;
+	MSUtilsDSP::ForEachNodeStats([&Snapshots](const MSUtilsDSP::FNodeStats& Stats)
+		{
+			Snapshots.Add(Stats.GetSnapshot());
+		});
+	Snapshots.Sort([](const MSUtilsDSP::FNodeStatsSnapshot& A, const MSUtilsDSP::FNodeStatsSnapshot& B)
+		{
+			return FCStringAnsi::Strcmp(A.Name, B.Name) < 0;
+		});
+
+	Ar.Logf(TEXT("%-28s %6s %12s %12s %12s %10s %10s"), TEXT("Node"), TEXT("Live"), TEXT("Blocks"), TEXT("Fast path"), TEXT("Slow path"), TEXT("Avg ns"), TEXT("Peak ns"));
+	for (const MSUtilsDSP::FNodeStatsSnapshot& Snapshot : Snapshots)
+	{
+		Ar.Logf(TEXT("%-28s %6lld %12llu %12llu %12llu %10.0f %10llu"), ANSI_TO_TCHAR(Snapshot.Name), (long long)Snapshot.LiveInstances,
+			(unsigned long long)Snapshot.GetNumBlocks(), (unsigned long long)Snapshot.FastPathBlocks, (unsigned long long)Snapshot.SlowPathBlocks,
+			Snapshot.GetAverageNanoseconds(), (unsigned long long)Snapshot.PeakNanoseconds);
+	}
+}
+
+bool FMS_UtilsModule::PrewarmMetaSound(UMetaSoundSource* MetaSound, int32 NumInstances)
+{
+#if MSUTILS_WITH_OPERATOR_CACHE
+	if (!MetaSound || NumInstances <= 0 || !GEngine)
+	{
+		return false;
+	}
+
+	FAudioDeviceHandle AudioDevice = GEngine->GetMainAudioDevice();
+	UMetaSoundCacheSubsystem* CacheSubsystem = AudioDevice ? AudioDevice->GetSubsystem<UMetaSoundCacheSubsystem>() : nullptr;
+	if (!CacheSubsystem)
+	{
+		return false;
+	}
+
+	CacheSubsystem->PrecacheMetaSound(MetaSound, NumInstances);
+	return true;
+#else
+	return false;
+#endif
+}
+
+#if MSUTILS_WITH_OPERATOR_CACHE
+
+// Loads the MetaSound Source at the given path and builds instances of its graph into the operator cache
+static void PrewarmMetaSoundCommand(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	if (Args.Num() < 1)
+	{
+		Ar.Log(TEXT("Usage: au.MSUtils.Prewarm <MetaSoundSourcePath> [NumInstances]"));
+		return;
+	}
+
+	const int32 NumInstances = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1;
+	UMetaSoundSource* MetaSound = LoadObject<UMetaSoundSource>(nullptr, *Args[0]);
+	if (!MetaSound)
+	{
+		Ar.Logf(TEXT("No MetaSound Source found at %s"), *Args[0]);
+		return;
+	}
+
+	if (FMS_UtilsModule::PrewarmMetaSound(MetaSound, NumInstances))
+	{
+		Ar.Logf(TEXT("Prewarmed %d instance(s) of %s"), NumInstances, *MetaSound->GetPathName());
+	}
+	else
+	{
+		Ar.Log(TEXT("Could not prewarm: no audio device with a MetaSound operator cache, or NumInstances is not positive"));
+	}
+}
+#endif
+
 void FMS_UtilsModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	// Pick the widest gain kernels this CPU supports before any node can render
+	MSUtilsDSP::InitSimdKernels();
 	FMetasoundFrontendRegistryContainer::Get()->RegisterPendingNodes();
+
+	NodeStatsCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("au.MSUtils.Stats"),
+		TEXT("Prints live instances, blocks processed, fast and slow path blocks, and average and peak ns per block for each MS_Utils node type. \"au.MSUtils.Stats reset\" clears the counters."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&DumpNodeStats),
+		ECVF_Default);
+
+#if MSUTILS_WITH_OPERATOR_CACHE
+	PrewarmCommand = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("au.MSUtils.Prewarm"),
+		TEXT("Builds NumInstances (default 1) of a MetaSound Source's graph into the operator cache, so they start without constructing operators. \"au.MSUtils.Prewarm <MetaSoundSourcePath> [NumInstances]\""),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&PrewarmMetaSoundCommand),
+		ECVF_Default);
+#endif
+
+#if MSUTILS_TELEMETRY
+	TelemetryTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickTelemetry));
+#endif
 }
 
 void FMS_UtilsModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	if (NodeStatsCommand)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(NodeStatsCommand);
+		NodeStatsCommand = nullptr;
+	}
+
+	if (PrewarmCommand)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(PrewarmCommand);
+		PrewarmCommand = nullptr;
+	}
+
+	if (TelemetryTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TelemetryTickerHandle);
+		TelemetryTickerHandle.Reset();
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -3,6 +3,8 @@
 #include "SimpleFadeIn.h"
 
 #include "MetasoundStandardNodesCategories.h"
+#include "MSUtilsFadeEvents.h"
+#include "MSUtilsProfiling.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_SimpleFadeIn"
 
@@ -19,10 +21,13 @@ namespace Metasound
 
 		//Outputs
 		METASOUND_PARAM(OutEnvParam, "Envelope Out", "Fade value output");
+		METASOUND_PARAM(OutEnvAudioParam, "Envelope Audio Out", "Fade value output at audio rate, ramped per sample so it can be multiplied with audio directly");
 		METASOUND_PARAM(OutTriggerStartIn, "On Fade In Start", "Triggers when the fade in starts");
 		METASOUND_PARAM(OutTriggerFinished, "On Fade In Finished", "Triggers when the fade in finishes");
 	}
 
+	MSUTILS_DECLARE_NODE_STATS(SimpleFadeIn, "Simple Fade In");
+
 	FSimpleFIOperator::FSimpleFIOperator(const FCreateOperatorParams& InSettings,
 		const FTimeReadRef& FadeInTimeIn,
 		const FTriggerReadRef& InTriggerEnter,
@@ -32,55 +37,56 @@ namespace Metasound
 		ResetFadeIn(InTriggerReset),
 		TriggerStartIn(TDataWriteReferenceFactory<FTrigger>::CreateExplicitArgs(InSettings.OperatorSettings)),
 		TriggerFinished(TDataWriteReferenceFactory<FTrigger>::CreateExplicitArgs(InSettings.OperatorSettings)),
-		OutEnvelope(FFloatWriteRef::CreateNew(0.0f))
+		OutEnvelope(FFloatWriteRef::CreateNew(0.0f)),
+		OutEnvelopeAudio(FAudioBufferWriteRef::CreateNew(InSettings.OperatorSettings)),
+		Envelope(MSUtilsDSP::EFadeDirection::In),
+		NumFramesPerBlock(InSettings.OperatorSettings.GetNumFramesPerBlock()),
+		InstanceCounter(MSUtilsNodeStatsSimpleFadeIn),
+		Telemetry(MSUtilsNodeStatsSimpleFadeIn.GetName())
 	{
-		//SampleRate = InSettings.OperatorSettings.GetSampleRate();
-		BlockRate = InSettings.OperatorSettings.GetActualBlockRate();
+		SampleRate = InSettings.OperatorSettings.GetSampleRate();
 	};
 
+	void FSimpleFIOperator::Reset(const IOperator::FResetParams& InParams)
+	{
+		SampleRate = InParams.OperatorSettings.GetSampleRate();
+		Envelope.Reset();
+		FadeEvents.Reset();
+		TriggerStartIn->Reset();
+		TriggerFinished->Reset();
+		*OutEnvelope = 0.0f;
+		OutEnvelopeAudio->Zero();
+	}
+
 	void FSimpleFIOperator::Execute()
 	{
+		MSUTILS_NODE_EXECUTE_SCOPE(SimpleFadeIn);
+
 		//AdvanceBlock() moves the trigger forward along with the block. It only triggers when TriggerFrame() is called.
 		TriggerStartIn->AdvanceBlock();
 		TriggerFinished->AdvanceBlock();
 
-		ResetFadeIn->ExecuteBlock([this](int32 StartFrame, int32 EndFrame)
+		//Triggers and resets take effect on the exact frame they land on, and the finished trigger fires on the frame the fade ends.
+		GatherFadeEvents(*TriggerFadeIn, *ResetFadeIn, SampleRate * FadeInTime->GetSeconds(), FadeEvents);
+		for (const MSUtilsDSP::FFadeEvent& Event : FadeEvents)
+		{
+			if (Event.Type == MSUtilsDSP::EFadeEventType::Start)
 			{
+				TriggerStartIn->TriggerFrame(Event.Frame);
+			}
+		}
 
-			},
-			[this](int32 StartFrame, int32 EndFrame)
-			{
-				ProcessFade = false;
-				OutEnvelopeValue = 0.0f;
-				*OutEnvelope = OutEnvelopeValue;
-				FadeCounter = 1.0f;
-			});
+		// A block with nothing to do is a constant fill
+		MSUTILS_NODE_FAST_PATH(FadeEvents.Num() == 0 && !Envelope.IsFading());
 
-		TriggerFadeIn->ExecuteBlock(
-			[this](int32 StartFrame, int32 EndFrame)
-			{
-				if (ProcessFade == true)
-				{
-					
-					OutEnvelopeValue = FMath::Clamp(FadeCounter / FadeBlockCount, 0.0f, 1.0f);
-					*OutEnvelope = OutEnvelopeValue;
-					FadeCounter += 1.0f;
-					if(FadeCounter - 1.0f >= FadeBlockCount)
-					{
-						FadeCounter = 1.0f;
-						TriggerFinished->TriggerFrame(EndFrame);
-						ProcessFade = false;
-					}
-				}
-			},
-			[this](int32 StartFrame, int32 EndFrame)
+		Envelope.RenderBlock(OutEnvelopeAudio->GetData(), NumFramesPerBlock, FadeEvents.GetData(), FadeEvents.Num(),
+			[this](int32 FinishedFrame)
 			{
-				TriggerStartIn->TriggerFrame(StartFrame);
-				ProcessFade = true;
-				FadeBlockCount = BlockRate * FadeInTime->GetSeconds();
-			}
-		);
+				TriggerFinished->TriggerFrame(FinishedFrame);
+			});
 
+		*OutEnvelope = Envelope.GetValue();
+		PublishFadeTelemetry(Telemetry, Envelope);
 	}
 
 	const FVertexInterface& FSimpleFIOperator::DeclareVertexInterface()
@@ -96,7 +102,8 @@ namespace Metasound
 			FOutputVertexInterface(
 				TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutTriggerStartIn)),
 				TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutTriggerFinished)),
-				TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutEnvParam))
+				TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutEnvParam)),
+				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutEnvAudioParam))
 			)
 		);
 
@@ -113,7 +120,7 @@ namespace Metasound
 				{
 						{ TEXT("UE"), TEXT("SimpleFadeIn"), TEXT("Audio") },
 						1, // Major Version
-						0, // Minor Version
+						1, // Minor Version
 						METASOUND_LOCTEXT("SimpleFadeInDisplayName", "Simple Fade In"),
 						METASOUND_LOCTEXT("SimpleFadeInNodeDesc", "Fades a float value from 0 to 1 over a given time"),
 						PluginAuthor,
@@ -145,6 +152,7 @@ namespace Metasound
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutTriggerStartIn), TriggerStartIn);
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutTriggerFinished), TriggerFinished);
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutEnvParam), OutEnvelope);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutEnvAudioParam), OutEnvelopeAudio);
 	}
 
 	TUniquePtr<IOperator> FSimpleFIOperator::CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
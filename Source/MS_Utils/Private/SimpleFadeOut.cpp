@@ -3,6 +3,8 @@
 #include "SimpleFadeOut.h"
 
 #include "MetasoundStandardNodesCategories.h"
+#include "MSUtilsFadeEvents.h"
+#include "MSUtilsProfiling.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_SimpleFadeOut"
 
@@ -19,10 +21,14 @@ namespace Metasound
 
 		//Outputs
 		METASOUND_PARAM(OutEnvParam, "Envelope Out", "Fade value output");
+		METASOUND_PARAM(OutEnvAudioParam, "Envelope Audio Out", "Fade value output at audio rate, ramped per sample so it can be multiplied with audio directly");
 		METASOUND_PARAM(OutTriggerStartOut, "On Fade Out Start", "Triggers when the fade out starts");
 		METASOUND_PARAM(OutTriggerFinished, "On Fade Out Finished", "Triggers when the fade out finishes");
+		METASOUND_PARAM(OutSilentParam, "Is Silent", "True while the envelope rests at 0, so anything it scales is silent and downstream processing can be skipped");
 	}
 
+	MSUTILS_DECLARE_NODE_STATS(SimpleFadeOut, "Simple Fade Out");
+
 	FSimpleFOOperator::FSimpleFOOperator(const FCreateOperatorParams& InSettings,
 		const FTimeReadRef& FadeOutTimeIn,
 		const FTriggerReadRef& InTriggerEnter,
@@ -32,55 +38,59 @@ namespace Metasound
 		ResetFadeOut(InTriggerReset),
 		TriggerStartOut(TDataWriteReferenceFactory<FTrigger>::CreateExplicitArgs(InSettings.OperatorSettings)),
 		TriggerFinished(TDataWriteReferenceFactory<FTrigger>::CreateExplicitArgs(InSettings.OperatorSettings)),
-		OutEnvelope(FFloatWriteRef::CreateNew(1.0f))
+		OutEnvelope(FFloatWriteRef::CreateNew(1.0f)),
+		OutEnvelopeAudio(FAudioBufferWriteRef::CreateNew(InSettings.OperatorSettings)),
+		OutSilent(FBoolWriteRef::CreateNew(false)),
+		Envelope(MSUtilsDSP::EFadeDirection::Out),
+		NumFramesPerBlock(InSettings.OperatorSettings.GetNumFramesPerBlock()),
+		InstanceCounter(MSUtilsNodeStatsSimpleFadeOut),
+		Telemetry(MSUtilsNodeStatsSimpleFadeOut.GetName())
 	{
-		//SampleRate = InSettings.OperatorSettings.GetSampleRate();
-		BlockRate = InSettings.OperatorSettings.GetActualBlockRate();
+		SampleRate = InSettings.OperatorSettings.GetSampleRate();
 	};
 
+	void FSimpleFOOperator::Reset(const IOperator::FResetParams& InParams)
+	{
+		SampleRate = InParams.OperatorSettings.GetSampleRate();
+		Envelope.Reset();
+		FadeEvents.Reset();
+		TriggerStartOut->Reset();
+		TriggerFinished->Reset();
+		*OutEnvelope = 1.0f;
+		OutEnvelopeAudio->Zero();
+		*OutSilent = false;
+	}
+
 	void FSimpleFOOperator::Execute()
 	{
+		MSUTILS_NODE_EXECUTE_SCOPE(SimpleFadeOut);
+
 		//AdvanceBlock() moves the trigger forward along with the block. It only triggers when TriggerFrame() is called.
 		TriggerStartOut->AdvanceBlock();
 		TriggerFinished->AdvanceBlock();
 
-		ResetFadeOut->ExecuteBlock([this](int32 StartFrame, int32 EndFrame)
+		//Triggers and resets take effect on the exact frame they land on, and the finished trigger fires on the frame the fade ends.
+		GatherFadeEvents(*TriggerFadeOut, *ResetFadeOut, SampleRate * FadeOutTime->GetSeconds(), FadeEvents);
+		for (const MSUtilsDSP::FFadeEvent& Event : FadeEvents)
+		{
+			if (Event.Type == MSUtilsDSP::EFadeEventType::Start)
 			{
+				TriggerStartOut->TriggerFrame(Event.Frame);
+			}
+		}
 
-			},
-			[this](int32 StartFrame, int32 EndFrame)
-			{
-				ProcessFade = false;
-				OutEnvelopeValue = 1.0f;
-				*OutEnvelope = OutEnvelopeValue;
-				FadeCounter = 1.0f;
-			});
+		// A block with nothing to do is a constant fill
+		MSUTILS_NODE_FAST_PATH(FadeEvents.Num() == 0 && !Envelope.IsFading());
 
-		TriggerFadeOut->ExecuteBlock(
-			[this](int32 StartFrame, int32 EndFrame)
-			{
-				if (ProcessFade == true)
-				{
-					
-					OutEnvelopeValue = FMath::Clamp(1.0f - (FadeCounter / FadeBlockCount), 0.0f, 1.0f);
-					*OutEnvelope = OutEnvelopeValue;
-					FadeCounter += 1.0f;
-					if(FadeCounter - 1.0f >= FadeBlockCount)
-					{
-						FadeCounter = 1.0f;
-						TriggerFinished->TriggerFrame(EndFrame);
-						ProcessFade = false;
-					}
-				}
-			},
-			[this](int32 StartFrame, int32 EndFrame)
+		Envelope.RenderBlock(OutEnvelopeAudio->GetData(), NumFramesPerBlock, FadeEvents.GetData(), FadeEvents.Num(),
+			[this](int32 FinishedFrame)
 			{
-				TriggerStartOut->TriggerFrame(StartFrame);
-				ProcessFade = true;
-				FadeBlockCount = BlockRate * FadeOutTime->GetSeconds();
-			}
-		);
+				TriggerFinished->TriggerFrame(FinishedFrame);
+			});
 
+		*OutEnvelope = Envelope.GetValue();
+		PublishFadeTelemetry(Telemetry, Envelope);
+		*OutSilent = Envelope.IsSilent();
 	}
 
 	const FVertexInterface& FSimpleFOOperator::DeclareVertexInterface()
@@ -96,7 +106,9 @@ namespace Metasound
 			FOutputVertexInterface(
 				TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutTriggerStartOut)),
 				TOutputDataVertex<FTrigger>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutTriggerFinished)),
-				TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutEnvParam))
+				TOutputDataVertex<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutEnvParam)),
+				TOutputDataVertex<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutEnvAudioParam)),
+				TOutputDataVertex<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutSilentParam))
 			)
 		);
 
@@ -113,7 +125,7 @@ namespace Metasound
 				{
 						{ TEXT("UE"), TEXT("SimpleFadeOut"), TEXT("Audio") },
 						1, // Major Version
-						0, // Minor Version
+						2, // Minor Version
 						METASOUND_LOCTEXT("SimpleFadeOutDisplayName", "Simple Fade Out"),
 						METASOUND_LOCTEXT("SimpleFadeOutNodeDesc", "Fades a float value from 1 to 0 over a given time"),
 						PluginAuthor,
@@ -145,6 +157,8 @@ namespace Metasound
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutTriggerStartOut), TriggerStartOut);
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutTriggerFinished), TriggerFinished);
 		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutEnvParam), OutEnvelope);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutEnvAudioParam), OutEnvelopeAudio);
+		InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutSilentParam), OutSilent);
 	}
 
 	TUniquePtr<IOperator> FSimpleFOOperator::CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
@@ -12,6 +12,9 @@
 #include "MetasoundStandardNodesNames.h" 
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h" 
+#include "MSUtilsDSP/MappedRangeGain.h"
+#include "MSUtilsDSP/NodeStats.h"
+#include "MSUtilsDSP/Telemetry.h"
 
 
 //------------------------------------------------------------------------------------
@@ -29,7 +32,8 @@ namespace Metasound
 			const FFloatReadRef& FadeInEndIn,
 			const FFloatReadRef& FadeOutStartIn,
 			const FFloatReadRef& FadeOutEndIn,
-			const FFloatReadRef& ValueIn);
+			const FFloatReadRef& ValueIn,
+			bool bConstantZone = false);
 
 		//UFUNCTION()
 		//static functions exist across the class and not instances. They cannot access member instance variables or non-static members
@@ -46,10 +50,20 @@ namespace Metasound
 		// Used to instantiate a new runtime instance of your node
 		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors);
 
+		// Puts the operator back as it was constructed, so a cached graph can be reused for a new sound
+		void Reset(const IOperator::FResetParams& InParams);
+
 		//UFUNCTION()
 		void Execute();
 
+		// Picks the fixed gain path when the input value and zone are constant. It still runs when they keep it muted,
+		// so a later BindInputs that connects one of them can hand the block back to Execute.
+		virtual FExecuteFunction GetExecuteFunction() override;
+
 	private:
+		static void ExecuteFixedFunction(IOperator* InOperator);
+		void ExecuteFixed();
+
 
 		FFloatReadRef FloatIn;
 		FFloatReadRef FadeInStart;
@@ -58,13 +72,14 @@ namespace Metasound
 		FFloatReadRef FadeOutEnd;
 		FAudioBufferReadRef AudioInput;
 		FAudioBufferWriteRef AudioOutput;
+		FBoolWriteRef OutMuted;
 		int32 NumFramesPerBlock = 0;
-		float SignalOnePreviousGain = 0.f;
-		float SignalTwoPreviousGain = 0.f;
-		float FloatInPrev = 0.0f;
-		float Amplitude = 0.0f;
-		float AmplitudePrev = 0.0f;
-		bool bInit = false;
+		MSUtilsDSP::FMappedRangeFader Fader;
+		// Set when every zone input is constant, and cleared if BindInputs connects one
+		TOptional<MSUtilsDSP::FFixedZoneFader> FixedFader;
+		bool bFixedTelemetryPublished = false;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+		MSUtilsDSP::FTelemetryPublisher Telemetry;
 	};
 
 	//------------------------------------------------------------------------------------
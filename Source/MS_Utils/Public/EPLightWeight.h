@@ -12,6 +12,10 @@
 #include "MetasoundStandardNodesNames.h" 
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h" 
+#include "MSUtilsDSP/EqualPowerCrossfader.h"
+#include "MSUtilsDSP/NodeStats.h"
+#include "MSUtilsDSP/Telemetry.h"
+#include "MSUtilsEnums.h"
 
 
 //------------------------------------------------------------------------------------
@@ -26,7 +30,9 @@ namespace Metasound
 		FEPXFOperator(const FOperatorSettings& InSettings, 
 			const FAudioBufferReadRef& InAudio, 
 			const FAudioBufferReadRef& InAudio2, 
-			const FFloatReadRef& ValueIn);
+			const FFloatReadRef& ValueIn,
+			const FEnumGainAccuracyReadRef& GainAccuracyIn,
+			const FEnumCrossfadeCurveReadRef& CurveIn);
 
 		//UFUNCTION()
 		//static functions exist across the class and not instances. They cannot access member instance variables or non-static members
@@ -43,24 +49,26 @@ namespace Metasound
 		// Used to instantiate a new runtime instance of your node
 		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors);
 
-		//UFUNCTION()
-		void Execute();
+		// Puts the operator back as it was constructed, so a cached graph can be reused for a new sound
+		void Reset(const IOperator::FResetParams& InParams);
 
 		//UFUNCTION()
-		void MixInInput(FAudioBufferReadRef& InBuffer, TArrayView<float>& OutBufferView, float PrevGain, float NewGain);
+		void Execute();
 
 	private:
 
 		FFloatReadRef FloatIn;
+		FEnumGainAccuracyReadRef GainAccuracy;
+		FEnumCrossfadeCurveReadRef Curve;
 		FAudioBufferReadRef AudioInput;
 		FAudioBufferReadRef AudioInput2;
 		FAudioBufferWriteRef AudioOutput;
+		FBoolWriteRef OutActive;
+		FBoolWriteRef OutActive2;
 		int32 NumFramesPerBlock = 0;
-		float SignalOnePreviousGain = 0.f;
-		float SignalTwoPreviousGain = 0.f;
-		float FloatInPrev = 1.1f;
-		float SignalOneFloat;
-		float SignalTwoFloat;
+		MSUtilsDSP::FEqualPowerCrossfadePair Crossfader;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+		MSUtilsDSP::FTelemetryPublisher Telemetry;
 	};
 
 	//------------------------------------------------------------------------------------
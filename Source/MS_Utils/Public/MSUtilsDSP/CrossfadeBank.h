@@ -0,0 +1,139 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/CrossfadeCurve.h"
+#include "MSUtilsDSP/DSPCommon.h"
+#include "MSUtilsDSP/EqualPowerGain.h"
+#include "MSUtilsDSP/GainKernels.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace MSUtilsDSP
+{
+	// A bank of independent two input equal power crossfades, each giving the same output as its own
+	// FEqualPowerCrossfadePair. Per voice state is kept as structure of arrays, so the gain update for every voice is
+	// one loop over contiguous floats that the compiler vectorizes, rather than a branch and two cosines per voice.
+	class FEqualPowerCrossfadeBank
+	{
+	public:
+		explicit FEqualPowerCrossfadeBank(int32 InNumVoices)
+			: NumVoices(InNumVoices)
+			, CrossfadeValues(InNumVoices, 0.0f)
+			, PrevCrossfadeValues(InNumVoices, 1.1f)
+			, PrevGainsA(InNumVoices, 0.0f)
+			, PrevGainsB(InNumVoices, 0.0f)
+			, GainsA(InNumVoices, 0.0f)
+			, GainsB(InNumVoices, 0.0f)
+			, InputActive(2 * InNumVoices, 0)
+		{
+		}
+
+		int32 GetNumVoices() const
+		{
+			return NumVoices;
+		}
+
+		// Curve shared by every voice
+		void SetCurve(ECrossfadeCurve InCurve)
+		{
+			Curve = InCurve;
+		}
+
+		// Back to the state it was constructed in, so the next block calculates every voice's gains and ramps up from
+		// silence. Keeps the curve and does not allocate.
+		void Reset()
+		{
+			std::fill(PrevCrossfadeValues.begin(), PrevCrossfadeValues.end(), 1.1f);
+			std::fill(PrevGainsA.begin(), PrevGainsA.end(), 0.0f);
+			std::fill(PrevGainsB.begin(), PrevGainsB.end(), 0.0f);
+			std::fill(GainsA.begin(), GainsA.end(), 0.0f);
+			std::fill(GainsB.begin(), GainsB.end(), 0.0f);
+			std::fill(InputActive.begin(), InputActive.end(), (uint8)0);
+			PrevAccuracy = EGainAccuracy::Exact;
+			PrevCurve = ECrossfadeCurve::EqualPower;
+			bSettled = false;
+		}
+
+		// Runs one block of every voice. CrossfadeValues holds one value per voice, the buffers one per voice.
+		void Process(const float* InCrossfadeValues, EGainAccuracy Accuracy, const float* const* InBuffersA, const float* const* InBuffersB, float* const* OutBuffers, int32 NumFrames)
+		{
+			// Non-finite values are treated as 0, as FEqualPowerCrossfadePair does, so NaN cannot keep the bank from settling
+			std::transform(InCrossfadeValues, InCrossfadeValues + NumVoices, CrossfadeValues.begin(), FiniteOrZero);
+
+			// One comparison over the whole bank, so a bank whose values all hold still skips the gain update entirely
+			const bool bValuesChanged = Accuracy != PrevAccuracy || Curve != PrevCurve || CrossfadeValues != PrevCrossfadeValues;
+			bSettled = !bValuesChanged;
+			if (!bValuesChanged)
+			{
+				for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+				{
+					MixPairRamp(InBuffersA[Voice], InBuffersB[Voice], OutBuffers[Voice], NumFrames, PrevGainsA[Voice], PrevGainsA[Voice], PrevGainsB[Voice], PrevGainsB[Voice]);
+				}
+				for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+				{
+					InputActive[2 * Voice] = PrevGainsA[Voice] != 0.0f;
+					InputActive[2 * Voice + 1] = PrevGainsB[Voice] != 0.0f;
+				}
+				return;
+			}
+
+			// Every voice's target gains in one pass. Recomputing the voices that did not move is cheaper than branching on them.
+			ComputeCrossfadeGains(CrossfadeValues.data(), GainsA.data(), GainsB.data(), NumVoices, Curve, Accuracy);
+
+			for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				MixPairRamp(InBuffersA[Voice], InBuffersB[Voice], OutBuffers[Voice], NumFrames, PrevGainsA[Voice], GainsA[Voice], PrevGainsB[Voice], GainsB[Voice]);
+			}
+
+			for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+			{
+				InputActive[2 * Voice] = PrevGainsA[Voice] != 0.0f || GainsA[Voice] != 0.0f;
+				InputActive[2 * Voice + 1] = PrevGainsB[Voice] != 0.0f || GainsB[Voice] != 0.0f;
+			}
+
+			// The targets are fully rewritten next block, so latching is a swap
+			std::swap(PrevGainsA, GainsA);
+			std::swap(PrevGainsB, GainsB);
+			std::swap(PrevCrossfadeValues, CrossfadeValues);
+			PrevAccuracy = Accuracy;
+			PrevCurve = Curve;
+		}
+
+		// Gains the voice reached at the end of the last block
+		FEqualPowerGains GetGains(int32 Voice) const
+		{
+			return { PrevGainsA[Voice], PrevGainsB[Voice] };
+		}
+
+		// True if the last block kept every voice's gains because nothing had changed since the block before
+		bool IsSettled() const
+		{
+			return bSettled;
+		}
+
+		// True if input A (0) or B (1) of the voice was audible at any point in the last block
+		bool IsInputActive(int32 Voice, int32 InputIndex) const
+		{
+			return InputActive[2 * Voice + InputIndex] != 0;
+		}
+
+	private:
+		int32 NumVoices = 0;
+		// This block's values, made finite
+		std::vector<float> CrossfadeValues;
+		// Out of range so the first block always calculates the gains
+		std::vector<float> PrevCrossfadeValues;
+		EGainAccuracy PrevAccuracy = EGainAccuracy::Exact;
+		ECrossfadeCurve Curve = ECrossfadeCurve::EqualPower;
+		ECrossfadeCurve PrevCurve = ECrossfadeCurve::EqualPower;
+		std::vector<float> PrevGainsA;
+		std::vector<float> PrevGainsB;
+		std::vector<float> GainsA;
+		std::vector<float> GainsB;
+		std::vector<uint8> InputActive;
+		bool bSettled = false;
+	};
+}
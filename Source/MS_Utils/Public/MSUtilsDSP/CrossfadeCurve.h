@@ -0,0 +1,154 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+#include "MSUtilsDSP/EqualPowerGain.h"
+
+#include <algorithm>
+#include <cmath>
+
+MSUTILS_FP_CONTRACT_OFF_BEGIN
+
+namespace MSUtilsDSP
+{
+	enum class ECrossfadeCurve : int32
+	{
+		// cos / sin, constant power. The curve the nodes have always used.
+		EqualPower = 0,
+		// Straight line, constant amplitude (equal gain)
+		Linear,
+		// Smoothstep, constant amplitude with no slope at either end
+		SCurve,
+		// Square root, constant power
+		Sqrt,
+		// -3 dB at the midpoint. The cos / sin law, so the same gains as EqualPower.
+		PanLaw3dB,
+		// -4.5 dB at the midpoint, halfway between constant power and constant amplitude: cos^1.5
+		PanLaw4p5dB,
+		// -6 dB at the midpoint, constant amplitude: cos^2
+		PanLaw6dB
+	};
+
+	// Gain of an input Distance in [0, 1] away from the crossfade position: 1 on the input, falling to 0 one step away.
+	// Each curve and accuracy is its own type so a loop over Gain() compiles to straight line code for that curve.
+	template<ECrossfadeCurve Curve, EGainAccuracy Accuracy>
+	struct TCrossfadeCurveKernel
+	{
+		static float Gain(float Distance)
+		{
+			if constexpr (Curve == ECrossfadeCurve::Linear)
+			{
+				return 1.0f - Distance;
+			}
+			else if constexpr (Curve == ECrossfadeCurve::SCurve)
+			{
+				return 1.0f - Distance * Distance * (3.0f - 2.0f * Distance);
+			}
+			else if constexpr (Curve == ECrossfadeCurve::Sqrt)
+			{
+				return std::sqrt(1.0f - Distance);
+			}
+			else
+			{
+				// std::cos(HalfPi) is very slightly negative, so clamp before taking powers of it
+				const float Cos = Clamp(Accuracy == EGainAccuracy::Fast ? FastQuarterCos(Distance) : std::cos(Distance * HalfPi), 0.0f, 1.0f);
+				if constexpr (Curve == ECrossfadeCurve::PanLaw4p5dB)
+				{
+					return Cos * std::sqrt(Cos);
+				}
+				else if constexpr (Curve == ECrossfadeCurve::PanLaw6dB)
+				{
+					return Cos * Cos;
+				}
+				else
+				{
+					return Cos;
+				}
+			}
+		}
+	};
+
+	// Calls Func with the TCrossfadeCurveKernel for Curve and Accuracy. The switch runs once per call, outside any
+	// loop in Func. Accuracy only selects a kernel for the cosine based curves; the others are exact either way.
+	template<typename FuncType>
+	decltype(auto) DispatchCrossfadeCurve(ECrossfadeCurve Curve, EGainAccuracy Accuracy, FuncType&& Func)
+	{
+		const bool bFast = Accuracy == EGainAccuracy::Fast;
+		switch (Curve)
+		{
+		case ECrossfadeCurve::Linear:
+			return Func(TCrossfadeCurveKernel<ECrossfadeCurve::Linear, EGainAccuracy::Exact>());
+		case ECrossfadeCurve::SCurve:
+			return Func(TCrossfadeCurveKernel<ECrossfadeCurve::SCurve, EGainAccuracy::Exact>());
+		case ECrossfadeCurve::Sqrt:
+			return Func(TCrossfadeCurveKernel<ECrossfadeCurve::Sqrt, EGainAccuracy::Exact>());
+		case ECrossfadeCurve::PanLaw4p5dB:
+			return bFast ? Func(TCrossfadeCurveKernel<ECrossfadeCurve::PanLaw4p5dB, EGainAccuracy::Fast>()) : Func(TCrossfadeCurveKernel<ECrossfadeCurve::PanLaw4p5dB, EGainAccuracy::Exact>());
+		case ECrossfadeCurve::PanLaw6dB:
+			return bFast ? Func(TCrossfadeCurveKernel<ECrossfadeCurve::PanLaw6dB, EGainAccuracy::Fast>()) : Func(TCrossfadeCurveKernel<ECrossfadeCurve::PanLaw6dB, EGainAccuracy::Exact>());
+		default:
+			return bFast ? Func(TCrossfadeCurveKernel<ECrossfadeCurve::EqualPower, EGainAccuracy::Fast>()) : Func(TCrossfadeCurveKernel<ECrossfadeCurve::EqualPower, EGainAccuracy::Exact>());
+		}
+	}
+
+	inline bool IsEqualPowerCurve(ECrossfadeCurve Curve)
+	{
+		return Curve == ECrossfadeCurve::EqualPower || Curve == ECrossfadeCurve::PanLaw3dB;
+	}
+
+	// Gains of the two inputs either side of crossfade position Alpha. The equal power curves go through
+	// GetEqualPowerGains unchanged; the others clamp Alpha to [0, 1].
+	inline FEqualPowerGains GetCrossfadeGains(float Alpha, ECrossfadeCurve Curve, EGainAccuracy Accuracy)
+	{
+		if (IsEqualPowerCurve(Curve))
+		{
+			return GetEqualPowerGains(Alpha, Accuracy);
+		}
+
+		const float ClampedAlpha = Clamp(Alpha, 0.0f, 1.0f);
+		return DispatchCrossfadeCurve(Curve, Accuracy, [ClampedAlpha](auto Kernel)
+		{
+			return FEqualPowerGains{ Kernel.Gain(ClampedAlpha), Kernel.Gain(1.0f - ClampedAlpha) };
+		});
+	}
+
+	// ComputeEqualPowerGains for any curve
+	inline void ComputeCrossfadeGains(const float* Alpha, float* OutGainsA, float* OutGainsB, int32 Num, ECrossfadeCurve Curve, EGainAccuracy Accuracy)
+	{
+		if (IsEqualPowerCurve(Curve))
+		{
+			ComputeEqualPowerGains(Alpha, OutGainsA, OutGainsB, Num, Accuracy);
+			return;
+		}
+
+		DispatchCrossfadeCurve(Curve, Accuracy, [=](auto Kernel)
+		{
+			for (int32 i = 0; i < Num; ++i)
+			{
+				const float ClampedAlpha = std::min(std::max(Alpha[i], 0.0f), 1.0f);
+				OutGainsA[i] = Kernel.Gain(ClampedAlpha);
+				OutGainsB[i] = Kernel.Gain(1.0f - ClampedAlpha);
+			}
+		});
+	}
+
+	// ComputeEqualPowerWindowGains for any curve. Values must already be clamped to the crossfade range.
+	inline void ComputeCrossfadeWindowGains(const float* Values, float InputIndex, float* OutGains, int32 Num, ECrossfadeCurve Curve, EGainAccuracy Accuracy)
+	{
+		if (IsEqualPowerCurve(Curve))
+		{
+			ComputeEqualPowerWindowGains(Values, InputIndex, OutGains, Num, Accuracy);
+			return;
+		}
+
+		DispatchCrossfadeCurve(Curve, Accuracy, [=](auto Kernel)
+		{
+			for (int32 i = 0; i < Num; ++i)
+			{
+				OutGains[i] = Kernel.Gain(std::min(std::fabs(Values[i] - InputIndex), 1.0f));
+			}
+		});
+	}
+}
+MSUTILS_FP_CONTRACT_OFF_END
@@ -0,0 +1,59 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+// Engine-independent DSP core shared by the MS_Utils MetaSound operators.
+// Nothing under MSUtilsDSP may include engine headers, so the same code can be built and
+// tested standalone (see CMakeLists.txt at the plugin root).
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// The SIMD kernels promise to round exactly like the scalar ones, and the block and per frame gain paths like each
+// other. Contracting a multiply and an add into an FMA in one of them and not the other breaks that, and both Clang
+// (within an expression) and GCC (across them) do it by default wherever FMA is available, including all of AArch64.
+// Headers wrap their math in these to turn it off whatever the including module is built with. GCC will not
+// inline these functions into code built with contraction on, so only wrap what is called per block or through the
+// kernel table. MSVC only contracts under /fp:contract or /fp:fast, which the engine does not use.
+#if defined(__clang__)
+#define MSUTILS_FP_CONTRACT_OFF_BEGIN _Pragma("float_control(push)") _Pragma("STDC FP_CONTRACT OFF")
+#define MSUTILS_FP_CONTRACT_OFF_END _Pragma("float_control(pop)")
+#elif defined(__GNUC__)
+#define MSUTILS_FP_CONTRACT_OFF_BEGIN _Pragma("GCC push_options") _Pragma("GCC optimize(\"fp-contract=off\")")
+#define MSUTILS_FP_CONTRACT_OFF_END _Pragma("GCC pop_options")
+#else
+#define MSUTILS_FP_CONTRACT_OFF_BEGIN
+#define MSUTILS_FP_CONTRACT_OFF_END
+#endif
+
+namespace MSUtilsDSP
+{
+	using int32 = std::int32_t;
+	using uint32 = std::uint32_t;
+	using uint8 = std::uint8_t;
+	using int64 = std::int64_t;
+	using uint64 = std::uint64_t;
+
+	constexpr float HalfPi = 1.57079632679489661923f;
+
+	// Same tolerance FMath::IsNearlyEqual/IsNearlyZero use by default.
+	constexpr float SmallNumber = 1.e-8f;
+
+	inline float Clamp(float Value, float Min, float Max)
+	{
+		return Value < Min ? Min : (Value < Max ? Value : Max);
+	}
+
+	// Control values come straight from user pins, so NaN or infinity is read as 0 before it can reach an index
+	// calculation or the gain math
+	inline float FiniteOrZero(float Value)
+	{
+		return std::isfinite(Value) ? Value : 0.0f;
+	}
+
+	inline bool IsNearlyEqual(float A, float B, float Tolerance = SmallNumber)
+	{
+		return std::fabs(A - B) <= Tolerance;
+	}
+}
@@ -0,0 +1,142 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>
+#define MSUTILS_FLUSH_DENORMALS_X86 1
+#else
+#define MSUTILS_FLUSH_DENORMALS_X86 0
+#endif
+
+#if defined(__aarch64__) || (defined(_M_ARM64) && !MSUTILS_FLUSH_DENORMALS_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#define MSUTILS_FLUSH_DENORMALS_ARM64 1
+#else
+#define MSUTILS_FLUSH_DENORMALS_ARM64 0
+#endif
+
+// True where FScopedFlushDenormals actually changes the floating point mode
+#define MSUTILS_HAS_FLUSH_DENORMALS (MSUTILS_FLUSH_DENORMALS_X86 || MSUTILS_FLUSH_DENORMALS_ARM64)
+
+namespace MSUtilsDSP
+{
+	// Gains below this (about -120 dB) are snapped to 0, so a fade or crossfade that has all but finished stops
+	// feeding downstream nodes a tail that can only decay into denormals, and stops costing a mix pass.
+	constexpr float DefaultSilenceThreshold = 1.e-6f;
+
+	namespace DenormalsPrivate
+	{
+		inline std::atomic<float> SilenceThreshold{ DefaultSilenceThreshold };
+		inline std::atomic<bool> bFlushDenormals{ true };
+	}
+
+	// Threshold the operators pass to their faders each block. Set from the au.MSUtils.SilenceThreshold console variable.
+	inline float GetSilenceThreshold()
+	{
+		return DenormalsPrivate::SilenceThreshold.load(std::memory_order_relaxed);
+	}
+
+	// 0 turns snapping off. Negative thresholds are treated as 0.
+	inline void SetSilenceThreshold(float Threshold)
+	{
+		DenormalsPrivate::SilenceThreshold.store(std::max(Threshold, 0.0f), std::memory_order_relaxed);
+	}
+
+	// Whether the operators flush denormals while they render. Set from the au.MSUtils.FlushDenormals console variable.
+	inline bool IsDenormalFlushEnabled()
+	{
+		return DenormalsPrivate::bFlushDenormals.load(std::memory_order_relaxed);
+	}
+
+	inline void SetDenormalFlushEnabled(bool bEnabled)
+	{
+		DenormalsPrivate::bFlushDenormals.store(bEnabled, std::memory_order_relaxed);
+	}
+
+	// Value, or exactly 0 if its magnitude is below Threshold
+	inline float SnapToSilence(float Value, float Threshold)
+	{
+		return std::fabs(Value) < Threshold ? 0.0f : Value;
+	}
+
+	// Flushes denormal results to zero and treats denormal inputs as zero (FTZ and DAZ on x86, FZ on AArch64) for
+	// the lifetime of the scope, then puts the previous mode back. The mode is per thread, so this only covers the
+	// operator that opens the scope. Denormal arithmetic on x86 can be a hundred times slower than normal, which is
+	// what an input decaying towards silence would otherwise cost. Does nothing on other targets.
+	class FScopedFlushDenormals
+	{
+	public:
+		explicit FScopedFlushDenormals(bool bEnable = true)
+		{
+			if (!bEnable)
+			{
+				return;
+			}
+
+#if MSUTILS_FLUSH_DENORMALS_X86
+			constexpr unsigned int FlushToZero = 0x8000;
+			constexpr unsigned int DenormalsAreZero = 0x0040;
+			const unsigned int State = _mm_getcsr();
+			SavedState = State;
+			bRestore = true;
+			_mm_setcsr(State | FlushToZero | DenormalsAreZero);
+#elif MSUTILS_FLUSH_DENORMALS_ARM64
+			constexpr unsigned long long FlushToZero = 1ull << 24;
+			const unsigned long long State = ReadFPCR();
+			SavedState = State;
+			bRestore = true;
+			WriteFPCR(State | FlushToZero);
+#endif
+		}
+
+		~FScopedFlushDenormals()
+		{
+			if (!bRestore)
+			{
+				return;
+			}
+
+#if MSUTILS_FLUSH_DENORMALS_X86
+			_mm_setcsr((unsigned int)SavedState);
+#elif MSUTILS_FLUSH_DENORMALS_ARM64
+			WriteFPCR(SavedState);
+#endif
+		}
+
+		FScopedFlushDenormals(const FScopedFlushDenormals&) = delete;
+		FScopedFlushDenormals& operator=(const FScopedFlushDenormals&) = delete;
+
+	private:
+#if MSUTILS_FLUSH_DENORMALS_ARM64
+		static unsigned long long ReadFPCR()
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			return (unsigned long long)_ReadStatusReg(ARM64_FPCR);
+#else
+			unsigned long long State;
+			__asm__ __volatile__("mrs %0, fpcr" : "=r"(State));
+			return State;
+#endif
+		}
+
+		static void WriteFPCR(unsigned long long State)
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			_WriteStatusReg(ARM64_FPCR, (__int64)State);
+#else
+			__asm__ __volatile__("msr fpcr, %0" : : "r"(State));
+#endif
+		}
+#endif
+
+		unsigned long long SavedState = 0;
+		bool bRestore = false;
+	};
+}
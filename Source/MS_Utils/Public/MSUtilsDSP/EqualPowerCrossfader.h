@@ -0,0 +1,449 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/CrossfadeCurve.h"
+#include "MSUtilsDSP/Denormals.h"
+#include "MSUtilsDSP/EqualPowerGain.h"
+#include "MSUtilsDSP/GainKernels.h"
+
+#include <array>
+#include <vector>
+
+namespace MSUtilsDSP
+{
+	// Gain state and mixing for an N input equal power crossfade. Only the two inputs either side of the
+	// crossfade position are given gain; inputs that had gain last block are ramped down to zero.
+	// The state is sized at compile time and lives inline, so an instance never allocates. The previous and
+	// current gains are two halves of one double buffer: latching the current gains at the end of a block
+	// just points the previous gains at the same half, and the next update writes into the other one.
+	// Each half also records which of its entries are non-zero (at most the two of a position), so a block
+	// only ever touches the inputs that are audible or ramping down - at most four - whatever NumInputs is.
+	// The gains follow the equal power curve unless another is set with SetCurve. Gains below the silence threshold
+	// count as 0, so an input the position has all but left ramps down and drops out of the mix.
+	template<int32 NumInputs>
+	class TEqualPowerCrossfader
+	{
+		static_assert(NumInputs >= 2, "An equal power crossfade needs at least two inputs");
+
+	public:
+		// Most inputs a block can mix: the pair ramping down from the previous position and the pair ramping up
+		static constexpr int32 MaxMixedInputs = 4;
+
+		static constexpr int32 GetNumInputs()
+		{
+			return NumInputs;
+		}
+
+		float GetCurrentGain(int32 InputIndex) const
+		{
+			return Gains[CurrentGainIndex][InputIndex];
+		}
+
+		bool GetNeedsMixing(int32 InputIndex) const
+		{
+			return NeedsMixing[InputIndex];
+		}
+
+		// True if the input was audible at any point in the last block, including while ramping down
+		bool IsInputActive(int32 InputIndex) const
+		{
+			return NeedsMixing[InputIndex];
+		}
+
+		// The inputs mixed by the last block, in ascending order
+		const int32* GetMixedInputs() const
+		{
+			return MixedInputs;
+		}
+
+		int32 GetNumMixedInputs() const
+		{
+			return NumMixedInputs;
+		}
+
+		const FCrossfadePosition& GetPosition() const
+		{
+			return Position;
+		}
+
+		ECrossfadeCurve GetCurve() const
+		{
+			return Curve;
+		}
+
+		// Curve used for the gains from the next block on. Changing it ramps from the old gains like a moving value.
+		void SetCurve(ECrossfadeCurve InCurve)
+		{
+			Curve = InCurve;
+		}
+
+		// Used for the gains from the next block on
+		void SetSilenceThreshold(float InThreshold)
+		{
+			SilenceThreshold = InThreshold;
+		}
+
+		// Back to the state it was constructed in: no position and every gain at 0, so the next block ramps up
+		// from silence. Keeps the curve and threshold.
+		void Reset()
+		{
+			PrevCrossfadeValue = -1.0f;
+			Position = FCrossfadePosition();
+			Gains[0].fill(0.0f);
+			Gains[1].fill(0.0f);
+			Halves[0] = FGainHalf();
+			Halves[1] = FGainHalf();
+			NeedsMixing.fill(false);
+			NumMixedInputs = 0;
+			CurrentGainIndex = 0;
+			PrevGainIndex = 0;
+		}
+
+		// Runs one block of the N-way crossfade node. The position is only recalculated when the crossfade value moves.
+		void Process(float CrossfadeValue, EGainAccuracy Accuracy, const float* const* InBuffers, float* OutBuffer, int32 NumFrames)
+		{
+			Process(CrossfadeValue, Accuracy, InBuffers, &OutBuffer, 1, NumFrames);
+		}
+
+		// Multichannel version: InBuffers holds NumInputs * NumChannels planar buffers, all channels of input 0 first.
+		// The gains are worked out once and applied to every channel.
+		void Process(float CrossfadeValue, EGainAccuracy Accuracy, const float* const* InBuffers, float* const* OutBuffers, int32 NumChannels, int32 NumFrames)
+		{
+			// Clamp the cross fade value based on the number of inputs
+			const float ClampedValue = Clamp(FiniteOrZero(CrossfadeValue), 0.0f, (float)(NumInputs - 1));
+			if (!IsNearlyEqual(ClampedValue, PrevCrossfadeValue))
+			{
+				PrevCrossfadeValue = ClampedValue;
+				Position = GetCrossfadePosition(ClampedValue, NumInputs);
+			}
+
+			UpdateGains(Position, Accuracy);
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				MixChannel(InBuffers + Channel, NumChannels, OutBuffers[Channel], NumFrames);
+			}
+			LatchGains();
+		}
+
+		// Mixes a block with the gains the last Process call settled on, without looking at the crossfade value again.
+		// For a crossfade whose value, accuracy and curve can never change, once a Process call has ramped them in.
+		void MixSettled(const float* const* InBuffers, float* const* OutBuffers, int32 NumChannels, int32 NumFrames)
+		{
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				MixChannel(InBuffers + Channel, NumChannels, OutBuffers[Channel], NumFrames);
+			}
+		}
+
+		// Fills in the current half of the gain buffer and works out which inputs the next Mix needs.
+		void UpdateGains(const FCrossfadePosition& InPosition, EGainAccuracy Accuracy = EGainAccuracy::Exact)
+		{
+			const FEqualPowerGains PositionGains = GetCrossfadeGains(InPosition.Alpha, Curve, Accuracy);
+			CurrentGainIndex = PrevGainIndex ^ 1;
+			const FGainHalf& PrevHalf = Halves[PrevGainIndex];
+			FGainHalf& CurrentHalf = Halves[CurrentGainIndex];
+			std::array<float, NumInputs>& CurrentGains = Gains[CurrentGainIndex];
+
+			// Clear whatever this half held from two blocks ago, then write the new pair
+			for (int32 i = 0; i < CurrentHalf.NumNonZero; ++i)
+			{
+				CurrentGains[CurrentHalf.NonZero[i]] = 0.0f;
+			}
+			CurrentHalf.NumNonZero = 0;
+
+			const int32 PairIndices[2] = { InPosition.IndexA, InPosition.IndexB };
+			const float PairGains[2] = { SnapToSilence(PositionGains.A, SilenceThreshold), SnapToSilence(PositionGains.B, SilenceThreshold) };
+			const int32 NumPair = InPosition.IndexA == InPosition.IndexB ? 1 : 2;
+			for (int32 i = 0; i < NumPair; ++i)
+			{
+				// Settled on a whole number (or within the threshold of one) the other input has no gain and is skipped like any other silent input
+				if (PairGains[i] != 0.0f)
+				{
+					CurrentGains[PairIndices[i]] = PairGains[i];
+					CurrentHalf.NonZero[CurrentHalf.NumNonZero++] = PairIndices[i];
+				}
+			}
+
+			for (int32 i = 0; i < NumMixedInputs; ++i)
+			{
+				NeedsMixing[MixedInputs[i]] = false;
+			}
+			NumMixedInputs = 0;
+			for (int32 i = 0; i < PrevHalf.NumNonZero; ++i)
+			{
+				AddMixedInput(PrevHalf.NonZero[i]);
+			}
+			for (int32 i = 0; i < CurrentHalf.NumNonZero; ++i)
+			{
+				AddMixedInput(CurrentHalf.NonZero[i]);
+			}
+		}
+
+		// Mixes every input that is audible or ramping down into OutBuffer, then latches the current gains
+		// as the start of next block's ramps. InBuffers must hold NumInputs pointers of NumFrames samples.
+		void Mix(const float* const* InBuffers, float* OutBuffer, int32 NumFrames)
+		{
+			MixChannel(InBuffers, 1, OutBuffer, NumFrames);
+			LatchGains();
+		}
+
+		// Mixes one channel without latching the gains. Input i's buffer is InBuffers[i * InputStride].
+		// Usually no more than two inputs are live and they are mixed in a single pass over the output; only the
+		// blocks where an input is still ramping down from an earlier position fall back to accumulating. Settled
+		// on a single input at unity gain the block is a straight copy.
+		void MixChannel(const float* const* InBuffers, int32 InputStride, float* OutBuffer, int32 NumFrames)
+		{
+			const std::array<float, NumInputs>& PrevGains = Gains[PrevGainIndex];
+			const std::array<float, NumInputs>& CurrentGains = Gains[CurrentGainIndex];
+
+			if (NumMixedInputs == 0)
+			{
+				ZeroBuffer(OutBuffer, NumFrames);
+			}
+			else if (NumMixedInputs == 2)
+			{
+				const int32 A = MixedInputs[0];
+				const int32 B = MixedInputs[1];
+				MixPairRamp(InBuffers[A * InputStride], InBuffers[B * InputStride], OutBuffer, NumFrames, PrevGains[A], CurrentGains[A], PrevGains[B], CurrentGains[B]);
+			}
+			else
+			{
+				const int32 A = MixedInputs[0];
+				ScaleRamp(InBuffers[A * InputStride], OutBuffer, NumFrames, PrevGains[A], CurrentGains[A]);
+				for (int32 i = 1; i < NumMixedInputs; ++i)
+				{
+					const int32 Input = MixedInputs[i];
+					MixInRamp(InBuffers[Input * InputStride], OutBuffer, NumFrames, PrevGains[Input], CurrentGains[Input]);
+				}
+			}
+		}
+
+		// Makes the current gains the start of next block's ramps
+		void LatchGains()
+		{
+			PrevGainIndex = CurrentGainIndex;
+		}
+
+	private:
+		// Non-zero entries of one half of the gain buffer
+		struct FGainHalf
+		{
+			int32 NonZero[2] = { 0, 0 };
+			int32 NumNonZero = 0;
+		};
+
+		// Inserts InputIndex into the sorted mixed list unless it is already there
+		void AddMixedInput(int32 InputIndex)
+		{
+			if (NeedsMixing[InputIndex])
+			{
+				return;
+			}
+			NeedsMixing[InputIndex] = true;
+
+			int32 Slot = NumMixedInputs++;
+			for (; Slot > 0 && MixedInputs[Slot - 1] > InputIndex; --Slot)
+			{
+				MixedInputs[Slot] = MixedInputs[Slot - 1];
+			}
+			MixedInputs[Slot] = InputIndex;
+		}
+
+		float PrevCrossfadeValue = -1.0f;
+		float SilenceThreshold = DefaultSilenceThreshold;
+		ECrossfadeCurve Curve = ECrossfadeCurve::EqualPower;
+		FCrossfadePosition Position;
+		// Halves of the gain double buffer. Once a block is mixed both indices point at the same half.
+		std::array<float, NumInputs> Gains[2] = {};
+		FGainHalf Halves[2];
+		std::array<bool, NumInputs> NeedsMixing = {};
+		int32 MixedInputs[MaxMixedInputs] = {};
+		int32 NumMixedInputs = 0;
+		int32 CurrentGainIndex = 0;
+		int32 PrevGainIndex = 0;
+	};
+
+	// Gain state and mixing for the two input lightweight equal power crossfade, or any other curve set with SetCurve.
+	class FEqualPowerCrossfadePair
+	{
+	public:
+		void SetCurve(ECrossfadeCurve InCurve)
+		{
+			Curve = InCurve;
+		}
+
+		// Back to the state it was constructed in, so the next block calculates the gains and ramps up from silence.
+		// Keeps the curve.
+		void Reset()
+		{
+			PrevCrossfadeValue = 1.1f;
+			PrevAccuracy = EGainAccuracy::Exact;
+			PrevCurve = ECrossfadeCurve::EqualPower;
+			PrevGains = { 0.0f, 0.0f };
+			Gains = FEqualPowerGains();
+			bInputActive[0] = false;
+			bInputActive[1] = false;
+		}
+
+		// Runs one block of the lightweight crossfade node. The crossfade value is not clamped, as the gains clamp themselves.
+		void Process(float CrossfadeValue, EGainAccuracy Accuracy, const float* InBufferA, const float* InBufferB, float* OutBuffer, int32 NumFrames)
+		{
+			Process(CrossfadeValue, Accuracy, &InBufferA, &InBufferB, &OutBuffer, 1, NumFrames);
+		}
+
+		// Multichannel version, with one planar buffer per channel for each input and the output
+		void Process(float InCrossfadeValue, EGainAccuracy Accuracy, const float* const* InBuffersA, const float* const* InBuffersB, float* const* OutBuffers, int32 NumChannels, int32 NumFrames)
+		{
+			// NaN would otherwise never compare equal to the previous value, and gives neither input's gains
+			const float CrossfadeValue = FiniteOrZero(InCrossfadeValue);
+			const bool bValueChanged = CrossfadeValue != PrevCrossfadeValue || Accuracy != PrevAccuracy || Curve != PrevCurve;
+			if (bValueChanged)
+			{
+				Gains = GetCrossfadeGains(CrossfadeValue, Curve, Accuracy);
+			}
+
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				MixPairRamp(InBuffersA[Channel], InBuffersB[Channel], OutBuffers[Channel], NumFrames, PrevGains.A, Gains.A, PrevGains.B, Gains.B);
+			}
+			bInputActive[0] = PrevGains.A != 0.0f || Gains.A != 0.0f;
+			bInputActive[1] = PrevGains.B != 0.0f || Gains.B != 0.0f;
+
+			if (bValueChanged)
+			{
+				PrevCrossfadeValue = CrossfadeValue;
+				PrevAccuracy = Accuracy;
+				PrevCurve = Curve;
+				PrevGains = Gains;
+			}
+		}
+
+		const FEqualPowerGains& GetGains() const
+		{
+			return Gains;
+		}
+
+		// True if input A (0) or B (1) was audible at any point in the last block, including while ramping down
+		bool IsInputActive(int32 InputIndex) const
+		{
+			return bInputActive[InputIndex];
+		}
+
+	private:
+		// Out of range so the first block always calculates the gains
+		float PrevCrossfadeValue = 1.1f;
+		EGainAccuracy PrevAccuracy = EGainAccuracy::Exact;
+		ECrossfadeCurve Curve = ECrossfadeCurve::EqualPower;
+		ECrossfadeCurve PrevCurve = ECrossfadeCurve::EqualPower;
+		FEqualPowerGains PrevGains = { 0.0f, 0.0f };
+		FEqualPowerGains Gains;
+		bool bInputActive[2] = { false, false };
+	};
+
+	// Equal power crossfade driven by an audio rate crossfade value, for the audio rate N-way crossfade node.
+	// Gains are calculated per frame so there are no block rate steps to smooth. Only inputs the value came
+	// within one step of during the block are processed, so a value that stays between two inputs costs two
+	// gain passes and two mix passes whatever the input count.
+	class FAudioRateEqualPowerCrossfader
+	{
+	public:
+		FAudioRateEqualPowerCrossfader(int32 InNumInputs, int32 InMaxFrames)
+			: NumInputs(InNumInputs)
+			, ClampedValues(InMaxFrames, 0.0f)
+			, Gains(InMaxFrames, 0.0f)
+		{
+		}
+
+		int32 GetNumInputs() const
+		{
+			return NumInputs;
+		}
+
+		// Range of inputs mixed in the last block
+		int32 GetFirstActiveInput() const
+		{
+			return FirstActiveInput;
+		}
+
+		int32 GetLastActiveInput() const
+		{
+			return LastActiveInput;
+		}
+
+		// True if the input was within one step of the crossfade value at some point in the last block
+		bool IsInputActive(int32 InputIndex) const
+		{
+			return InputIndex >= FirstActiveInput && InputIndex <= LastActiveInput;
+		}
+
+		void SetCurve(ECrossfadeCurve InCurve)
+		{
+			Curve = InCurve;
+		}
+
+		// Gains are per frame so there is nothing to ramp from; this only empties the active range
+		void Reset()
+		{
+			FirstActiveInput = 0;
+			LastActiveInput = -1;
+		}
+
+		// CrossfadeValues holds one crossfade value per frame, with the same range as the control rate node.
+		void Process(const float* CrossfadeValues, EGainAccuracy Accuracy, const float* const* InBuffers, float* OutBuffer, int32 NumFrames)
+		{
+			Process(CrossfadeValues, Accuracy, InBuffers, &OutBuffer, 1, NumFrames);
+		}
+
+		// Multichannel version: InBuffers holds NumInputs * NumChannels planar buffers, all channels of input 0 first.
+		// Each input's gains are calculated once and applied to all of its channels.
+		void Process(const float* CrossfadeValues, EGainAccuracy Accuracy, const float* const* InBuffers, float* const* OutBuffers, int32 NumChannels, int32 NumFrames)
+		{
+			if ((int32)ClampedValues.size() < NumFrames)
+			{
+				ClampedValues.resize(NumFrames);
+				Gains.resize(NumFrames);
+			}
+
+			const float MaxValue = (float)(NumInputs - 1);
+			float BlockMin = MaxValue;
+			float BlockMax = 0.0f;
+			for (int32 i = 0; i < NumFrames; ++i)
+			{
+				const float Value = std::min(std::max(FiniteOrZero(CrossfadeValues[i]), 0.0f), MaxValue);
+				ClampedValues[i] = Value;
+				BlockMin = std::min(BlockMin, Value);
+				BlockMax = std::max(BlockMax, Value);
+			}
+
+			FirstActiveInput = std::min((int32)std::floor(BlockMin), NumInputs - 1);
+			LastActiveInput = std::min((int32)std::ceil(BlockMax), NumInputs - 1);
+
+			for (int32 InputIndex = FirstActiveInput; InputIndex <= LastActiveInput; ++InputIndex)
+			{
+				ComputeCrossfadeWindowGains(ClampedValues.data(), (float)InputIndex, Gains.data(), NumFrames, Curve, Accuracy);
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					const float* InBuffer = InBuffers[InputIndex * NumChannels + Channel];
+					if (InputIndex == FirstActiveInput)
+					{
+						MultiplyBuffers(InBuffer, Gains.data(), OutBuffers[Channel], NumFrames);
+					}
+					else
+					{
+						MixInMultiplied(InBuffer, Gains.data(), OutBuffers[Channel], NumFrames);
+					}
+				}
+			}
+		}
+
+	private:
+		int32 NumInputs = 0;
+		ECrossfadeCurve Curve = ECrossfadeCurve::EqualPower;
+		// Empty range until the first block is processed
+		int32 FirstActiveInput = 0;
+		int32 LastActiveInput = -1;
+		std::vector<float> ClampedValues;
+		std::vector<float> Gains;
+	};
+}
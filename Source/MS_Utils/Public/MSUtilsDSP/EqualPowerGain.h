@@ -0,0 +1,136 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+
+MSUTILS_FP_CONTRACT_OFF_BEGIN
+
+namespace MSUtilsDSP
+{
+	enum class EGainAccuracy : int32
+	{
+		// std::cos, as the nodes have always used
+		Exact = 0,
+		// Polynomial approximation, see FastQuarterCos
+		Fast
+	};
+
+	struct FEqualPowerGains
+	{
+		float A = 1.0f;
+		float B = 0.0f;
+	};
+
+	// Equal power (cosine) gains for a crossfade position Alpha, where 0 is fully A and 1 is fully B.
+	inline FEqualPowerGains GetEqualPowerGains(float Alpha)
+	{
+		FEqualPowerGains Gains;
+		Gains.A = Clamp(std::cos(Alpha * HalfPi), 0.f, 1.f);
+		Gains.B = Clamp(std::cos((1.0f - Alpha) * HalfPi), 0.f, 1.f);
+		return Gains;
+	}
+
+	// cos(X * pi / 2) for X in [0, 1], as a degree 8 even polynomial with minimax coefficients, constrained so it is
+	// exactly 1 at X = 0 and 0 at X = 1. Evaluated in float the absolute error is below 1.8e-7 (about -134 dB) across
+	// [0, 1], the result decreases monotonically, and FastQuarterCos(X)^2 + FastQuarterCos(1 - X)^2 stays within 3.3e-7
+	// of 1. There are no branches or table lookups, so loops over it vectorize.
+	inline float FastQuarterCos(float X)
+	{
+		constexpr float C1 = -1.2336987025797406f;
+		constexpr float C2 = 0.25365193439476097f;
+		constexpr float C3 = -0.02081143132731317f;
+		constexpr float C4 = 0.0008581995122927122f;
+
+		const float X2 = X * X;
+		return 1.0f + X2 * (C1 + X2 * (C2 + X2 * (C3 + X2 * C4)));
+	}
+
+	// Fast equal power gains. Unlike the exact version Alpha is clamped to [0, 1] first, which only differs when
+	// the caller passes an out of range Alpha.
+	inline FEqualPowerGains GetEqualPowerGainsFast(float Alpha)
+	{
+		const float ClampedAlpha = Clamp(Alpha, 0.0f, 1.0f);
+
+		FEqualPowerGains Gains;
+		Gains.A = Clamp(FastQuarterCos(ClampedAlpha), 0.0f, 1.0f);
+		Gains.B = Clamp(FastQuarterCos(1.0f - ClampedAlpha), 0.0f, 1.0f);
+		return Gains;
+	}
+
+	inline FEqualPowerGains GetEqualPowerGains(float Alpha, EGainAccuracy Accuracy)
+	{
+		return Accuracy == EGainAccuracy::Fast ? GetEqualPowerGainsFast(Alpha) : GetEqualPowerGains(Alpha);
+	}
+
+	// Equal power gains for a whole array of crossfade positions, e.g. one per sample. The accuracy is resolved
+	// once outside the loop so each inner loop is straight line code.
+	inline void ComputeEqualPowerGains(const float* Alpha, float* OutGainsA, float* OutGainsB, int32 Num, EGainAccuracy Accuracy)
+	{
+		if (Accuracy == EGainAccuracy::Fast)
+		{
+			for (int32 i = 0; i < Num; ++i)
+			{
+				const float ClampedAlpha = std::min(std::max(Alpha[i], 0.0f), 1.0f);
+				OutGainsA[i] = std::min(std::max(FastQuarterCos(ClampedAlpha), 0.0f), 1.0f);
+				OutGainsB[i] = std::min(std::max(FastQuarterCos(1.0f - ClampedAlpha), 0.0f), 1.0f);
+			}
+		}
+		else
+		{
+			for (int32 i = 0; i < Num; ++i)
+			{
+				const FEqualPowerGains Gains = GetEqualPowerGains(Alpha[i]);
+				OutGainsA[i] = Gains.A;
+				OutGainsB[i] = Gains.B;
+			}
+		}
+	}
+
+	// Per frame gain of input InputIndex in an audio rate crossfade. Seen from a single input the equal power
+	// crossfade is a window: cos(|Value - InputIndex| * pi / 2) within one step of the input and zero beyond, which
+	// gives the same gains as GetCrossfadePosition + GetEqualPowerGains without a per frame index lookup.
+	// Values must already be clamped to the crossfade range.
+	inline void ComputeEqualPowerWindowGains(const float* Values, float InputIndex, float* OutGains, int32 Num, EGainAccuracy Accuracy)
+	{
+		if (Accuracy == EGainAccuracy::Fast)
+		{
+			for (int32 i = 0; i < Num; ++i)
+			{
+				const float Distance = std::min(std::fabs(Values[i] - InputIndex), 1.0f);
+				OutGains[i] = std::max(FastQuarterCos(Distance), 0.0f);
+			}
+		}
+		else
+		{
+			for (int32 i = 0; i < Num; ++i)
+			{
+				const float Distance = std::min(std::fabs(Values[i] - InputIndex), 1.0f);
+				OutGains[i] = Clamp(std::cos(Distance * HalfPi), 0.0f, 1.0f);
+			}
+		}
+	}
+
+	// The pair of neighbouring inputs a crossfade value sits between, and how far it is towards the second one.
+	struct FCrossfadePosition
+	{
+		int32 IndexA = 0;
+		int32 IndexB = 0;
+		float Alpha = 0.0f;
+	};
+
+	// Maps a crossfade value to a position between NumInputs inputs. The value is clamped to [0, NumInputs - 1],
+	// so for example 3.4 gives IndexA 3, IndexB 4 and an Alpha of 0.4. A non-finite value counts as 0.
+	inline FCrossfadePosition GetCrossfadePosition(float CrossfadeValue, int32 NumInputs)
+	{
+		const float MaxValue = (float)(NumInputs - 1);
+		const float ClampedValue = Clamp(FiniteOrZero(CrossfadeValue), 0.0f, MaxValue);
+
+		FCrossfadePosition Position;
+		Position.IndexA = (int32)std::floor(ClampedValue);
+		Position.IndexB = std::min(Position.IndexA + 1, NumInputs - 1);
+		Position.Alpha = ClampedValue - (float)Position.IndexA;
+		return Position;
+	}
+}
+MSUTILS_FP_CONTRACT_OFF_END
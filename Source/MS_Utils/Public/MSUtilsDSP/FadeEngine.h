@@ -0,0 +1,256 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+#include "MSUtilsDSP/FadeEnvelope.h"
+#include "MSUtilsDSP/GainKernels.h"
+
+namespace MSUtilsDSP
+{
+	enum class EFadeState : uint8
+	{
+		// Sitting still at the current value, whether that is 0, 1 or wherever a fade was held
+		Holding,
+		FadingIn,
+		FadingOut
+	};
+
+	inline const char* GetFadeStateName(EFadeState State)
+	{
+		switch (State)
+		{
+		case EFadeState::FadingIn: return "Fading In";
+		case EFadeState::FadingOut: return "Fading Out";
+		default: return "Holding";
+		}
+	}
+
+	enum class EFadeCommandType : uint8
+	{
+		// Fades towards 1 from wherever the envelope currently is
+		FadeIn,
+		// Fades towards 0 from wherever the envelope currently is
+		FadeOut,
+		// Stops any running fade at its current value
+		Hold
+	};
+
+	// A fade in, fade out or hold trigger landing on a given frame of the block being rendered
+	struct FFadeCommand
+	{
+		int32 Frame = 0;
+		EFadeCommandType Type = EFadeCommandType::Hold;
+		// Time a fade over the full 0 to 1 range takes, in samples. Fades from part way take proportionally less.
+		float FadeSamples = 0.0f;
+	};
+
+	// Fade in, fade out and hold in one state machine, behind the Fade In/Out node. Unlike FFadeEnvelope, a command
+	// never snaps the value: every fade continues from the value the envelope is at when it lands, so retriggering or
+	// reversing mid-fade is click free. A fade started on frame T is at the current value on T and moves at a fixed
+	// rate of 1 / FadeSamples per frame, reporting finishing on the frame it reaches its target.
+	class FFadeEngine
+	{
+	public:
+		explicit FFadeEngine(float InInitialValue = 0.0f)
+			: Value(Clamp(InInitialValue, 0.0f, 1.0f))
+		{
+		}
+
+		// Value of the last frame rendered
+		float GetValue() const
+		{
+			return Value;
+		}
+
+		EFadeState GetState() const
+		{
+			return State;
+		}
+
+		bool IsFading() const
+		{
+			return State != EFadeState::Holding;
+		}
+
+		// Starts fading towards the end value of Direction from the current value
+		void FadeTo(EFadeDirection Direction, float InFadeSamples)
+		{
+			const float FadeSamples = ClampFadeSamples(InFadeSamples);
+			const float Target = Direction == EFadeDirection::In ? 1.0f : 0.0f;
+			const float Distance = std::fabs(Target - Value);
+
+			State = Direction == EFadeDirection::In ? EFadeState::FadingIn : EFadeState::FadingOut;
+			StartValue = Value;
+			FadePosition = 0;
+			NumFadeFrames = FadeSamples > 0.0f ? (int32)std::ceil(Distance * FadeSamples) : 0;
+			Step = NumFadeFrames > 0 ? (Direction == EFadeDirection::In ? 1.0f : -1.0f) / FadeSamples : 0.0f;
+		}
+
+		void Hold()
+		{
+			State = EFadeState::Holding;
+		}
+
+		// Back to the state it was constructed in, holding at InitialValue
+		void Reset(float InitialValue)
+		{
+			State = EFadeState::Holding;
+			Value = Clamp(InitialValue, 0.0f, 1.0f);
+			StartValue = 0.0f;
+			Step = 0.0f;
+			NumFadeFrames = 0;
+			FadePosition = 0;
+			bBufferSettled = false;
+		}
+
+		void ApplyCommand(const FFadeCommand& Command)
+		{
+			switch (Command.Type)
+			{
+			case EFadeCommandType::FadeIn:
+				FadeTo(EFadeDirection::In, Command.FadeSamples);
+				break;
+			case EFadeCommandType::FadeOut:
+				FadeTo(EFadeDirection::Out, Command.FadeSamples);
+				break;
+			default:
+				Hold();
+				break;
+			}
+		}
+
+		// Renders NumFrames of the envelope. Returns the frame a fade finished on, or -1 if none did.
+		int32 Render(float* OutBuffer, int32 NumFrames)
+		{
+			return Advance(NumFrames,
+				[OutBuffer](int32 Offset, int32 Count, float SegmentStart, float Increment)
+				{
+					FillLinear(OutBuffer + Offset, Count, SegmentStart, Increment);
+				},
+				[OutBuffer](int32 Offset, int32 Count, float Constant)
+				{
+					FillConstant(OutBuffer + Offset, Count, Constant);
+				});
+		}
+
+		// Out = In * envelope for NumFrames. Returns as Render.
+		int32 Apply(const float* InBuffer, float* OutBuffer, int32 NumFrames)
+		{
+			return Advance(NumFrames,
+				[InBuffer, OutBuffer](int32 Offset, int32 Count, float SegmentStart, float Increment)
+				{
+					MultiplyLinear(InBuffer + Offset, OutBuffer + Offset, Count, SegmentStart, Increment);
+				},
+				[InBuffer, OutBuffer](int32 Offset, int32 Count, float Constant)
+				{
+					ScaleRamp(InBuffer + Offset, OutBuffer + Offset, Count, Constant, Constant);
+				});
+		}
+
+		// Renders a whole block of the envelope, applying Commands (sorted by frame) on the frames they land on.
+		// OnFinished(Frame, Direction) is called for every fade that reaches its target.
+		template<typename OnFinishedType>
+		void RenderBlock(float* OutBuffer, int32 NumFrames, const FFadeCommand* Commands, int32 NumCommands, OnFinishedType OnFinished)
+		{
+			ProcessCommands(NumFrames, Commands, NumCommands, OnFinished,
+				[this, OutBuffer](int32 Offset, int32 Count)
+				{
+					return Render(OutBuffer + Offset, Count);
+				});
+		}
+
+		// RenderBlock fused with the multiply, as FFadeEnvelope::ApplyBlock: the audio is copied straight through
+		// while holding at 1, and a silent output is only cleared on the first block it is held at 0.
+		template<typename OnFinishedType>
+		void ApplyBlock(const float* InBuffer, float* OutBuffer, int32 NumFrames, const FFadeCommand* Commands, int32 NumCommands, OnFinishedType OnFinished)
+		{
+			if (NumCommands == 0 && State == EFadeState::Holding)
+			{
+				if (Value == 0.0f)
+				{
+					if (!bBufferSettled)
+					{
+						ZeroBuffer(OutBuffer, NumFrames);
+						bBufferSettled = true;
+					}
+					return;
+				}
+
+				bBufferSettled = false;
+				ScaleRamp(InBuffer, OutBuffer, NumFrames, Value, Value);
+				return;
+			}
+			bBufferSettled = false;
+
+			ProcessCommands(NumFrames, Commands, NumCommands, OnFinished,
+				[this, InBuffer, OutBuffer](int32 Offset, int32 Count)
+				{
+					return Apply(InBuffer + Offset, OutBuffer + Offset, Count);
+				});
+		}
+
+	private:
+		// Steps the state machine on by NumFrames, calling Ramp(Offset, Count, SegmentStart, Increment) for frames
+		// still fading and Constant(Offset, Count, Value) for frames held or after a fade lands
+		template<typename RampType, typename ConstantType>
+		int32 Advance(int32 NumFrames, RampType&& Ramp, ConstantType&& Constant)
+		{
+			if (State == EFadeState::Holding)
+			{
+				Constant(0, NumFrames, Value);
+				return -1;
+			}
+
+			const int32 NumRampFrames = std::min(NumFadeFrames - FadePosition, NumFrames);
+			if (NumRampFrames > 0)
+			{
+				// Each segment starts from the fade's own start rather than the last value, so splitting a fade across
+				// blocks or events does not accumulate rounding error
+				const float SegmentStart = StartValue + Step * (float)FadePosition;
+				Ramp(0, NumRampFrames, SegmentStart, Step);
+
+				FadePosition += NumRampFrames;
+				Value = SegmentStart + Step * (float)(NumRampFrames - 1);
+			}
+
+			if (NumRampFrames == NumFrames)
+			{
+				return -1;
+			}
+
+			// The fade reaches its target within this block
+			Value = State == EFadeState::FadingIn ? 1.0f : 0.0f;
+			State = EFadeState::Holding;
+			Constant(NumRampFrames, NumFrames - NumRampFrames, Value);
+			return NumRampFrames;
+		}
+
+		template<typename OnFinishedType, typename SegmentType>
+		void ProcessCommands(int32 NumFrames, const FFadeCommand* Commands, int32 NumCommands, OnFinishedType& OnFinished, SegmentType&& Segment)
+		{
+			ForEachEventSegment(NumFrames, Commands, NumCommands,
+				[this, &OnFinished, &Segment](int32 Offset, int32 Count)
+				{
+					const EFadeState SegmentState = State;
+					const int32 FinishedFrame = Segment(Offset, Count);
+					if (FinishedFrame >= 0)
+					{
+						OnFinished(Offset + FinishedFrame, SegmentState == EFadeState::FadingIn ? EFadeDirection::In : EFadeDirection::Out);
+					}
+				},
+				[this](const FFadeCommand& Command)
+				{
+					ApplyCommand(Command);
+				});
+		}
+
+		EFadeState State = EFadeState::Holding;
+		float Value = 0.0f;
+		float StartValue = 0.0f;
+		float Step = 0.0f;
+		int32 NumFadeFrames = 0;
+		int32 FadePosition = 0;
+		bool bBufferSettled = false;
+	};
+}
@@ -0,0 +1,269 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved.
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+#include "MSUtilsDSP/GainKernels.h"
+
+namespace MSUtilsDSP
+{
+	enum class EFadeDirection : uint8
+	{
+		In,
+		Out
+	};
+
+	enum class EFadeEventType : uint8
+	{
+		// Starts the fade, or changes the length of a fade that is already running
+		Start,
+		// Stops any running fade and snaps back to the rest value
+		Reset
+	};
+
+	// A trigger landing on a given frame of the block being rendered
+	struct FFadeEvent
+	{
+		int32 Frame = 0;
+		EFadeEventType Type = EFadeEventType::Start;
+		// Length of the fade in samples, for Start events
+		float FadeSamples = 0.0f;
+	};
+
+	// Longest fade, about 6 hours at 48 kHz. Keeps every frame count worked out from a fade length within int32.
+	constexpr float MaxFadeSamples = 1073741824.0f;
+
+	// Fade lengths come from a user time pin, so NaN and negative lengths are read as 0 and huge ones are capped
+	inline float ClampFadeSamples(float FadeSamples)
+	{
+		return FadeSamples > 0.0f ? std::min(FadeSamples, MaxFadeSamples) : 0.0f;
+	}
+
+	// Splits a block at the frame of each event (sorted by frame). Segment(Offset, Count) is called for the frames
+	// between events and ApplyEvent(Event) on the frame each event lands on, so an event takes effect on its own frame.
+	template<typename EventType, typename SegmentType, typename ApplyEventType>
+	void ForEachEventSegment(int32 NumFrames, const EventType* Events, int32 NumEvents, SegmentType&& Segment, ApplyEventType&& ApplyEvent)
+	{
+		int32 Cursor = 0;
+		for (int32 EventIndex = 0; EventIndex <= NumEvents; ++EventIndex)
+		{
+			const int32 SegmentEnd = EventIndex < NumEvents ? std::min(std::max(Events[EventIndex].Frame, Cursor), NumFrames) : NumFrames;
+			if (SegmentEnd > Cursor)
+			{
+				Segment(Cursor, SegmentEnd - Cursor);
+				Cursor = SegmentEnd;
+			}
+
+			if (EventIndex < NumEvents)
+			{
+				ApplyEvent(Events[EventIndex]);
+			}
+		}
+	}
+
+	// Sample accurate linear fade behind the Simple Fade In/Out and Fade Audio In/Out nodes. A fade started on frame T
+	// is at its rest value on T and reaches its end value, and reports finishing, exactly FadeSamples frames later.
+	class FFadeEnvelope
+	{
+	public:
+		explicit FFadeEnvelope(EFadeDirection InDirection)
+			: Direction(InDirection)
+			, Value(InDirection == EFadeDirection::In ? 0.0f : 1.0f)
+		{
+		}
+
+		// The value the envelope rests at before a fade has run (0 for fade in, 1 for fade out)
+		float GetRestValue() const
+		{
+			return Direction == EFadeDirection::In ? 0.0f : 1.0f;
+		}
+
+		float GetEndValue() const
+		{
+			return 1.0f - GetRestValue();
+		}
+
+		// Value of the last frame rendered
+		float GetValue() const
+		{
+			return Value;
+		}
+
+		bool IsFading() const
+		{
+			return bProcessFade;
+		}
+
+		// True once the envelope rests at exactly 0, so anything it scales is silent until the next fade or reset
+		bool IsSilent() const
+		{
+			return !bProcessFade && Value == 0.0f;
+		}
+
+		void Reset()
+		{
+			bProcessFade = false;
+			bBufferSettled = false;
+			Value = GetRestValue();
+			FadePosition = 0;
+		}
+
+		// Starting while a fade is already running keeps its progress and only changes the length.
+		void Start(float InFadeSamples)
+		{
+			bProcessFade = true;
+			FadeSamples = ClampFadeSamples(InFadeSamples);
+		}
+
+		// Renders NumFrames of the envelope. Returns the frame the fade finished on, or -1 if it did not finish.
+		int32 Render(float* OutBuffer, int32 NumFrames)
+		{
+			return Advance(NumFrames,
+				[OutBuffer](int32 Offset, int32 Count, float StartValue, float Increment)
+				{
+					FillLinear(OutBuffer + Offset, Count, StartValue, Increment);
+				},
+				[OutBuffer](int32 Offset, int32 Count, float Constant)
+				{
+					FillConstant(OutBuffer + Offset, Count, Constant);
+				});
+		}
+
+		// Out = In * envelope for NumFrames, without writing the envelope anywhere. Returns as Render.
+		int32 Apply(const float* InBuffer, float* OutBuffer, int32 NumFrames)
+		{
+			return Advance(NumFrames,
+				[InBuffer, OutBuffer](int32 Offset, int32 Count, float StartValue, float Increment)
+				{
+					MultiplyLinear(InBuffer + Offset, OutBuffer + Offset, Count, StartValue, Increment);
+				},
+				[InBuffer, OutBuffer](int32 Offset, int32 Count, float Constant)
+				{
+					ScaleRamp(InBuffer + Offset, OutBuffer + Offset, Count, Constant, Constant);
+				});
+		}
+
+		// Renders a whole block, applying Events (sorted by frame) on the frames they land on.
+		// OnFinished(Frame) is called for every frame a fade finishes on. OutBuffer is expected to be the same
+		// buffer every block, which lets a settled envelope skip rewriting values it already holds.
+		template<typename OnFinishedType>
+		void RenderBlock(float* OutBuffer, int32 NumFrames, const FFadeEvent* Events, int32 NumEvents, OnFinishedType OnFinished)
+		{
+			const bool bSettled = NumEvents == 0 && !bProcessFade;
+			if (bSettled && bBufferSettled)
+			{
+				return;
+			}
+			bBufferSettled = bSettled;
+
+			ProcessEvents(NumFrames, Events, NumEvents, OnFinished,
+				[this, OutBuffer](int32 Offset, int32 Count)
+				{
+					return Render(OutBuffer + Offset, Count);
+				});
+		}
+
+		// RenderBlock fused with the multiply: writes In * envelope to OutBuffer in a single pass. Once settled the
+		// audio is copied straight through at 1, and a silent output is only cleared on the first settled block.
+		template<typename OnFinishedType>
+		void ApplyBlock(const float* InBuffer, float* OutBuffer, int32 NumFrames, const FFadeEvent* Events, int32 NumEvents, OnFinishedType OnFinished)
+		{
+			if (NumEvents == 0 && !bProcessFade)
+			{
+				if (Value == 0.0f)
+				{
+					if (!bBufferSettled)
+					{
+						ZeroBuffer(OutBuffer, NumFrames);
+						bBufferSettled = true;
+					}
+					return;
+				}
+
+				bBufferSettled = false;
+				ScaleRamp(InBuffer, OutBuffer, NumFrames, Value, Value);
+				return;
+			}
+			bBufferSettled = false;
+
+			ProcessEvents(NumFrames, Events, NumEvents, OnFinished,
+				[this, InBuffer, OutBuffer](int32 Offset, int32 Count)
+				{
+					return Apply(InBuffer + Offset, OutBuffer + Offset, Count);
+				});
+		}
+
+	private:
+		// Steps the fade on by NumFrames. Ramp(Offset, Count, StartValue, Increment) is called for the frames still
+		// fading and Constant(Offset, Count, Value) for the frames at rest or after the fade lands.
+		template<typename RampType, typename ConstantType>
+		int32 Advance(int32 NumFrames, RampType&& Ramp, ConstantType&& Constant)
+		{
+			if (!bProcessFade)
+			{
+				Constant(0, NumFrames, Value);
+				return -1;
+			}
+
+			const int32 FramesRemaining = (int32)std::ceil(FadeSamples - (float)FadePosition);
+			const int32 NumRampFrames = std::max(0, std::min(FramesRemaining, NumFrames));
+
+			if (NumRampFrames > 0)
+			{
+				const float Increment = 1.0f / FadeSamples;
+				const float Progress = (float)FadePosition * Increment;
+				const float StartValue = Direction == EFadeDirection::In ? Progress : 1.0f - Progress;
+				const float Step = Direction == EFadeDirection::In ? Increment : -Increment;
+				Ramp(0, NumRampFrames, StartValue, Step);
+
+				FadePosition += NumRampFrames;
+				Value = StartValue + Step * (float)(NumRampFrames - 1);
+			}
+
+			if (NumRampFrames == NumFrames)
+			{
+				return -1;
+			}
+
+			// The fade lands on its end value within this block
+			bProcessFade = false;
+			FadePosition = 0;
+			Value = GetEndValue();
+			Constant(NumRampFrames, NumFrames - NumRampFrames, Value);
+			return NumRampFrames;
+		}
+
+		// Runs Segment over the frames between events, reporting any fade that finishes within them
+		template<typename OnFinishedType, typename SegmentType>
+		void ProcessEvents(int32 NumFrames, const FFadeEvent* Events, int32 NumEvents, OnFinishedType& OnFinished, SegmentType&& Segment)
+		{
+			ForEachEventSegment(NumFrames, Events, NumEvents,
+				[&OnFinished, &Segment](int32 Offset, int32 Count)
+				{
+					const int32 FinishedFrame = Segment(Offset, Count);
+					if (FinishedFrame >= 0)
+					{
+						OnFinished(Offset + FinishedFrame);
+					}
+				},
+				[this](const FFadeEvent& Event)
+				{
+					if (Event.Type == EFadeEventType::Reset)
+					{
+						Reset();
+					}
+					else
+					{
+						Start(Event.FadeSamples);
+					}
+				});
+		}
+
+		EFadeDirection Direction;
+		float Value = 0.0f;
+		float FadeSamples = 0.0f;
+		int32 FadePosition = 0;
+		bool bProcessFade = false;
+		bool bBufferSettled = false;
+	};
+}
@@ -0,0 +1,187 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+#include "MSUtilsDSP/GainKernelsNeon.h"
+#include "MSUtilsDSP/GainKernelsScalar.h"
+#include "MSUtilsDSP/GainKernelsX86.h"
+
+#include <atomic>
+
+#if MSUTILS_SIMD_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace MSUtilsDSP
+{
+	enum class ESimdLevel : uint8
+	{
+		Scalar,
+		// 128 bit x86. Only needs SSE2, so it is the x86-64 baseline.
+		SSE,
+		AVX2,
+		AVX512,
+		NEON
+	};
+
+	inline const char* GetSimdLevelName(ESimdLevel Level)
+	{
+		switch (Level)
+		{
+		case ESimdLevel::SSE: return "SSE";
+		case ESimdLevel::AVX2: return "AVX2";
+		case ESimdLevel::AVX512: return "AVX-512";
+		case ESimdLevel::NEON: return "NEON";
+		default: return "Scalar";
+		}
+	}
+
+	// The loops in GainKernels.h that every mix and fade runs through, for one instruction set
+	struct FGainKernelTable
+	{
+		void (*FillLinear)(float* OutBuffer, int32 NumFrames, float StartValue, float Increment);
+		void (*ScaleLinear)(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float Increment);
+		void (*MixInLinear)(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float Increment);
+		void (*MixPairLinear)(const float* InBufferA, const float* InBufferB, float* OutBuffer, int32 NumFrames, float StartGainA, float IncrementA, float StartGainB, float IncrementB);
+		void (*Multiply)(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames);
+		void (*MixInMultiplied)(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames);
+	};
+
+	inline constexpr FGainKernelTable ScalarGainKernelTable = { &ScalarKernels::FillLinear, &ScalarKernels::ScaleLinear, &ScalarKernels::MixInLinear,
+		&ScalarKernels::MixPairLinear, &ScalarKernels::Multiply, &ScalarKernels::MixInMultiplied };
+
+#if MSUTILS_SIMD_X86
+	inline constexpr FGainKernelTable SseGainKernelTable = { &SseKernels::FillLinear, &SseKernels::ScaleLinear, &SseKernels::MixInLinear,
+		&SseKernels::MixPairLinear, &SseKernels::Multiply, &SseKernels::MixInMultiplied };
+	inline constexpr FGainKernelTable Avx2GainKernelTable = { &Avx2Kernels::FillLinear, &Avx2Kernels::ScaleLinear, &Avx2Kernels::MixInLinear,
+		&Avx2Kernels::MixPairLinear, &Avx2Kernels::Multiply, &Avx2Kernels::MixInMultiplied };
+	inline constexpr FGainKernelTable Avx512GainKernelTable = { &Avx512Kernels::FillLinear, &Avx512Kernels::ScaleLinear, &Avx512Kernels::MixInLinear,
+		&Avx512Kernels::MixPairLinear, &Avx512Kernels::Multiply, &Avx512Kernels::MixInMultiplied };
+#endif
+
+#if MSUTILS_SIMD_NEON
+	inline constexpr FGainKernelTable NeonGainKernelTable = { &NeonKernels::FillLinear, &NeonKernels::ScaleLinear, &NeonKernels::MixInLinear,
+		&NeonKernels::MixPairLinear, &NeonKernels::Multiply, &NeonKernels::MixInMultiplied };
+#endif
+
+	// True if this build has kernels for Level and the CPU (and OS) it is running on can execute them
+	inline bool IsSimdLevelSupported(ESimdLevel Level)
+	{
+		switch (Level)
+		{
+		case ESimdLevel::Scalar:
+			return true;
+
+#if MSUTILS_SIMD_X86
+		case ESimdLevel::SSE:
+			return true;
+
+		case ESimdLevel::AVX2:
+		case ESimdLevel::AVX512:
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			int32 CpuInfo[4];
+			__cpuid(CpuInfo, 0);
+			if (CpuInfo[0] < 7)
+			{
+				return false;
+			}
+
+			// The OS has to save the wider registers on a context switch as well as the CPU supporting them
+			__cpuid(CpuInfo, 1);
+			const bool bOSXSave = (CpuInfo[2] & (1 << 27)) != 0;
+			const bool bAVX = (CpuInfo[2] & (1 << 28)) != 0;
+			if (!bOSXSave || !bAVX)
+			{
+				return false;
+			}
+			const unsigned long long EnabledState = _xgetbv(0);
+
+			__cpuidex(CpuInfo, 7, 0);
+			if (Level == ESimdLevel::AVX2)
+			{
+				return (EnabledState & 0x6) == 0x6 && (CpuInfo[1] & (1 << 5)) != 0;
+			}
+			return (EnabledState & 0xE6) == 0xE6 && (CpuInfo[1] & (1 << 16)) != 0;
+#else
+			// Checks the OS enables the registers as well as the CPU feature bit
+			__builtin_cpu_init();
+			return Level == ESimdLevel::AVX2 ? __builtin_cpu_supports("avx2") != 0 : __builtin_cpu_supports("avx512f") != 0;
+#endif
+		}
+#endif
+
+#if MSUTILS_SIMD_NEON
+		case ESimdLevel::NEON:
+			return true;
+#endif
+
+		default:
+			return false;
+		}
+	}
+
+	// The widest supported instruction set
+	inline ESimdLevel GetBestSimdLevel()
+	{
+		for (const ESimdLevel Level : { ESimdLevel::AVX512, ESimdLevel::AVX2, ESimdLevel::SSE, ESimdLevel::NEON })
+		{
+			if (IsSimdLevelSupported(Level))
+			{
+				return Level;
+			}
+		}
+		return ESimdLevel::Scalar;
+	}
+
+	// Kernels for Level. Falls back to the scalar kernels for a level this build has none for.
+	inline const FGainKernelTable& GetGainKernelTable(ESimdLevel Level)
+	{
+		switch (Level)
+		{
+#if MSUTILS_SIMD_X86
+		case ESimdLevel::SSE: return SseGainKernelTable;
+		case ESimdLevel::AVX2: return Avx2GainKernelTable;
+		case ESimdLevel::AVX512: return Avx512GainKernelTable;
+#endif
+#if MSUTILS_SIMD_NEON
+		case ESimdLevel::NEON: return NeonGainKernelTable;
+#endif
+		default: return ScalarGainKernelTable;
+		}
+	}
+
+	namespace GainKernelDispatchPrivate
+	{
+		// Constant initialized, so the scalar kernels are in place before any static constructor could run audio
+		inline std::atomic<const FGainKernelTable*> ActiveTable{ &ScalarGainKernelTable };
+		inline std::atomic<ESimdLevel> ActiveLevel{ ESimdLevel::Scalar };
+	}
+
+	// Kernels the GainKernels.h functions currently run
+	inline const FGainKernelTable& GetActiveGainKernels()
+	{
+		return *GainKernelDispatchPrivate::ActiveTable.load(std::memory_order_relaxed);
+	}
+
+	inline ESimdLevel GetActiveSimdLevel()
+	{
+		return GainKernelDispatchPrivate::ActiveLevel.load(std::memory_order_relaxed);
+	}
+
+	// Switches every mix and fade to Level, or to scalar if Level is not supported here. Returns the level in use.
+	inline ESimdLevel SetActiveSimdLevel(ESimdLevel Level)
+	{
+		const ESimdLevel Applied = IsSimdLevelSupported(Level) ? Level : ESimdLevel::Scalar;
+		GainKernelDispatchPrivate::ActiveTable.store(&GetGainKernelTable(Applied), std::memory_order_relaxed);
+		GainKernelDispatchPrivate::ActiveLevel.store(Applied, std::memory_order_relaxed);
+		return Applied;
+	}
+
+	// Picks the widest kernels the CPU supports. Called once at module startup, before any audio renders.
+	inline ESimdLevel InitSimdKernels()
+	{
+		return SetActiveSimdLevel(GetBestSimdLevel());
+	}
+}
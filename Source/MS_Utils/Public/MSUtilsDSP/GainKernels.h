@@ -0,0 +1,153 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+#include "MSUtilsDSP/GainKernelDispatch.h"
+
+#include <cstring>
+
+namespace MSUtilsDSP
+{
+	//Buffer kernels used by the crossfade and fade operators. Ramps follow Audio::ArrayMixIn/ArrayFade:
+	//the gain at frame i is StartGain + i * (EndGain - StartGain) / NumFrames, so the end gain is reached on the next block.
+	//The per-frame loops run through the SIMD kernels picked by InitSimdKernels (see GainKernelDispatch.h).
+
+	inline void ZeroBuffer(float* OutBuffer, int32 NumFrames)
+	{
+		std::memset(OutBuffer, 0, sizeof(float) * NumFrames);
+	}
+
+	inline void CopyBuffer(const float* InBuffer, float* OutBuffer, int32 NumFrames)
+	{
+		std::memcpy(OutBuffer, InBuffer, sizeof(float) * NumFrames);
+	}
+
+	inline void FillConstant(float* OutBuffer, int32 NumFrames, float Value)
+	{
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			OutBuffer[i] = Value;
+		}
+	}
+
+	// Out = StartValue + Increment * i. Each frame is computed from its index rather than accumulated, so there is
+	// no loop carried dependency and it vectorizes.
+	inline void FillLinear(float* OutBuffer, int32 NumFrames, float StartValue, float Increment)
+	{
+		GetActiveGainKernels().FillLinear(OutBuffer, NumFrames, StartValue, Increment);
+	}
+
+	// Out = In * (StartGain + Increment * i), the audio rate counterpart of FillLinear
+	inline void MultiplyLinear(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float Increment)
+	{
+		GetActiveGainKernels().ScaleLinear(InBuffer, OutBuffer, NumFrames, StartGain, Increment);
+	}
+
+	// Out = StartValue ramping towards EndValue over the block
+	inline void FillRamp(float* OutBuffer, int32 NumFrames, float StartValue, float EndValue)
+	{
+		if (StartValue == EndValue)
+		{
+			FillConstant(OutBuffer, NumFrames, EndValue);
+			return;
+		}
+
+		FillLinear(OutBuffer, NumFrames, StartValue, (EndValue - StartValue) / (float)NumFrames);
+	}
+
+	// A zero increment leaves the gain exactly Gain on every frame
+	inline void MixInConstant(const float* InBuffer, float* OutBuffer, int32 NumFrames, float Gain)
+	{
+		GetActiveGainKernels().MixInLinear(InBuffer, OutBuffer, NumFrames, Gain, 0.0f);
+	}
+
+	// Out = In * Gains, one gain per frame
+	inline void MultiplyBuffers(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames)
+	{
+		GetActiveGainKernels().Multiply(InBuffer, Gains, OutBuffer, NumFrames);
+	}
+
+	// Out += In * Gains, one gain per frame
+	inline void MixInMultiplied(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames)
+	{
+		GetActiveGainKernels().MixInMultiplied(InBuffer, Gains, OutBuffer, NumFrames);
+	}
+
+	// Out += In * Gain, with Gain ramping from StartGain towards EndGain over the block
+	inline void MixInRamp(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float EndGain)
+	{
+		if (IsNearlyEqual(StartGain, EndGain))
+		{
+			MixInConstant(InBuffer, OutBuffer, NumFrames, EndGain);
+			return;
+		}
+
+		GetActiveGainKernels().MixInLinear(InBuffer, OutBuffer, NumFrames, StartGain, (EndGain - StartGain) / (float)NumFrames);
+	}
+
+	// Out = In * Gain, with Gain ramping from StartGain towards EndGain over the block. Writes rather than
+	// accumulates, so the first input of a mix needs no zeroing pass. A settled gain of 1 or 0 is a plain copy or clear.
+	inline void ScaleRamp(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float EndGain)
+	{
+		const bool bSettled = IsNearlyEqual(StartGain, EndGain);
+		if (bSettled && EndGain == 1.0f)
+		{
+			if (InBuffer != OutBuffer)
+			{
+				CopyBuffer(InBuffer, OutBuffer, NumFrames);
+			}
+			return;
+		}
+		if (bSettled && EndGain == 0.0f)
+		{
+			ZeroBuffer(OutBuffer, NumFrames);
+			return;
+		}
+
+		const float Delta = bSettled ? 0.0f : (EndGain - StartGain) / (float)NumFrames;
+		const float Start = bSettled ? EndGain : StartGain;
+		GetActiveGainKernels().ScaleLinear(InBuffer, OutBuffer, NumFrames, Start, Delta);
+	}
+
+	// Out = InA * GainA + InB * GainB, each gain ramping over the block, in a single pass over the output.
+	// If either input is silent for the whole block this is just ScaleRamp of the other.
+	inline void MixPairRamp(const float* InBufferA, const float* InBufferB, float* OutBuffer, int32 NumFrames, float StartGainA, float EndGainA, float StartGainB, float EndGainB)
+	{
+		if (StartGainB == 0.0f && EndGainB == 0.0f)
+		{
+			ScaleRamp(InBufferA, OutBuffer, NumFrames, StartGainA, EndGainA);
+			return;
+		}
+		if (StartGainA == 0.0f && EndGainA == 0.0f)
+		{
+			ScaleRamp(InBufferB, OutBuffer, NumFrames, StartGainB, EndGainB);
+			return;
+		}
+
+		const float DeltaA = IsNearlyEqual(StartGainA, EndGainA) ? 0.0f : (EndGainA - StartGainA) / (float)NumFrames;
+		const float DeltaB = IsNearlyEqual(StartGainB, EndGainB) ? 0.0f : (EndGainB - StartGainB) / (float)NumFrames;
+		const float StartA = DeltaA == 0.0f ? EndGainA : StartGainA;
+		const float StartB = DeltaB == 0.0f ? EndGainB : StartGainB;
+		GetActiveGainKernels().MixPairLinear(InBufferA, InBufferB, OutBuffer, NumFrames, StartA, DeltaA, StartB, DeltaB);
+	}
+
+	// InOut *= Gain, with Gain ramping from StartGain towards EndGain over the block
+	inline void FadeRamp(float* InOutBuffer, int32 NumFrames, float StartGain, float EndGain)
+	{
+		if (IsNearlyEqual(StartGain, EndGain))
+		{
+			if (EndGain == 0.0f)
+			{
+				ZeroBuffer(InOutBuffer, NumFrames);
+			}
+			else if (EndGain != 1.0f)
+			{
+				GetActiveGainKernels().ScaleLinear(InOutBuffer, InOutBuffer, NumFrames, EndGain, 0.0f);
+			}
+			return;
+		}
+
+		GetActiveGainKernels().ScaleLinear(InOutBuffer, InOutBuffer, NumFrames, StartGain, (EndGain - StartGain) / (float)NumFrames);
+	}
+}
@@ -0,0 +1,145 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM64EC)
+#define MSUTILS_SIMD_NEON 1
+#else
+#define MSUTILS_SIMD_NEON 0
+#endif
+
+#if MSUTILS_SIMD_NEON
+
+#include <arm_neon.h>
+
+MSUTILS_FP_CONTRACT_OFF_BEGIN
+
+namespace MSUtilsDSP
+{
+	//NEON versions of ScalarKernels. NEON is part of every AArch64 CPU, so there is nothing to detect. Multiplies and
+	//adds are written separately (no vfma), the same operations in the same order as the scalar loops. vmulq_f32 and
+	//vaddq_f32 are plain vector arithmetic to the compiler, so they rely on contraction being off like the scalar
+	//loops do. The FP contract test covers them when the suite is built on an AArch64 host.
+	namespace NeonKernels
+	{
+		alignas(16) inline constexpr float FrameIndices[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+
+		inline void FillLinear(float* OutBuffer, int32 NumFrames, float StartValue, float Increment)
+		{
+			const float32x4_t Start = vdupq_n_f32(StartValue);
+			const float32x4_t Step = vdupq_n_f32(Increment);
+			const float32x4_t Width = vdupq_n_f32(4.0f);
+			float32x4_t Frame = vld1q_f32(FrameIndices);
+
+			int32 i = 0;
+			for (; i + 4 <= NumFrames; i += 4)
+			{
+				vst1q_f32(OutBuffer + i, vaddq_f32(Start, vmulq_f32(Step, Frame)));
+				Frame = vaddq_f32(Frame, Width);
+			}
+			for (; i < NumFrames; ++i)
+			{
+				OutBuffer[i] = StartValue + Increment * (float)i;
+			}
+		}
+
+		inline void ScaleLinear(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float Increment)
+		{
+			const float32x4_t Start = vdupq_n_f32(StartGain);
+			const float32x4_t Step = vdupq_n_f32(Increment);
+			const float32x4_t Width = vdupq_n_f32(4.0f);
+			float32x4_t Frame = vld1q_f32(FrameIndices);
+
+			int32 i = 0;
+			for (; i + 4 <= NumFrames; i += 4)
+			{
+				const float32x4_t Gain = vaddq_f32(Start, vmulq_f32(Step, Frame));
+				vst1q_f32(OutBuffer + i, vmulq_f32(vld1q_f32(InBuffer + i), Gain));
+				Frame = vaddq_f32(Frame, Width);
+			}
+			for (; i < NumFrames; ++i)
+			{
+				OutBuffer[i] = InBuffer[i] * (StartGain + Increment * (float)i);
+			}
+		}
+
+		inline void MixInLinear(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float Increment)
+		{
+			const float32x4_t Start = vdupq_n_f32(StartGain);
+			const float32x4_t Step = vdupq_n_f32(Increment);
+			const float32x4_t Width = vdupq_n_f32(4.0f);
+			float32x4_t Frame = vld1q_f32(FrameIndices);
+
+			int32 i = 0;
+			for (; i + 4 <= NumFrames; i += 4)
+			{
+				const float32x4_t Gain = vaddq_f32(Start, vmulq_f32(Step, Frame));
+				const float32x4_t Scaled = vmulq_f32(vld1q_f32(InBuffer + i), Gain);
+				vst1q_f32(OutBuffer + i, vaddq_f32(vld1q_f32(OutBuffer + i), Scaled));
+				Frame = vaddq_f32(Frame, Width);
+			}
+			for (; i < NumFrames; ++i)
+			{
+				OutBuffer[i] += InBuffer[i] * (StartGain + Increment * (float)i);
+			}
+		}
+
+		inline void MixPairLinear(const float* InBufferA, const float* InBufferB, float* OutBuffer, int32 NumFrames, float StartGainA, float IncrementA, float StartGainB, float IncrementB)
+		{
+			const float32x4_t StartA = vdupq_n_f32(StartGainA);
+			const float32x4_t StepA = vdupq_n_f32(IncrementA);
+			const float32x4_t StartB = vdupq_n_f32(StartGainB);
+			const float32x4_t StepB = vdupq_n_f32(IncrementB);
+			const float32x4_t Width = vdupq_n_f32(4.0f);
+			float32x4_t Frame = vld1q_f32(FrameIndices);
+
+			int32 i = 0;
+			for (; i + 4 <= NumFrames; i += 4)
+			{
+				const float32x4_t GainA = vaddq_f32(StartA, vmulq_f32(StepA, Frame));
+				const float32x4_t GainB = vaddq_f32(StartB, vmulq_f32(StepB, Frame));
+				const float32x4_t ScaledA = vmulq_f32(vld1q_f32(InBufferA + i), GainA);
+				const float32x4_t ScaledB = vmulq_f32(vld1q_f32(InBufferB + i), GainB);
+				vst1q_f32(OutBuffer + i, vaddq_f32(ScaledA, ScaledB));
+				Frame = vaddq_f32(Frame, Width);
+			}
+			for (; i < NumFrames; ++i)
+			{
+				const float FrameIndex = (float)i;
+				OutBuffer[i] = InBufferA[i] * (StartGainA + IncrementA * FrameIndex) + InBufferB[i] * (StartGainB + IncrementB * FrameIndex);
+			}
+		}
+
+		inline void Multiply(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames)
+		{
+			int32 i = 0;
+			for (; i + 4 <= NumFrames; i += 4)
+			{
+				vst1q_f32(OutBuffer + i, vmulq_f32(vld1q_f32(InBuffer + i), vld1q_f32(Gains + i)));
+			}
+			for (; i < NumFrames; ++i)
+			{
+				OutBuffer[i] = InBuffer[i] * Gains[i];
+			}
+		}
+
+		inline void MixInMultiplied(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames)
+		{
+			int32 i = 0;
+			for (; i + 4 <= NumFrames; i += 4)
+			{
+				const float32x4_t Scaled = vmulq_f32(vld1q_f32(InBuffer + i), vld1q_f32(Gains + i));
+				vst1q_f32(OutBuffer + i, vaddq_f32(vld1q_f32(OutBuffer + i), Scaled));
+			}
+			for (; i < NumFrames; ++i)
+			{
+				OutBuffer[i] += InBuffer[i] * Gains[i];
+			}
+		}
+	}
+}
+MSUTILS_FP_CONTRACT_OFF_END
+
+#endif
@@ -0,0 +1,72 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+
+MSUTILS_FP_CONTRACT_OFF_BEGIN
+
+namespace MSUtilsDSP
+{
+	//Portable versions of the loops every mix and fade goes through. These are the reference the SIMD kernels are
+	//checked against: each SIMD kernel does the same float operations in the same order, and contraction is off for
+	//all of them, so their output is bit for bit the same.
+	namespace ScalarKernels
+	{
+		// Out = StartValue + Increment * i
+		inline void FillLinear(float* OutBuffer, int32 NumFrames, float StartValue, float Increment)
+		{
+			for (int32 i = 0; i < NumFrames; ++i)
+			{
+				OutBuffer[i] = StartValue + Increment * (float)i;
+			}
+		}
+
+		// Out = In * (StartGain + Increment * i). In and Out may be the same buffer.
+		inline void ScaleLinear(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float Increment)
+		{
+			for (int32 i = 0; i < NumFrames; ++i)
+			{
+				OutBuffer[i] = InBuffer[i] * (StartGain + Increment * (float)i);
+			}
+		}
+
+		// Out += In * (StartGain + Increment * i)
+		inline void MixInLinear(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float Increment)
+		{
+			for (int32 i = 0; i < NumFrames; ++i)
+			{
+				OutBuffer[i] += InBuffer[i] * (StartGain + Increment * (float)i);
+			}
+		}
+
+		// Out = InA * (StartGainA + IncrementA * i) + InB * (StartGainB + IncrementB * i)
+		inline void MixPairLinear(const float* InBufferA, const float* InBufferB, float* OutBuffer, int32 NumFrames, float StartGainA, float IncrementA, float StartGainB, float IncrementB)
+		{
+			for (int32 i = 0; i < NumFrames; ++i)
+			{
+				const float Frame = (float)i;
+				OutBuffer[i] = InBufferA[i] * (StartGainA + IncrementA * Frame) + InBufferB[i] * (StartGainB + IncrementB * Frame);
+			}
+		}
+
+		// Out = In * Gains
+		inline void Multiply(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames)
+		{
+			for (int32 i = 0; i < NumFrames; ++i)
+			{
+				OutBuffer[i] = InBuffer[i] * Gains[i];
+			}
+		}
+
+		// Out += In * Gains
+		inline void MixInMultiplied(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames)
+		{
+			for (int32 i = 0; i < NumFrames; ++i)
+			{
+				OutBuffer[i] += InBuffer[i] * Gains[i];
+			}
+		}
+	}
+}
+MSUTILS_FP_CONTRACT_OFF_END
@@ -0,0 +1,75 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+
+#if defined(__x86_64__) || (defined(_M_X64) && !defined(_M_ARM64EC))
+#define MSUTILS_SIMD_X86 1
+#else
+#define MSUTILS_SIMD_X86 0
+#endif
+
+#if MSUTILS_SIMD_X86
+
+#include <immintrin.h>
+
+// GCC and Clang only allow an instruction set's intrinsics in functions that enable it, so the kernels can be
+// compiled into a module built for the x86-64 baseline and picked at runtime. MSVC allows them anywhere.
+#if defined(__GNUC__) || defined(__clang__)
+#define MSUTILS_SIMD_TARGET_SSE
+#define MSUTILS_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define MSUTILS_SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define MSUTILS_SIMD_TARGET_SSE
+#define MSUTILS_SIMD_TARGET_AVX2
+#define MSUTILS_SIMD_TARGET_AVX512
+#endif
+
+MSUTILS_FP_CONTRACT_OFF_BEGIN
+
+namespace MSUtilsDSP
+{
+	// Loaded as the first vector of frame indices by every ramp kernel
+	alignas(64) inline constexpr float SimdFrameIndices[16] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f };
+
+	// 128 bit kernels. These only need SSE2, so they are always available on x86-64.
+#define MSUTILS_SIMD_NAMESPACE SseKernels
+#define MSUTILS_SIMD_TARGET MSUTILS_SIMD_TARGET_SSE
+#define MSUTILS_SIMD_VEC __m128
+#define MSUTILS_SIMD_OP(Name) _mm_##Name
+#define MSUTILS_SIMD_WIDTH 4
+#include "MSUtilsDSP/GainKernelsX86.inl"
+#undef MSUTILS_SIMD_NAMESPACE
+#undef MSUTILS_SIMD_TARGET
+#undef MSUTILS_SIMD_VEC
+#undef MSUTILS_SIMD_OP
+#undef MSUTILS_SIMD_WIDTH
+
+#define MSUTILS_SIMD_NAMESPACE Avx2Kernels
+#define MSUTILS_SIMD_TARGET MSUTILS_SIMD_TARGET_AVX2
+#define MSUTILS_SIMD_VEC __m256
+#define MSUTILS_SIMD_OP(Name) _mm256_##Name
+#define MSUTILS_SIMD_WIDTH 8
+#include "MSUtilsDSP/GainKernelsX86.inl"
+#undef MSUTILS_SIMD_NAMESPACE
+#undef MSUTILS_SIMD_TARGET
+#undef MSUTILS_SIMD_VEC
+#undef MSUTILS_SIMD_OP
+#undef MSUTILS_SIMD_WIDTH
+
+#define MSUTILS_SIMD_NAMESPACE Avx512Kernels
+#define MSUTILS_SIMD_TARGET MSUTILS_SIMD_TARGET_AVX512
+#define MSUTILS_SIMD_VEC __m512
+#define MSUTILS_SIMD_OP(Name) _mm512_##Name
+#define MSUTILS_SIMD_WIDTH 16
+#include "MSUtilsDSP/GainKernelsX86.inl"
+#undef MSUTILS_SIMD_NAMESPACE
+#undef MSUTILS_SIMD_TARGET
+#undef MSUTILS_SIMD_VEC
+#undef MSUTILS_SIMD_OP
+#undef MSUTILS_SIMD_WIDTH
+}
+MSUTILS_FP_CONTRACT_OFF_END
+
+#endif
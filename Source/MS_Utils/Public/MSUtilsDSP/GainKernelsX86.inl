@@ -0,0 +1,126 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+// Body of the x86 gain kernels, included once per instruction set by GainKernelsX86.h with:
+//   MSUTILS_SIMD_NAMESPACE  namespace the kernels are declared in
+//   MSUTILS_SIMD_TARGET     function attribute enabling the instruction set
+//   MSUTILS_SIMD_VEC        vector type
+//   MSUTILS_SIMD_OP(Name)   intrinsic of that width, e.g. MSUTILS_SIMD_OP(add_ps)
+//   MSUTILS_SIMD_WIDTH      floats per vector
+// Frame indices are kept as a float vector that steps by the width each iteration, which is exact for any block
+// size, so every frame's gain is StartGain + Increment * i exactly as ScalarKernels computes it. Tails are scalar.
+
+namespace MSUTILS_SIMD_NAMESPACE
+{
+	MSUTILS_SIMD_TARGET inline void FillLinear(float* OutBuffer, int32 NumFrames, float StartValue, float Increment)
+	{
+		const MSUTILS_SIMD_VEC Start = MSUTILS_SIMD_OP(set1_ps)(StartValue);
+		const MSUTILS_SIMD_VEC Step = MSUTILS_SIMD_OP(set1_ps)(Increment);
+		const MSUTILS_SIMD_VEC Width = MSUTILS_SIMD_OP(set1_ps)((float)MSUTILS_SIMD_WIDTH);
+		MSUTILS_SIMD_VEC Frame = MSUTILS_SIMD_OP(loadu_ps)(SimdFrameIndices);
+
+		int32 i = 0;
+		for (; i + MSUTILS_SIMD_WIDTH <= NumFrames; i += MSUTILS_SIMD_WIDTH)
+		{
+			MSUTILS_SIMD_OP(storeu_ps)(OutBuffer + i, MSUTILS_SIMD_OP(add_ps)(Start, MSUTILS_SIMD_OP(mul_ps)(Step, Frame)));
+			Frame = MSUTILS_SIMD_OP(add_ps)(Frame, Width);
+		}
+		for (; i < NumFrames; ++i)
+		{
+			OutBuffer[i] = StartValue + Increment * (float)i;
+		}
+	}
+
+	MSUTILS_SIMD_TARGET inline void ScaleLinear(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float Increment)
+	{
+		const MSUTILS_SIMD_VEC Start = MSUTILS_SIMD_OP(set1_ps)(StartGain);
+		const MSUTILS_SIMD_VEC Step = MSUTILS_SIMD_OP(set1_ps)(Increment);
+		const MSUTILS_SIMD_VEC Width = MSUTILS_SIMD_OP(set1_ps)((float)MSUTILS_SIMD_WIDTH);
+		MSUTILS_SIMD_VEC Frame = MSUTILS_SIMD_OP(loadu_ps)(SimdFrameIndices);
+
+		int32 i = 0;
+		for (; i + MSUTILS_SIMD_WIDTH <= NumFrames; i += MSUTILS_SIMD_WIDTH)
+		{
+			const MSUTILS_SIMD_VEC Gain = MSUTILS_SIMD_OP(add_ps)(Start, MSUTILS_SIMD_OP(mul_ps)(Step, Frame));
+			MSUTILS_SIMD_OP(storeu_ps)(OutBuffer + i, MSUTILS_SIMD_OP(mul_ps)(MSUTILS_SIMD_OP(loadu_ps)(InBuffer + i), Gain));
+			Frame = MSUTILS_SIMD_OP(add_ps)(Frame, Width);
+		}
+		for (; i < NumFrames; ++i)
+		{
+			OutBuffer[i] = InBuffer[i] * (StartGain + Increment * (float)i);
+		}
+	}
+
+	MSUTILS_SIMD_TARGET inline void MixInLinear(const float* InBuffer, float* OutBuffer, int32 NumFrames, float StartGain, float Increment)
+	{
+		const MSUTILS_SIMD_VEC Start = MSUTILS_SIMD_OP(set1_ps)(StartGain);
+		const MSUTILS_SIMD_VEC Step = MSUTILS_SIMD_OP(set1_ps)(Increment);
+		const MSUTILS_SIMD_VEC Width = MSUTILS_SIMD_OP(set1_ps)((float)MSUTILS_SIMD_WIDTH);
+		MSUTILS_SIMD_VEC Frame = MSUTILS_SIMD_OP(loadu_ps)(SimdFrameIndices);
+
+		int32 i = 0;
+		for (; i + MSUTILS_SIMD_WIDTH <= NumFrames; i += MSUTILS_SIMD_WIDTH)
+		{
+			const MSUTILS_SIMD_VEC Gain = MSUTILS_SIMD_OP(add_ps)(Start, MSUTILS_SIMD_OP(mul_ps)(Step, Frame));
+			const MSUTILS_SIMD_VEC Scaled = MSUTILS_SIMD_OP(mul_ps)(MSUTILS_SIMD_OP(loadu_ps)(InBuffer + i), Gain);
+			MSUTILS_SIMD_OP(storeu_ps)(OutBuffer + i, MSUTILS_SIMD_OP(add_ps)(MSUTILS_SIMD_OP(loadu_ps)(OutBuffer + i), Scaled));
+			Frame = MSUTILS_SIMD_OP(add_ps)(Frame, Width);
+		}
+		for (; i < NumFrames; ++i)
+		{
+			OutBuffer[i] += InBuffer[i] * (StartGain + Increment * (float)i);
+		}
+	}
+
+	MSUTILS_SIMD_TARGET inline void MixPairLinear(const float* InBufferA, const float* InBufferB, float* OutBuffer, int32 NumFrames, float StartGainA, float IncrementA, float StartGainB, float IncrementB)
+	{
+		const MSUTILS_SIMD_VEC StartA = MSUTILS_SIMD_OP(set1_ps)(StartGainA);
+		const MSUTILS_SIMD_VEC StepA = MSUTILS_SIMD_OP(set1_ps)(IncrementA);
+		const MSUTILS_SIMD_VEC StartB = MSUTILS_SIMD_OP(set1_ps)(StartGainB);
+		const MSUTILS_SIMD_VEC StepB = MSUTILS_SIMD_OP(set1_ps)(IncrementB);
+		const MSUTILS_SIMD_VEC Width = MSUTILS_SIMD_OP(set1_ps)((float)MSUTILS_SIMD_WIDTH);
+		MSUTILS_SIMD_VEC Frame = MSUTILS_SIMD_OP(loadu_ps)(SimdFrameIndices);
+
+		int32 i = 0;
+		for (; i + MSUTILS_SIMD_WIDTH <= NumFrames; i += MSUTILS_SIMD_WIDTH)
+		{
+			const MSUTILS_SIMD_VEC GainA = MSUTILS_SIMD_OP(add_ps)(StartA, MSUTILS_SIMD_OP(mul_ps)(StepA, Frame));
+			const MSUTILS_SIMD_VEC GainB = MSUTILS_SIMD_OP(add_ps)(StartB, MSUTILS_SIMD_OP(mul_ps)(StepB, Frame));
+			const MSUTILS_SIMD_VEC ScaledA = MSUTILS_SIMD_OP(mul_ps)(MSUTILS_SIMD_OP(loadu_ps)(InBufferA + i), GainA);
+			const MSUTILS_SIMD_VEC ScaledB = MSUTILS_SIMD_OP(mul_ps)(MSUTILS_SIMD_OP(loadu_ps)(InBufferB + i), GainB);
+			MSUTILS_SIMD_OP(storeu_ps)(OutBuffer + i, MSUTILS_SIMD_OP(add_ps)(ScaledA, ScaledB));
+			Frame = MSUTILS_SIMD_OP(add_ps)(Frame, Width);
+		}
+		for (; i < NumFrames; ++i)
+		{
+			const float FrameIndex = (float)i;
+			OutBuffer[i] = InBufferA[i] * (StartGainA + IncrementA * FrameIndex) + InBufferB[i] * (StartGainB + IncrementB * FrameIndex);
+		}
+	}
+
+	MSUTILS_SIMD_TARGET inline void Multiply(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames)
+	{
+		int32 i = 0;
+		for (; i + MSUTILS_SIMD_WIDTH <= NumFrames; i += MSUTILS_SIMD_WIDTH)
+		{
+			MSUTILS_SIMD_OP(storeu_ps)(OutBuffer + i, MSUTILS_SIMD_OP(mul_ps)(MSUTILS_SIMD_OP(loadu_ps)(InBuffer + i), MSUTILS_SIMD_OP(loadu_ps)(Gains + i)));
+		}
+		for (; i < NumFrames; ++i)
+		{
+			OutBuffer[i] = InBuffer[i] * Gains[i];
+		}
+	}
+
+	MSUTILS_SIMD_TARGET inline void MixInMultiplied(const float* InBuffer, const float* Gains, float* OutBuffer, int32 NumFrames)
+	{
+		int32 i = 0;
+		for (; i + MSUTILS_SIMD_WIDTH <= NumFrames; i += MSUTILS_SIMD_WIDTH)
+		{
+			const MSUTILS_SIMD_VEC Scaled = MSUTILS_SIMD_OP(mul_ps)(MSUTILS_SIMD_OP(loadu_ps)(InBuffer + i), MSUTILS_SIMD_OP(loadu_ps)(Gains + i));
+			MSUTILS_SIMD_OP(storeu_ps)(OutBuffer + i, MSUTILS_SIMD_OP(add_ps)(MSUTILS_SIMD_OP(loadu_ps)(OutBuffer + i), Scaled));
+		}
+		for (; i < NumFrames; ++i)
+		{
+			OutBuffer[i] += InBuffer[i] * Gains[i];
+		}
+	}
+}
@@ -0,0 +1,346 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+#include "MSUtilsDSP/Denormals.h"
+#include "MSUtilsDSP/GainKernels.h"
+
+#include <array>
+#include <utility>
+
+MSUTILS_FP_CONTRACT_OFF_BEGIN
+
+namespace MSUtilsDSP
+{
+	// Float equivalent of FMath::GetMappedRangeValueClamped. A zero width input range acts as a step at InMax.
+	inline float GetMappedRangeValueClamped(float InMin, float InMax, float OutMin, float OutMax, float Value)
+	{
+		const float Divisor = InMax - InMin;
+		const float Pct = std::fabs(Divisor) <= SmallNumber
+			? (Value >= InMax ? 1.0f : 0.0f)
+			: Clamp((Value - InMin) / Divisor, 0.0f, 1.0f);
+
+		return OutMin + (OutMax - OutMin) * Pct;
+	}
+
+	// Gain of a single Crossfade By Param zone: ramps 0 -> 1 across [FadeInStart, FadeInEnd] and
+	// 1 -> 0 across [FadeOutStart, FadeOutEnd].
+	inline float GetTrapezoidGain(float Value, float FadeInStart, float FadeInEnd, float FadeOutStart, float FadeOutEnd)
+	{
+		const float FadeInValue = GetMappedRangeValueClamped(FadeInStart, FadeInEnd, 0.0f, 1.0f, Value);
+		const float FadeOutValue = GetMappedRangeValueClamped(FadeOutStart, FadeOutEnd, 1.0f, 0.0f, Value);
+		return FadeInValue * FadeOutValue;
+	}
+
+	struct FTrapezoidZone
+	{
+		float FadeInStart = 0.0f;
+		float FadeInEnd = 0.0f;
+		float FadeOutStart = 0.0f;
+		float FadeOutEnd = 0.0f;
+	};
+
+	// The edges of several zones as structure of arrays, one float per zone in each
+	struct FTrapezoidZoneArrays
+	{
+		const float* FadeInStarts = nullptr;
+		const float* FadeInEnds = nullptr;
+		const float* FadeOutStarts = nullptr;
+		const float* FadeOutEnds = nullptr;
+	};
+
+	// GetTrapezoidGain of every zone for the same value, snapped to silence. One loop over contiguous floats with no
+	// branches the compiler cannot turn into selects, so it vectorizes across zones.
+	inline void GetTrapezoidGains(float Value, const FTrapezoidZoneArrays& Zones, float* OutGains, int32 NumZones, float SilenceThreshold)
+	{
+		for (int32 Zone = 0; Zone < NumZones; ++Zone)
+		{
+			OutGains[Zone] = SnapToSilence(GetTrapezoidGain(Value, Zones.FadeInStarts[Zone], Zones.FadeInEnds[Zone], Zones.FadeOutStarts[Zone], Zones.FadeOutEnds[Zone]), SilenceThreshold);
+		}
+	}
+
+	enum class EZoneGainState : uint8
+	{
+		// Gain settled at 0, the output is silent
+		Muted,
+		// Gain settled at 1, the output is the input
+		Unity,
+		// Gain settled somewhere in between
+		Constant,
+		// Gain moving between two values over the block
+		Ramping
+	};
+
+	inline const char* GetZoneGainStateName(EZoneGainState State)
+	{
+		switch (State)
+		{
+		case EZoneGainState::Muted: return "Muted";
+		case EZoneGainState::Unity: return "Unity";
+		case EZoneGainState::Constant: return "Constant";
+		default: return "Ramping";
+		}
+	}
+
+	// Gain state for the Crossfade By Param node. The zone gain is recalculated when the input value moves
+	// and the output ramps from the previous gain to the new one over the block. Each block is one of the
+	// EZoneGainState cases: a muted zone clears the output once and then leaves it alone, a unity zone is a
+	// plain copy, and anything else scales while copying in a single pass. The output buffers are expected to be
+	// the same every block, which is what lets a muted zone skip rewriting silence they already hold.
+	// A zone gain below the silence threshold counts as 0, so a value resting just inside a fade edge mutes.
+	class FMappedRangeFader
+	{
+	public:
+		// Takes effect the next time the input value moves
+		void SetSilenceThreshold(float InThreshold)
+		{
+			SilenceThreshold = InThreshold;
+		}
+
+		// Back to the state it was constructed in, so the next block ramps in from silence. Keeps the threshold.
+		void Reset()
+		{
+			ValuePrev = 0.0f;
+			Amplitude = 0.0f;
+			AmplitudePrev = 0.0f;
+			GainState = EZoneGainState::Muted;
+			bInit = false;
+			bBufferSilent = false;
+		}
+
+		void Process(float Value, const FTrapezoidZone& Zone, const float* InBuffer, float* OutBuffer, int32 NumFrames)
+		{
+			Process(Value, Zone, &InBuffer, &OutBuffer, 1, NumFrames);
+		}
+
+		// Multichannel version, with one planar buffer per channel. The gain state is shared by every channel.
+		void Process(float Value, const FTrapezoidZone& Zone, const float* const* InBuffers, float* const* OutBuffers, int32 NumChannels, int32 NumFrames)
+		{
+			if (Value != ValuePrev || !bInit)
+			{
+				bInit = true;
+				ValuePrev = Value;
+				Amplitude = SnapToSilence(GetTrapezoidGain(Value, Zone.FadeInStart, Zone.FadeInEnd, Zone.FadeOutStart, Zone.FadeOutEnd), SilenceThreshold);
+			}
+
+			if (AmplitudePrev != Amplitude)
+			{
+				GainState = EZoneGainState::Ramping;
+			}
+			else if (Amplitude == 0.0f)
+			{
+				GainState = EZoneGainState::Muted;
+			}
+			else if (Amplitude == 1.0f)
+			{
+				GainState = EZoneGainState::Unity;
+			}
+			else
+			{
+				GainState = EZoneGainState::Constant;
+			}
+
+			if (GainState == EZoneGainState::Muted)
+			{
+				if (!bBufferSilent)
+				{
+					for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+					{
+						ZeroBuffer(OutBuffers[Channel], NumFrames);
+					}
+					bBufferSilent = true;
+				}
+			}
+			else
+			{
+				// ScaleRamp is a plain copy at unity
+				for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+				{
+					ScaleRamp(InBuffers[Channel], OutBuffers[Channel], NumFrames, AmplitudePrev, Amplitude);
+				}
+				bBufferSilent = false;
+			}
+
+			AmplitudePrev = Amplitude;
+		}
+
+		float GetAmplitude() const
+		{
+			return Amplitude;
+		}
+
+		// State of the last block processed
+		EZoneGainState GetGainState() const
+		{
+			return GainState;
+		}
+
+		// True if the last block processed was silent
+		bool IsMuted() const
+		{
+			return GainState == EZoneGainState::Muted;
+		}
+
+	private:
+		float ValuePrev = 0.0f;
+		float Amplitude = 0.0f;
+		float AmplitudePrev = 0.0f;
+		float SilenceThreshold = DefaultSilenceThreshold;
+		EZoneGainState GainState = EZoneGainState::Muted;
+		bool bInit = false;
+		bool bBufferSilent = false;
+	};
+
+	// Crossfade By Param with an input value and zone that can never change, so the gain is worked out once. The first
+	// block ramps in from silence like FMappedRangeFader and every block after is a copy at unity or a single scale.
+	// A zone that is muted from the start needs no processing at all, which IsMuted reports up front.
+	class FFixedZoneFader
+	{
+	public:
+		FFixedZoneFader(float Value, const FTrapezoidZone& Zone, float SilenceThreshold = DefaultSilenceThreshold)
+			: Gain(SnapToSilence(GetTrapezoidGain(Value, Zone.FadeInStart, Zone.FadeInEnd, Zone.FadeOutStart, Zone.FadeOutEnd), SilenceThreshold))
+		{
+		}
+
+		void Process(const float* InBuffer, float* OutBuffer, int32 NumFrames)
+		{
+			Process(&InBuffer, &OutBuffer, 1, NumFrames);
+		}
+
+		void Process(const float* const* InBuffers, float* const* OutBuffers, int32 NumChannels, int32 NumFrames)
+		{
+			const float StartGain = bRampedIn ? Gain : 0.0f;
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				ScaleRamp(InBuffers[Channel], OutBuffers[Channel], NumFrames, StartGain, Gain);
+			}
+			bRampedIn = true;
+		}
+
+		// The next block ramps in from silence again
+		void Reset()
+		{
+			bRampedIn = false;
+		}
+
+		float GetAmplitude() const
+		{
+			return Gain;
+		}
+
+		bool IsMuted() const
+		{
+			return Gain == 0.0f;
+		}
+
+	private:
+		float Gain = 0.0f;
+		bool bRampedIn = false;
+	};
+
+	// Several Crossfade By Param zones driven by one value and summed into one output. Every zone's gain is worked out
+	// in a single GetTrapezoidGains pass each block, so a zone edge that moves takes effect straight away, even while
+	// the value holds still. That is the one difference from a FMappedRangeFader per zone mixed together, which only
+	// looks at its zone when the value moves; with fixed edges the output is the same. Only zones audible at some point in the block are
+	// mixed: the first is written and the rest accumulated, so a value sitting in the overlap of two layers costs two
+	// passes however many zones there are. With every zone muted the output is cleared once and then left alone.
+	// Sized by the zone count, like the operator that owns it, so it holds its gains inline.
+	template<int32 NumZones>
+	class TMultiZoneFader
+	{
+	public:
+		static_assert(NumZones > 0, "A multi-zone fader needs at least one zone");
+
+		void SetSilenceThreshold(float InThreshold)
+		{
+			SilenceThreshold = InThreshold;
+		}
+
+		// Back to the state it was constructed in, so the next block ramps every zone in from silence. Keeps the
+		// threshold.
+		void Reset()
+		{
+			PrevGains.fill(0.0f);
+			Gains.fill(0.0f);
+			ZoneActive.fill(0);
+			NumActiveZones = 0;
+			bBufferSilent = false;
+		}
+
+		// InBuffers holds one buffer per zone
+		void Process(float Value, const FTrapezoidZoneArrays& Zones, const float* const* InBuffers, float* OutBuffer, int32 NumFrames)
+		{
+			GetTrapezoidGains(Value, Zones, Gains.data(), NumZones, SilenceThreshold);
+
+			NumActiveZones = 0;
+			for (int32 Zone = 0; Zone < NumZones; ++Zone)
+			{
+				const bool bActive = PrevGains[Zone] != 0.0f || Gains[Zone] != 0.0f;
+				ZoneActive[Zone] = bActive;
+				if (!bActive)
+				{
+					continue;
+				}
+
+				if (NumActiveZones == 0)
+				{
+					ScaleRamp(InBuffers[Zone], OutBuffer, NumFrames, PrevGains[Zone], Gains[Zone]);
+				}
+				else
+				{
+					MixInRamp(InBuffers[Zone], OutBuffer, NumFrames, PrevGains[Zone], Gains[Zone]);
+				}
+				++NumActiveZones;
+			}
+
+			if (NumActiveZones == 0)
+			{
+				if (!bBufferSilent)
+				{
+					ZeroBuffer(OutBuffer, NumFrames);
+					bBufferSilent = true;
+				}
+			}
+			else
+			{
+				bBufferSilent = false;
+			}
+
+			// The targets are fully rewritten next block, so latching is a swap
+			std::swap(PrevGains, Gains);
+		}
+
+		// Gain the zone reached at the end of the last block
+		float GetGain(int32 Zone) const
+		{
+			return PrevGains[Zone];
+		}
+
+		// True if the zone was audible at any point in the last block
+		bool IsZoneActive(int32 Zone) const
+		{
+			return ZoneActive[Zone] != 0;
+		}
+
+		int32 GetNumActiveZones() const
+		{
+			return NumActiveZones;
+		}
+
+		// True if the last block processed was silent
+		bool IsMuted() const
+		{
+			return NumActiveZones == 0;
+		}
+
+	private:
+		float SilenceThreshold = DefaultSilenceThreshold;
+		std::array<float, NumZones> PrevGains = {};
+		std::array<float, NumZones> Gains = {};
+		std::array<uint8, NumZones> ZoneActive = {};
+		int32 NumActiveZones = 0;
+		bool bBufferSilent = false;
+	};
+}
+MSUTILS_FP_CONTRACT_OFF_END
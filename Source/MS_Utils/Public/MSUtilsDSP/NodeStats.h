@@ -0,0 +1,205 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+
+#include <atomic>
+#include <chrono>
+
+// Block counters and timing for every node type. Defined to 0 by the plugin's Shipping builds, which compiles the
+// timers and instance counters down to nothing.
+#ifndef MSUTILS_NODE_STATS
+#define MSUTILS_NODE_STATS 1
+#endif
+
+namespace MSUtilsDSP
+{
+	class FNodeStats;
+
+	namespace NodeStatsPrivate
+	{
+		inline std::atomic<FNodeStats*> Head{ nullptr };
+	}
+
+	// Copy of one node type's counters
+	struct FNodeStatsSnapshot
+	{
+		const char* Name = "";
+		int64 LiveInstances = 0;
+		uint64 FastPathBlocks = 0;
+		uint64 SlowPathBlocks = 0;
+		uint64 TotalNanoseconds = 0;
+		uint64 PeakNanoseconds = 0;
+
+		uint64 GetNumBlocks() const
+		{
+			return FastPathBlocks + SlowPathBlocks;
+		}
+
+		double GetAverageNanoseconds() const
+		{
+			return GetNumBlocks() > 0 ? (double)TotalNanoseconds / (double)GetNumBlocks() : 0.0;
+		}
+	};
+
+	// Counters for one node type, shared by its instances on every render thread. Updates are relaxed atomics, so a
+	// snapshot taken while audio renders may be a block out between fields, but no field is ever torn. What counts as
+	// a fast path block is up to the node: generally a block that skipped its gain work or was a plain copy.
+	// Must have static storage duration, as each instance links itself into the list ForEachNodeStats walks for good.
+	class FNodeStats
+	{
+	public:
+		explicit FNodeStats(const char* InName)
+			: Name(InName)
+		{
+			FNodeStats* OldHead = NodeStatsPrivate::Head.load(std::memory_order_relaxed);
+			do
+			{
+				Next = OldHead;
+			} while (!NodeStatsPrivate::Head.compare_exchange_weak(OldHead, this, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		FNodeStats(const FNodeStats&) = delete;
+		FNodeStats& operator=(const FNodeStats&) = delete;
+
+		const char* GetName() const
+		{
+			return Name;
+		}
+
+		FNodeStats* GetNext() const
+		{
+			return Next;
+		}
+
+		void AddInstance()
+		{
+			LiveInstances.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		void RemoveInstance()
+		{
+			LiveInstances.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		void RecordBlock(uint64 Nanoseconds, bool bFastPath)
+		{
+			(bFastPath ? FastPathBlocks : SlowPathBlocks).fetch_add(1, std::memory_order_relaxed);
+			TotalNanoseconds.fetch_add(Nanoseconds, std::memory_order_relaxed);
+
+			uint64 Peak = PeakNanoseconds.load(std::memory_order_relaxed);
+			while (Nanoseconds > Peak && !PeakNanoseconds.compare_exchange_weak(Peak, Nanoseconds, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		FNodeStatsSnapshot GetSnapshot() const
+		{
+			FNodeStatsSnapshot Snapshot;
+			Snapshot.Name = Name;
+			Snapshot.LiveInstances = LiveInstances.load(std::memory_order_relaxed);
+			Snapshot.FastPathBlocks = FastPathBlocks.load(std::memory_order_relaxed);
+			Snapshot.SlowPathBlocks = SlowPathBlocks.load(std::memory_order_relaxed);
+			Snapshot.TotalNanoseconds = TotalNanoseconds.load(std::memory_order_relaxed);
+			Snapshot.PeakNanoseconds = PeakNanoseconds.load(std::memory_order_relaxed);
+			return Snapshot;
+		}
+
+		// Clears the block counts and timings. Live instances are left alone, as they are still live.
+		void Reset()
+		{
+			FastPathBlocks.store(0, std::memory_order_relaxed);
+			SlowPathBlocks.store(0, std::memory_order_relaxed);
+			TotalNanoseconds.store(0, std::memory_order_relaxed);
+			PeakNanoseconds.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		const char* Name;
+		FNodeStats* Next = nullptr;
+		std::atomic<int64> LiveInstances{ 0 };
+		std::atomic<uint64> FastPathBlocks{ 0 };
+		std::atomic<uint64> SlowPathBlocks{ 0 };
+		std::atomic<uint64> TotalNanoseconds{ 0 };
+		std::atomic<uint64> PeakNanoseconds{ 0 };
+	};
+
+	// Calls Func(const FNodeStats&) for every node type, most recently registered first
+	template<typename FuncType>
+	void ForEachNodeStats(FuncType&& Func)
+	{
+		for (const FNodeStats* Stats = NodeStatsPrivate::Head.load(std::memory_order_acquire); Stats != nullptr; Stats = Stats->GetNext())
+		{
+			Func(*Stats);
+		}
+	}
+
+	inline void ResetNodeStats()
+	{
+		for (FNodeStats* Stats = NodeStatsPrivate::Head.load(std::memory_order_acquire); Stats != nullptr; Stats = Stats->GetNext())
+		{
+			Stats->Reset();
+		}
+	}
+
+	// Counts an operator as live for as long as it exists. Held as a member of each operator.
+	class FNodeInstanceCounter
+	{
+	public:
+		explicit FNodeInstanceCounter(FNodeStats& InStats)
+#if MSUTILS_NODE_STATS
+			: Stats(InStats)
+		{
+			Stats.AddInstance();
+		}
+
+		~FNodeInstanceCounter()
+		{
+			Stats.RemoveInstance();
+		}
+#else
+		{
+			(void)InStats;
+		}
+#endif
+
+		FNodeInstanceCounter(const FNodeInstanceCounter&) = delete;
+		FNodeInstanceCounter& operator=(const FNodeInstanceCounter&) = delete;
+
+#if MSUTILS_NODE_STATS
+	private:
+		FNodeStats& Stats;
+#endif
+	};
+
+	// Times one block of an operator into its node type's stats. Blocks count as slow path unless SetFastPath says otherwise.
+	class FScopedNodeBlockTimer
+	{
+	public:
+		explicit FScopedNodeBlockTimer(FNodeStats& InStats)
+			: Stats(InStats)
+			, StartTime(std::chrono::steady_clock::now())
+		{
+		}
+
+		~FScopedNodeBlockTimer()
+		{
+			const std::chrono::nanoseconds Elapsed = std::chrono::steady_clock::now() - StartTime;
+			Stats.RecordBlock((uint64)Elapsed.count(), bFastPath);
+		}
+
+		FScopedNodeBlockTimer(const FScopedNodeBlockTimer&) = delete;
+		FScopedNodeBlockTimer& operator=(const FScopedNodeBlockTimer&) = delete;
+
+		void SetFastPath(bool bInFastPath)
+		{
+			bFastPath = bInFastPath;
+		}
+
+	private:
+		FNodeStats& Stats;
+		std::chrono::steady_clock::time_point StartTime;
+		bool bFastPath = false;
+	};
+}
@@ -0,0 +1,344 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "MSUtilsDSP/DSPCommon.h"
+#include "MSUtilsDSP/EqualPowerGain.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Live gain and state telemetry for debugging. Defined to 0 by the plugin's Shipping builds, which leaves
+// FTelemetryPublisher empty so the operators carry no channel and publish nothing.
+#ifndef MSUTILS_TELEMETRY
+#define MSUTILS_TELEMETRY 1
+#endif
+
+namespace MSUtilsDSP
+{
+	// Wait-free single producer, single consumer queue. Capacity must be a power of two. Push never blocks or
+	// allocates: once the consumer has fallen Capacity values behind, new values are dropped and counted instead.
+	template<typename T, int32 Capacity>
+	class TSpscRing
+	{
+		static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "TSpscRing capacity must be a power of two");
+
+	public:
+		static constexpr int32 GetCapacity()
+		{
+			return Capacity;
+		}
+
+		// Producer only
+		bool Push(const T& Value)
+		{
+			const uint32 Write = WriteIndex.load(std::memory_order_relaxed);
+			if (Write - ReadIndex.load(std::memory_order_acquire) == (uint32)Capacity)
+			{
+				NumDropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			Items[Write & Mask] = Value;
+			WriteIndex.store(Write + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Consumer only
+		bool Pop(T& OutValue)
+		{
+			const uint32 Read = ReadIndex.load(std::memory_order_relaxed);
+			if (Read == WriteIndex.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+
+			OutValue = Items[Read & Mask];
+			ReadIndex.store(Read + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Exact from either side once the other has stopped, otherwise a snapshot
+		int32 Num() const
+		{
+			return (int32)(WriteIndex.load(std::memory_order_acquire) - ReadIndex.load(std::memory_order_acquire));
+		}
+
+		uint64 GetNumDropped() const
+		{
+			return NumDropped.load(std::memory_order_relaxed);
+		}
+
+	private:
+		static constexpr uint32 Mask = (uint32)Capacity - 1;
+
+		// The indices only ever increase and wrap at 2^32, which a power of two capacity divides.
+		// Each side writes its own index, so they are kept on separate cache lines.
+		alignas(64) std::atomic<uint32> WriteIndex{ 0 };
+		alignas(64) std::atomic<uint32> ReadIndex{ 0 };
+		std::atomic<uint64> NumDropped{ 0 };
+		T Items[Capacity] = {};
+	};
+
+	enum class ETelemetryEventType : uint8
+	{
+		// Crossfade value, the pair of inputs it sits between, how far towards the second and both their gains
+		Crossfade,
+		// Gain or envelope value at the end of the block
+		Gain,
+		// The node entered a new state, named by State
+		State
+	};
+
+	struct FTelemetryEvent
+	{
+		ETelemetryEventType Type = ETelemetryEventType::Gain;
+		float Value = 0.0f;
+		int32 IndexA = 0;
+		int32 IndexB = 0;
+		float Alpha = 0.0f;
+		float GainA = 0.0f;
+		float GainB = 0.0f;
+		// String literal, so it outlives the operator that published it
+		const char* State = "";
+	};
+
+	// One operator instance's events, published on its render thread and drained by DrainTelemetry
+	class FTelemetryChannel
+	{
+	public:
+		static constexpr int32 Capacity = 256;
+
+		FTelemetryChannel(const char* InNodeName, uint32 InId)
+			: NodeName(InNodeName)
+			, Id(InId)
+		{
+		}
+
+		const char* GetNodeName() const
+		{
+			return NodeName;
+		}
+
+		// Unique for the life of the process, so it can key a per instance display line
+		uint32 GetId() const
+		{
+			return Id;
+		}
+
+		bool Publish(const FTelemetryEvent& Event)
+		{
+			return Ring.Push(Event);
+		}
+
+		bool Pop(FTelemetryEvent& OutEvent)
+		{
+			return Ring.Pop(OutEvent);
+		}
+
+		int32 Num() const
+		{
+			return Ring.Num();
+		}
+
+		uint64 GetNumDropped() const
+		{
+			return Ring.GetNumDropped();
+		}
+
+		// Set by the publisher when its operator is destroyed. Nothing is published after.
+		void Close()
+		{
+			bClosed.store(true, std::memory_order_release);
+		}
+
+		bool IsClosed() const
+		{
+			return bClosed.load(std::memory_order_acquire);
+		}
+
+	private:
+		TSpscRing<FTelemetryEvent, Capacity> Ring;
+		const char* NodeName;
+		uint32 Id;
+		std::atomic<bool> bClosed{ false };
+	};
+
+	namespace TelemetryPrivate
+	{
+		inline std::atomic<bool> bEnabled{ false };
+		inline std::atomic<uint32> NextChannelId{ 1 };
+		inline std::mutex ChannelsMutex;
+		inline std::vector<std::shared_ptr<FTelemetryChannel>> Channels;
+	}
+
+	// Whether operators created from now on open a channel, and whether open channels publish. Set from the
+	// au.MSUtils.Telemetry console variable.
+	inline bool IsTelemetryEnabled()
+	{
+		return TelemetryPrivate::bEnabled.load(std::memory_order_relaxed);
+	}
+
+	inline void SetTelemetryEnabled(bool bEnabled)
+	{
+		TelemetryPrivate::bEnabled.store(bEnabled, std::memory_order_relaxed);
+	}
+
+	// Allocates and takes a lock, so it belongs in operator construction, never in a render
+	inline std::shared_ptr<FTelemetryChannel> OpenTelemetryChannel(const char* NodeName)
+	{
+		std::shared_ptr<FTelemetryChannel> Channel = std::make_shared<FTelemetryChannel>(NodeName, TelemetryPrivate::NextChannelId.fetch_add(1, std::memory_order_relaxed));
+
+		const std::lock_guard<std::mutex> Lock(TelemetryPrivate::ChannelsMutex);
+		TelemetryPrivate::Channels.push_back(Channel);
+		return Channel;
+	}
+
+	// Calls Func(const FTelemetryChannel&, const FTelemetryEvent&) for every event published since the last call, in
+	// order per channel, then frees the channels whose operators have gone. The single consumer of every channel, so
+	// only ever call it from one thread (the game thread in the plugin).
+	template<typename FuncType>
+	void DrainTelemetry(FuncType&& Func)
+	{
+		std::vector<std::shared_ptr<FTelemetryChannel>> Channels;
+		{
+			const std::lock_guard<std::mutex> Lock(TelemetryPrivate::ChannelsMutex);
+			Channels = TelemetryPrivate::Channels;
+		}
+
+		bool bAnyClosed = false;
+		for (const std::shared_ptr<FTelemetryChannel>& Channel : Channels)
+		{
+			bAnyClosed |= Channel->IsClosed();
+
+			FTelemetryEvent Event;
+			while (Channel->Pop(Event))
+			{
+				Func(*Channel, Event);
+			}
+		}
+
+		if (bAnyClosed)
+		{
+			// Nothing is pushed after closing, so a closed channel that is empty here stays empty
+			const std::lock_guard<std::mutex> Lock(TelemetryPrivate::ChannelsMutex);
+			std::vector<std::shared_ptr<FTelemetryChannel>>& Open = TelemetryPrivate::Channels;
+			Open.erase(std::remove_if(Open.begin(), Open.end(), [](const std::shared_ptr<FTelemetryChannel>& Channel)
+				{
+					return Channel->IsClosed() && Channel->Num() == 0;
+				}), Open.end());
+		}
+	}
+
+	// Channels not yet freed, including closed ones still holding events
+	inline int32 GetNumTelemetryChannels()
+	{
+		const std::lock_guard<std::mutex> Lock(TelemetryPrivate::ChannelsMutex);
+		return (int32)TelemetryPrivate::Channels.size();
+	}
+
+	// An operator's end of its channel, held as a member. Opens a channel only if telemetry is enabled when the
+	// operator is created. Publishing is a few relaxed loads and a copy into the ring: no locks or allocation, so
+	// it is safe on the render thread. Destroying the publisher only marks the channel closed; DrainTelemetry frees it.
+	class FTelemetryPublisher
+	{
+	public:
+		explicit FTelemetryPublisher(const char* NodeName)
+		{
+#if MSUTILS_TELEMETRY
+			if (IsTelemetryEnabled())
+			{
+				Channel = OpenTelemetryChannel(NodeName);
+			}
+#else
+			(void)NodeName;
+#endif
+		}
+
+		~FTelemetryPublisher()
+		{
+#if MSUTILS_TELEMETRY
+			if (Channel)
+			{
+				// The registry keeps an open channel alive, so dropping this reference first means the last one is
+				// always released by DrainTelemetry rather than here on the render thread
+				FTelemetryChannel* Closing = Channel.get();
+				Channel.reset();
+				Closing->Close();
+			}
+#endif
+		}
+
+		FTelemetryPublisher(const FTelemetryPublisher&) = delete;
+		FTelemetryPublisher& operator=(const FTelemetryPublisher&) = delete;
+
+		// True if this operator publishes, so it can skip gathering values nobody will see
+		bool IsActive() const
+		{
+#if MSUTILS_TELEMETRY
+			return Channel != nullptr && IsTelemetryEnabled();
+#else
+			return false;
+#endif
+		}
+
+		void PublishCrossfade(float CrossfadeValue, const FCrossfadePosition& Position, float GainA, float GainB)
+		{
+			FTelemetryEvent Event;
+			Event.Type = ETelemetryEventType::Crossfade;
+			Event.Value = CrossfadeValue;
+			Event.IndexA = Position.IndexA;
+			Event.IndexB = Position.IndexB;
+			Event.Alpha = Position.Alpha;
+			Event.GainA = GainA;
+			Event.GainB = GainB;
+			Publish(Event);
+		}
+
+		void PublishGain(float Gain)
+		{
+			FTelemetryEvent Event;
+			Event.Type = ETelemetryEventType::Gain;
+			Event.Value = Gain;
+			Publish(Event);
+		}
+
+		// Only publishes when State differs from the last state published, so it can be called every block.
+		// State must be a string literal.
+		void PublishState(const char* State)
+		{
+			if (LastState != nullptr && std::strcmp(LastState, State) == 0)
+			{
+				return;
+			}
+
+			FTelemetryEvent Event;
+			Event.Type = ETelemetryEventType::State;
+			Event.State = State;
+			if (Publish(Event))
+			{
+				LastState = State;
+			}
+		}
+
+	private:
+		bool Publish(const FTelemetryEvent& Event)
+		{
+#if MSUTILS_TELEMETRY
+			return IsActive() && Channel->Publish(Event);
+#else
+			(void)Event;
+			return false;
+#endif
+		}
+
+#if MSUTILS_TELEMETRY
+		std::shared_ptr<FTelemetryChannel> Channel;
+#endif
+		const char* LastState = nullptr;
+	};
+}
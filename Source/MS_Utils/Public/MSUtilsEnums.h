@@ -0,0 +1,22 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MetasoundEnumRegistrationMacro.h"
+#include "MSUtilsDSP/CrossfadeCurve.h"
+#include "MSUtilsDSP/EqualPowerGain.h"
+
+//------------------------------------------------------------------------------------
+// MetaSound enum types shared by the MS_Utils nodes
+//------------------------------------------------------------------------------------
+
+namespace Metasound
+{
+	DECLARE_METASOUND_ENUM(MSUtilsDSP::EGainAccuracy, MSUtilsDSP::EGainAccuracy::Exact, MS_UTILS_API,
+		FEnumGainAccuracy, FEnumGainAccuracyInfo, FEnumGainAccuracyReadRef, FEnumGainAccuracyWriteRef);
+
+	DECLARE_METASOUND_ENUM(MSUtilsDSP::ECrossfadeCurve, MSUtilsDSP::ECrossfadeCurve::EqualPower, MS_UTILS_API,
+		FEnumCrossfadeCurve, FEnumCrossfadeCurveInfo, FEnumCrossfadeCurveReadRef, FEnumCrossfadeCurveWriteRef);
+}
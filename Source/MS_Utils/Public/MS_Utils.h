@@ -3,8 +3,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
 #include "Modules/ModuleManager.h"
 
+class IConsoleObject;
+class UMetaSoundSource;
+
 class FMS_UtilsModule : public IModuleInterface
 {
 public:
@@ -12,4 +16,18 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+	// Builds NumInstances of the MetaSound's graph into the main audio device's operator cache, so the next plays of a
+	// high frequency one-shot take a pooled graph, reset, rather than constructing every operator. Every MS_Utils
+	// operator supports Reset, which a cached graph needs. Returns false if there is no cache to fill, which is always
+	// the case before 5.4, where the engine has no operator cache.
+	MS_UTILS_API static bool PrewarmMetaSound(UMetaSoundSource* MetaSound, int32 NumInstances = 1);
+
+private:
+	// au.MSUtils.Stats
+	IConsoleObject* NodeStatsCommand = nullptr;
+	// au.MSUtils.Prewarm, only registered from 5.4
+	IConsoleObject* PrewarmCommand = nullptr;
+	// Drains the operators' telemetry onto the screen
+	FTSTicker::FDelegateHandle TelemetryTickerHandle;
 };
@@ -14,6 +14,9 @@
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h" 
 #include "MetasoundAudioBuffer.h"
+#include "MSUtilsDSP/FadeEnvelope.h"
+#include "MSUtilsDSP/NodeStats.h"
+#include "MSUtilsDSP/Telemetry.h"
 
 
 //------------------------------------------------------------------------------------
@@ -42,6 +45,9 @@ namespace Metasound
 		// Used to instantiate a new runtime instance of your node
 		static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors);
 
+		// Puts the operator back as it was constructed, so a cached graph can be reused for a new sound
+		void Reset(const IOperator::FResetParams& InParams);
+
 		void Execute();
 
 	private:
@@ -52,14 +58,14 @@ namespace Metasound
 		FTriggerWriteRef TriggerFinished;
 		FTimeReadRef FadeInTime;
 		FFloatWriteRef OutEnvelope;
-		//float SampleRate;
-		float BlockRate;
-		float FadeBlockCount = 0.f;
-		float OutEnvelopeValue = 0.0f;
-		float FadeCounter = 1.0f;
-		bool ProcessFade = false;
-		//int32 NumFramesPerBlock = 0;
-
+		FAudioBufferWriteRef OutEnvelopeAudio;
+		float SampleRate;
+		MSUtilsDSP::FFadeEnvelope Envelope;
+		// Inline capacity, so gathering a block's triggers on the render thread does not allocate
+		TArray<MSUtilsDSP::FFadeEvent, TInlineAllocator<16>> FadeEvents;
+		int32 NumFramesPerBlock = 0;
+		MSUtilsDSP::FNodeInstanceCounter InstanceCounter;
+		MSUtilsDSP::FTelemetryPublisher Telemetry;
 	};
 
 	//------------------------------------------------------------------------------------
@@ -0,0 +1,1578 @@
+// Copyright Dale Grinsell 2024. All Rights Reserved. 
+
+// Standalone tests for the MSUtilsDSP core. Built by the CMakeLists.txt at the plugin root, no engine required.
+
+#include "MSUtilsDSP/CrossfadeBank.h"
+#include "MSUtilsDSP/CrossfadeCurve.h"
+#include "MSUtilsDSP/Denormals.h"
+#include "MSUtilsDSP/EqualPowerCrossfader.h"
+#include "MSUtilsDSP/EqualPowerGain.h"
+#include "MSUtilsDSP/FadeEngine.h"
+#include "MSUtilsDSP/FadeEnvelope.h"
+#include "MSUtilsDSP/GainKernelDispatch.h"
+#include "MSUtilsDSP/GainKernels.h"
+#include "MSUtilsDSP/MappedRangeGain.h"
+#include "MSUtilsDSP/NodeStats.h"
+#include "MSUtilsDSP/Telemetry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using namespace MSUtilsDSP;
+
+	int NumFailures = 0;
+
+	#define TEST_CHECK(Expr) \
+		do { if (!(Expr)) { std::printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #Expr); ++NumFailures; } } while (0)
+
+	#define TEST_CHECK_NEAR(A, B, Tolerance) \
+		do { const double TestA = (A), TestB = (B); if (std::fabs(TestA - TestB) > (Tolerance)) { std::printf("%s:%d: CHECK_NEAR failed: %s = %g, %s = %g\n", __FILE__, __LINE__, #A, TestA, #B, TestB); ++NumFailures; } } while (0)
+
+	void TestEqualPowerGains()
+	{
+		const FEqualPowerGains Start = GetEqualPowerGains(0.0f);
+		TEST_CHECK_NEAR(Start.A, 1.0, 1e-6);
+		TEST_CHECK_NEAR(Start.B, 0.0, 1e-6);
+
+		const FEqualPowerGains Mid = GetEqualPowerGains(0.5f);
+		TEST_CHECK_NEAR(Mid.A, std::sqrt(0.5), 1e-6);
+		TEST_CHECK_NEAR(Mid.A * Mid.A + Mid.B * Mid.B, 1.0, 1e-6);
+
+		const FEqualPowerGains End = GetEqualPowerGains(1.0f);
+		TEST_CHECK_NEAR(End.A, 0.0, 1e-6);
+		TEST_CHECK_NEAR(End.B, 1.0, 1e-6);
+	}
+
+	void TestFastEqualPowerGains()
+	{
+		TEST_CHECK(FastQuarterCos(0.0f) == 1.0f);
+		TEST_CHECK_NEAR(FastQuarterCos(1.0f), 0.0, 1e-7);
+
+		const int32 NumSteps = 100000;
+		double MaxError = 0.0;
+		double MaxPowerError = 0.0;
+		bool bMonotonic = true;
+		float Previous = FastQuarterCos(0.0f);
+		for (int32 Step = 0; Step <= NumSteps; ++Step)
+		{
+			const float X = (float)Step / (float)NumSteps;
+			const float Gain = FastQuarterCos(X);
+			const float Complement = FastQuarterCos(1.0f - X);
+			MaxError = std::max(MaxError, std::fabs((double)Gain - std::cos((double)X * 1.5707963267948966)));
+			MaxPowerError = std::max(MaxPowerError, std::fabs((double)Gain * Gain + (double)Complement * Complement - 1.0));
+			bMonotonic = bMonotonic && Gain <= Previous;
+			Previous = Gain;
+		}
+		TEST_CHECK(MaxError < 2e-7);
+		TEST_CHECK(MaxPowerError < 4e-7);
+		TEST_CHECK(bMonotonic);
+
+		// Out of range positions clamp to the end gains
+		const FEqualPowerGains Below = GetEqualPowerGainsFast(-0.5f);
+		TEST_CHECK(Below.A == 1.0f);
+		TEST_CHECK_NEAR(Below.B, 0.0, 1e-7);
+
+		// The array path matches the scalar one for both accuracies
+		const float Alphas[] = { -0.5f, 0.0f, 0.1f, 0.5f, 0.9f, 1.0f, 1.5f };
+		const int32 NumAlphas = (int32)(sizeof(Alphas) / sizeof(Alphas[0]));
+		float GainsA[NumAlphas];
+		float GainsB[NumAlphas];
+		for (EGainAccuracy Accuracy : { EGainAccuracy::Exact, EGainAccuracy::Fast })
+		{
+			ComputeEqualPowerGains(Alphas, GainsA, GainsB, NumAlphas, Accuracy);
+			for (int32 i = 0; i < NumAlphas; ++i)
+			{
+				const FEqualPowerGains Gains = GetEqualPowerGains(Alphas[i], Accuracy);
+				TEST_CHECK(GainsA[i] == Gains.A);
+				TEST_CHECK(GainsB[i] == Gains.B);
+			}
+		}
+	}
+
+	void TestCrossfadePosition()
+	{
+		const FCrossfadePosition Position = GetCrossfadePosition(3.4f, 8);
+		TEST_CHECK(Position.IndexA == 3);
+		TEST_CHECK(Position.IndexB == 4);
+		TEST_CHECK_NEAR(Position.Alpha, 0.4, 1e-5);
+
+		const FCrossfadePosition Top = GetCrossfadePosition(12.0f, 4);
+		TEST_CHECK(Top.IndexA == 3);
+		TEST_CHECK(Top.IndexB == 3);
+		TEST_CHECK_NEAR(Top.Alpha, 0.0, 1e-6);
+
+		const FCrossfadePosition Bottom = GetCrossfadePosition(-1.0f, 4);
+		TEST_CHECK(Bottom.IndexA == 0);
+		TEST_CHECK(Bottom.IndexB == 1);
+
+		for (const float NonFinite : { std::nanf(""), INFINITY, -INFINITY })
+		{
+			const FCrossfadePosition Sanitized = GetCrossfadePosition(NonFinite, 4);
+			TEST_CHECK(Sanitized.IndexA == 0 && Sanitized.IndexB == 1 && Sanitized.Alpha == 0.0f);
+		}
+	}
+
+	void TestRampKernels()
+	{
+		const int32 NumFrames = 4;
+		std::vector<float> In(NumFrames, 1.0f);
+		std::vector<float> Out(NumFrames, 1.0f);
+
+		// Gain ramps 0, 0.25, 0.5, 0.75 and reaches 1 on the following block
+		MixInRamp(In.data(), Out.data(), NumFrames, 0.0f, 1.0f);
+		TEST_CHECK_NEAR(Out[0], 1.0, 1e-6);
+		TEST_CHECK_NEAR(Out[3], 1.75, 1e-6);
+
+		FadeRamp(Out.data(), NumFrames, 1.0f, 0.0f);
+		TEST_CHECK_NEAR(Out[0], 1.0, 1e-6);
+		TEST_CHECK_NEAR(Out[2], 0.75, 1e-6);
+
+		FadeRamp(Out.data(), NumFrames, 0.0f, 0.0f);
+		TEST_CHECK(Out[0] == 0.0f && Out[3] == 0.0f);
+
+		FillRamp(Out.data(), NumFrames, 1.0f, 0.0f);
+		TEST_CHECK_NEAR(Out[0], 1.0, 1e-6);
+		TEST_CHECK_NEAR(Out[3], 0.25, 1e-6);
+	}
+
+	void TestEqualPowerCrossfader()
+	{
+		const int32 NumFrames = 8;
+		std::vector<std::vector<float>> Inputs = { std::vector<float>(NumFrames, 1.0f), std::vector<float>(NumFrames, 2.0f), std::vector<float>(NumFrames, 4.0f) };
+		const float* InputData[] = { Inputs[0].data(), Inputs[1].data(), Inputs[2].data() };
+		std::vector<float> Out(NumFrames, 0.0f);
+
+		TEqualPowerCrossfader<3> Crossfader;
+		Crossfader.UpdateGains(GetCrossfadePosition(0.0f, 3));
+		Crossfader.Mix(InputData, Out.data(), NumFrames);
+		Crossfader.Mix(InputData, Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[NumFrames - 1], 1.0, 1e-6);
+
+		// Moving to input 2 ramps input 0 down over one block, then stops mixing it
+		Crossfader.UpdateGains(GetCrossfadePosition(2.0f, 3));
+		TEST_CHECK(Crossfader.GetNeedsMixing(0));
+		Crossfader.Mix(InputData, Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[0], 1.0, 1e-6);
+
+		Crossfader.UpdateGains(GetCrossfadePosition(2.0f, 3));
+		TEST_CHECK(!Crossfader.GetNeedsMixing(0));
+		TEST_CHECK(!Crossfader.GetNeedsMixing(1));
+		Crossfader.Mix(InputData, Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[0], 4.0, 1e-6);
+	}
+
+	void TestEqualPowerCrossfaderMixPaths()
+	{
+		// Jumping across inputs leaves the old pair ramping down while the new pair ramps up, which takes the
+		// accumulating path. Every path must match a plain zero + mix-in reference.
+		const int32 NumInputs = 5;
+		const int32 NumFrames = 16;
+		std::vector<std::vector<float>> Inputs;
+		std::vector<const float*> InputData;
+		for (int32 i = 0; i < NumInputs; ++i)
+		{
+			std::vector<float> Input(NumFrames);
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Input[Frame] = std::sin(0.3f * (float)(Frame + 1) * (float)(i + 1));
+			}
+			Inputs.push_back(Input);
+		}
+		for (const std::vector<float>& Input : Inputs)
+		{
+			InputData.push_back(Input.data());
+		}
+
+		TEqualPowerCrossfader<NumInputs> Crossfader;
+		std::vector<float> PrevGains(NumInputs, 0.0f);
+		std::vector<float> Out(NumFrames);
+		std::vector<float> Expected(NumFrames);
+		const float Values[] = { 0.5f, 0.5f, 2.5f, 2.5f, 4.0f, 0.0f, 1.0f };
+		for (float Value : Values)
+		{
+			Crossfader.Process(Value, EGainAccuracy::Exact, InputData.data(), Out.data(), NumFrames);
+
+			ZeroBuffer(Expected.data(), NumFrames);
+			for (int32 i = 0; i < NumInputs; ++i)
+			{
+				MixInRamp(InputData[i], Expected.data(), NumFrames, PrevGains[i], Crossfader.GetCurrentGain(i));
+				PrevGains[i] = Crossfader.GetCurrentGain(i);
+			}
+
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				TEST_CHECK_NEAR(Out[Frame], Expected[Frame], 1e-6);
+			}
+		}
+	}
+
+	void TestAudioRateEqualPowerCrossfader()
+	{
+		const int32 NumInputs = 4;
+		const int32 NumFrames = 8;
+		std::vector<std::vector<float>> Inputs;
+		std::vector<const float*> InputData;
+		for (int32 i = 0; i < NumInputs; ++i)
+		{
+			Inputs.push_back(std::vector<float>(NumFrames, (float)(i + 1)));
+		}
+		for (const std::vector<float>& Input : Inputs)
+		{
+			InputData.push_back(Input.data());
+		}
+
+		// Every frame matches the block rate gains for the same value
+		const float Values[NumFrames] = { -1.0f, 0.0f, 0.3f, 1.0f, 1.5f, 2.25f, 3.0f, 7.0f };
+		std::vector<float> Out(NumFrames, 0.0f);
+		for (EGainAccuracy Accuracy : { EGainAccuracy::Exact, EGainAccuracy::Fast })
+		{
+			FAudioRateEqualPowerCrossfader Crossfader(NumInputs, NumFrames);
+			Crossfader.Process(Values, Accuracy, InputData.data(), Out.data(), NumFrames);
+			TEST_CHECK(Crossfader.GetFirstActiveInput() == 0);
+			TEST_CHECK(Crossfader.GetLastActiveInput() == NumInputs - 1);
+
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				const FCrossfadePosition Position = GetCrossfadePosition(Values[Frame], NumInputs);
+				const FEqualPowerGains Gains = GetEqualPowerGains(Position.Alpha);
+				double Expected = Gains.A * Inputs[Position.IndexA][Frame];
+				if (Position.IndexB != Position.IndexA)
+				{
+					Expected += Gains.B * Inputs[Position.IndexB][Frame];
+				}
+				TEST_CHECK_NEAR(Out[Frame], Expected, 1e-5);
+			}
+		}
+
+		// A value that stays between two inputs only mixes those two
+		FAudioRateEqualPowerCrossfader Crossfader(NumInputs, NumFrames);
+		const float Between[NumFrames] = { 1.2f, 1.3f, 1.4f, 1.5f, 1.6f, 1.7f, 1.8f, 1.9f };
+		Crossfader.Process(Between, EGainAccuracy::Exact, InputData.data(), Out.data(), NumFrames);
+		TEST_CHECK(Crossfader.GetFirstActiveInput() == 1);
+		TEST_CHECK(Crossfader.GetLastActiveInput() == 2);
+
+		// NaN frames play input 0 rather than feeding NaN into the gains
+		std::vector<float> NaNs(NumFrames, std::nanf(""));
+		Crossfader.Process(NaNs.data(), EGainAccuracy::Exact, InputData.data(), Out.data(), NumFrames);
+		TEST_CHECK(Crossfader.GetFirstActiveInput() == 0);
+		TEST_CHECK(Out[NumFrames - 1] == Inputs[0][NumFrames - 1]);
+	}
+
+	void TestInputActivity()
+	{
+		const int32 NumFrames = 4;
+		const std::vector<float> In(NumFrames, 1.0f);
+		const float* InputData[] = { In.data(), In.data(), In.data(), In.data() };
+		std::vector<float> Out(NumFrames, 0.0f);
+
+		// An input stays active for the block it ramps down in
+		TEqualPowerCrossfader<4> Crossfader;
+		Crossfader.Process(0.5f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK(Crossfader.IsInputActive(0) && Crossfader.IsInputActive(1));
+		TEST_CHECK(!Crossfader.IsInputActive(2) && !Crossfader.IsInputActive(3));
+		Crossfader.Process(3.0f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK(Crossfader.IsInputActive(0) && Crossfader.IsInputActive(3));
+		TEST_CHECK(!Crossfader.IsInputActive(2));
+		Crossfader.Process(3.0f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK(!Crossfader.IsInputActive(0) && !Crossfader.IsInputActive(1) && Crossfader.IsInputActive(3));
+
+		FEqualPowerCrossfadePair Pair;
+		Pair.Process(0.0f, EGainAccuracy::Exact, In.data(), In.data(), Out.data(), NumFrames);
+		TEST_CHECK(Pair.IsInputActive(0) && !Pair.IsInputActive(1));
+		Pair.Process(1.0f, EGainAccuracy::Exact, In.data(), In.data(), Out.data(), NumFrames);
+		TEST_CHECK(Pair.IsInputActive(0) && Pair.IsInputActive(1));
+		Pair.Process(1.0f, EGainAccuracy::Exact, In.data(), In.data(), Out.data(), NumFrames);
+		TEST_CHECK(!Pair.IsInputActive(0) && Pair.IsInputActive(1));
+
+		FAudioRateEqualPowerCrossfader AudioRate(4, NumFrames);
+		TEST_CHECK(!AudioRate.IsInputActive(0));
+		const float Values[NumFrames] = { 1.0f, 1.5f, 2.0f, 1.5f };
+		AudioRate.Process(Values, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK(!AudioRate.IsInputActive(0) && AudioRate.IsInputActive(1) && AudioRate.IsInputActive(2) && !AudioRate.IsInputActive(3));
+	}
+
+	void TestEqualPowerCrossfadePair()
+	{
+		const int32 NumFrames = 4;
+		std::vector<float> InA(NumFrames, 1.0f);
+		std::vector<float> InB(NumFrames, -1.0f);
+		std::vector<float> Out(NumFrames, 0.0f);
+
+		// The first block fades in from silence, then holds
+		FEqualPowerCrossfadePair Crossfader;
+		Crossfader.Process(0.0f, EGainAccuracy::Exact, InA.data(), InB.data(), Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[0], 0.0, 1e-6);
+		Crossfader.Process(0.0f, EGainAccuracy::Exact, InA.data(), InB.data(), Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[0], 1.0, 1e-6);
+		TEST_CHECK_NEAR(Out[3], 1.0, 1e-6);
+
+		Crossfader.Process(1.0f, EGainAccuracy::Exact, InA.data(), InB.data(), Out.data(), NumFrames);
+		Crossfader.Process(1.0f, EGainAccuracy::Exact, InA.data(), InB.data(), Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[0], -1.0, 1e-6);
+
+		// A non-finite value plays input A alone, as a value of 0 does, with either accuracy
+		for (const EGainAccuracy Accuracy : { EGainAccuracy::Exact, EGainAccuracy::Fast })
+		{
+			for (const float NonFinite : { std::nanf(""), INFINITY, -INFINITY })
+			{
+				FEqualPowerCrossfadePair Sanitized;
+				FEqualPowerCrossfadePair Zero;
+				std::vector<float> ZeroOut(NumFrames, 0.0f);
+				for (int32 Block = 0; Block < 2; ++Block)
+				{
+					Sanitized.Process(NonFinite, Accuracy, InA.data(), InB.data(), Out.data(), NumFrames);
+					Zero.Process(0.0f, Accuracy, InA.data(), InB.data(), ZeroOut.data(), NumFrames);
+					TEST_CHECK(Out == ZeroOut);
+				}
+				TEST_CHECK(Sanitized.GetGains().A == 1.0f && Sanitized.GetGains().B == 0.0f);
+				TEST_CHECK(Sanitized.IsInputActive(0) && !Sanitized.IsInputActive(1));
+			}
+		}
+	}
+
+	void TestMappedRangeFader()
+	{
+		const int32 NumFrames = 4;
+		std::vector<float> In(NumFrames, 2.0f);
+		std::vector<float> Out(NumFrames, 0.0f);
+		const FTrapezoidZone Zone = { 0.0f, 1.0f, 2.0f, 3.0f };
+
+		FMappedRangeFader Fader;
+		Fader.Process(1.5f, Zone, In.data(), Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Fader.GetAmplitude(), 1.0, 1e-6);
+		TEST_CHECK_NEAR(Out[0], 0.0, 1e-6);
+		TEST_CHECK_NEAR(Out[2], 1.0, 1e-6);
+
+		Fader.Process(1.5f, Zone, In.data(), Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[0], 2.0, 1e-6);
+
+		// Settled at unity the output is the input, bit for bit
+		const float Noise[NumFrames] = { 0.1f, -0.7f, 1e-30f, 0.3f };
+		Fader.Process(1.5f, Zone, Noise, Out.data(), NumFrames);
+		TEST_CHECK(std::equal(Out.begin(), Out.end(), Noise));
+		TEST_CHECK(Fader.GetGainState() == EZoneGainState::Unity);
+
+		// Leaving the zone ramps down, then clears the output once and reports muted
+		Fader.Process(5.0f, Zone, Noise, Out.data(), NumFrames);
+		TEST_CHECK(Fader.GetGainState() == EZoneGainState::Ramping);
+		TEST_CHECK(!Fader.IsMuted());
+		Fader.Process(5.0f, Zone, Noise, Out.data(), NumFrames);
+		TEST_CHECK(Fader.IsMuted());
+		TEST_CHECK(Out[1] == 0.0f);
+
+		// Nothing touches the silent output while muted
+		Out[1] = 42.0f;
+		Fader.Process(5.0f, Zone, Noise, Out.data(), NumFrames);
+		TEST_CHECK(Out[1] == 42.0f);
+
+		Fader.Process(2.5f, Zone, Noise, Out.data(), NumFrames);
+		TEST_CHECK(Fader.GetGainState() == EZoneGainState::Ramping);
+		Fader.Process(2.5f, Zone, Noise, Out.data(), NumFrames);
+		TEST_CHECK(Fader.GetGainState() == EZoneGainState::Constant);
+		TEST_CHECK_NEAR(Out[0], Noise[0] * 0.5, 1e-6);
+	}
+
+	void TestLargeEqualPowerCrossfader()
+	{
+		// Only the touched inputs are updated each block, so check every gain against a full recalculation
+		const int32 NumInputs = 64;
+		const int32 NumFrames = 8;
+		std::vector<std::vector<float>> Inputs;
+		std::vector<const float*> InputData;
+		for (int32 i = 0; i < NumInputs; ++i)
+		{
+			Inputs.push_back(std::vector<float>(NumFrames, (float)(i + 1)));
+		}
+		for (const std::vector<float>& Input : Inputs)
+		{
+			InputData.push_back(Input.data());
+		}
+
+		TEqualPowerCrossfader<NumInputs> Crossfader;
+		std::vector<float> PrevGains(NumInputs, 0.0f);
+		std::vector<float> Out(NumFrames);
+		const float Values[] = { 10.5f, 10.5f, 40.25f, 3.0f, 63.0f, 62.5f, 0.0f, 0.0f, 31.75f, 32.0f };
+		for (float Value : Values)
+		{
+			Crossfader.Process(Value, EGainAccuracy::Exact, InputData.data(), Out.data(), NumFrames);
+
+			const FCrossfadePosition Position = GetCrossfadePosition(Value, NumInputs);
+			const FEqualPowerGains Gains = GetEqualPowerGains(Position.Alpha);
+			double Expected = 0.0;
+			int32 NumExpectedMixed = 0;
+			for (int32 i = 0; i < NumInputs; ++i)
+			{
+				const float Gain = i == Position.IndexA ? Gains.A : (i == Position.IndexB ? Gains.B : 0.0f);
+				TEST_CHECK(Crossfader.GetCurrentGain(i) == Gain);
+				TEST_CHECK(Crossfader.IsInputActive(i) == (Gain != 0.0f || PrevGains[i] != 0.0f));
+				NumExpectedMixed += Crossfader.IsInputActive(i) ? 1 : 0;
+				Expected += (PrevGains[i] + (Gain - PrevGains[i]) * 0.5) * Inputs[i][0];
+				PrevGains[i] = Gain;
+			}
+			TEST_CHECK(Crossfader.GetNumMixedInputs() == NumExpectedMixed);
+			TEST_CHECK_NEAR(Out[NumFrames / 2], Expected, 1e-4);
+		}
+	}
+
+	// A multichannel process computes its gains once and must match the mono process run on each channel
+	void TestMultichannel()
+	{
+		const int32 NumFrames = 16;
+		const int32 NumInputs = 3;
+		const int32 NumChannels = 2;
+		std::vector<float> In(NumInputs * NumChannels * NumFrames);
+		for (size_t i = 0; i < In.size(); ++i)
+		{
+			In[i] = std::sin(0.37f * (float)i);
+		}
+		const float* InputData[NumInputs * NumChannels];
+		for (int32 i = 0; i < NumInputs * NumChannels; ++i)
+		{
+			InputData[i] = In.data() + i * NumFrames;
+		}
+
+		TEqualPowerCrossfader<NumInputs> Crossfader;
+		FAudioRateEqualPowerCrossfader AudioRateCrossfader(NumInputs, NumFrames);
+		FEqualPowerCrossfadePair Pair;
+		FMappedRangeFader Fader;
+		TEqualPowerCrossfader<NumInputs> MonoCrossfaders[NumChannels];
+		std::vector<FAudioRateEqualPowerCrossfader> MonoAudioRateCrossfaders(NumChannels, FAudioRateEqualPowerCrossfader(NumInputs, NumFrames));
+		FEqualPowerCrossfadePair MonoPairs[NumChannels];
+		FMappedRangeFader MonoFaders[NumChannels];
+
+		const FTrapezoidZone Zone = { 0.0f, 1.0f, 1.5f, 2.0f };
+		std::vector<float> Out[4];
+		float* OutputData[4][NumChannels];
+		for (int32 Node = 0; Node < 4; ++Node)
+		{
+			Out[Node].resize(NumChannels * NumFrames);
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				OutputData[Node][Channel] = Out[Node].data() + Channel * NumFrames;
+			}
+		}
+		std::vector<float> MonoOut(NumFrames);
+		std::vector<float> Values(NumFrames);
+
+		const float Steps[] = { 0.0f, 0.6f, 1.3f, 1.3f, 1.8f, 2.0f };
+		float PrevValue = 0.0f;
+		for (const float Value : Steps)
+		{
+			FillRamp(Values.data(), NumFrames, PrevValue, Value);
+			PrevValue = Value;
+
+			Crossfader.Process(Value, EGainAccuracy::Exact, InputData, OutputData[0], NumChannels, NumFrames);
+			AudioRateCrossfader.Process(Values.data(), EGainAccuracy::Exact, InputData, OutputData[1], NumChannels, NumFrames);
+			Pair.Process(Value * 0.5f, EGainAccuracy::Exact, InputData, InputData + NumChannels, OutputData[2], NumChannels, NumFrames);
+			Fader.Process(Value, Zone, InputData, OutputData[3], NumChannels, NumFrames);
+
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				const float* ChannelInputs[NumInputs] = { InputData[Channel], InputData[NumChannels + Channel], InputData[2 * NumChannels + Channel] };
+				for (int32 Node = 0; Node < 4; ++Node)
+				{
+					switch (Node)
+					{
+					case 0: MonoCrossfaders[Channel].Process(Value, EGainAccuracy::Exact, ChannelInputs, MonoOut.data(), NumFrames); break;
+					case 1: MonoAudioRateCrossfaders[Channel].Process(Values.data(), EGainAccuracy::Exact, ChannelInputs, MonoOut.data(), NumFrames); break;
+					case 2: MonoPairs[Channel].Process(Value * 0.5f, EGainAccuracy::Exact, ChannelInputs[0], ChannelInputs[1], MonoOut.data(), NumFrames); break;
+					default: MonoFaders[Channel].Process(Value, Zone, ChannelInputs[0], MonoOut.data(), NumFrames); break;
+					}
+					TEST_CHECK(std::equal(MonoOut.begin(), MonoOut.end(), OutputData[Node][Channel]));
+				}
+			}
+		}
+	}
+
+	// Every voice of the bank must give exactly what its own lightweight crossfade would
+	void TestCrossfadeBank()
+	{
+		const int32 NumFrames = 16;
+		const int32 NumVoices = 5;
+		std::vector<float> In(2 * NumVoices * NumFrames);
+		for (size_t i = 0; i < In.size(); ++i)
+		{
+			In[i] = std::cos(0.91f * (float)i);
+		}
+		const float* InputDataA[NumVoices];
+		const float* InputDataB[NumVoices];
+		std::vector<float> Out(NumVoices * NumFrames);
+		float* OutputData[NumVoices];
+		for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+		{
+			InputDataA[Voice] = In.data() + 2 * Voice * NumFrames;
+			InputDataB[Voice] = In.data() + (2 * Voice + 1) * NumFrames;
+			OutputData[Voice] = Out.data() + Voice * NumFrames;
+		}
+
+		for (const EGainAccuracy Accuracy : { EGainAccuracy::Exact, EGainAccuracy::Fast })
+		{
+			FEqualPowerCrossfadeBank Bank(NumVoices);
+			FEqualPowerCrossfadePair Pairs[NumVoices];
+			std::vector<float> PairOut(NumFrames);
+			float Values[NumVoices];
+			const float NonFinite[] = { std::nanf(""), INFINITY, -INFINITY };
+			for (int32 Block = 0; Block < 6; ++Block)
+			{
+				for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+				{
+					// Includes out of range and unchanging values, then non-finite ones held for two blocks
+					Values[Voice] = Block >= 4 ? NonFinite[Voice % 3] : Voice == 0 ? 0.25f : -0.5f + 0.3f * (float)(Voice * Block);
+				}
+				Bank.Process(Values, Accuracy, InputDataA, InputDataB, OutputData, NumFrames);
+				TEST_CHECK(Bank.IsSettled() == (Block == 5));
+
+				for (int32 Voice = 0; Voice < NumVoices; ++Voice)
+				{
+					Pairs[Voice].Process(Values[Voice], Accuracy, InputDataA[Voice], InputDataB[Voice], PairOut.data(), NumFrames);
+					TEST_CHECK(std::equal(PairOut.begin(), PairOut.end(), OutputData[Voice]));
+					TEST_CHECK(Bank.GetGains(Voice).A == Pairs[Voice].GetGains().A && Bank.GetGains(Voice).B == Pairs[Voice].GetGains().B);
+					TEST_CHECK(Bank.IsInputActive(Voice, 0) == Pairs[Voice].IsInputActive(0));
+					TEST_CHECK(Bank.IsInputActive(Voice, 1) == Pairs[Voice].IsInputActive(1));
+				}
+			}
+		}
+	}
+
+	void TestMultiZoneFader()
+	{
+		const int32 NumFrames = 19;
+		const int32 NumZones = 6;
+		std::vector<float> In(NumZones * NumFrames);
+		for (size_t i = 0; i < In.size(); ++i)
+		{
+			In[i] = std::sin(0.53f * (float)i);
+		}
+		const float* InputData[NumZones];
+		for (int32 Zone = 0; Zone < NumZones; ++Zone)
+		{
+			InputData[Zone] = In.data() + Zone * NumFrames;
+		}
+
+		// Layers overlapping their neighbours by half a unit, plus a step edge on the last
+		float FadeInStarts[NumZones];
+		float FadeInEnds[NumZones];
+		float FadeOutStarts[NumZones];
+		float FadeOutEnds[NumZones];
+		for (int32 Zone = 0; Zone < NumZones; ++Zone)
+		{
+			FadeInStarts[Zone] = (float)Zone - 0.5f;
+			FadeInEnds[Zone] = (float)Zone;
+			FadeOutStarts[Zone] = (float)Zone + 0.5f;
+			FadeOutEnds[Zone] = Zone == NumZones - 1 ? FadeOutStarts[Zone] : (float)Zone + 1.0f;
+		}
+		const FTrapezoidZoneArrays Zones = { FadeInStarts, FadeInEnds, FadeOutStarts, FadeOutEnds };
+
+		TMultiZoneFader<NumZones> MultiZone;
+		FMappedRangeFader Faders[NumZones];
+		std::vector<float> Out(NumFrames);
+		std::vector<float> FaderOut(NumFrames);
+		std::vector<float> Expected(NumFrames);
+		const float Values[] = { 0.75f, 0.75f, 1.0f, 2.6f, 2.6f, 5.25f, 5.6f, 9.0f, 9.0f, -3.0f, 3.75f };
+		for (const float Value : Values)
+		{
+			MultiZone.Process(Value, Zones, InputData, Out.data(), NumFrames);
+
+			std::fill(Expected.begin(), Expected.end(), 0.0f);
+			int32 NumActive = 0;
+			for (int32 Zone = 0; Zone < NumZones; ++Zone)
+			{
+				const FTrapezoidZone Zone1 = { FadeInStarts[Zone], FadeInEnds[Zone], FadeOutStarts[Zone], FadeOutEnds[Zone] };
+				Faders[Zone].Process(Value, Zone1, InputData[Zone], FaderOut.data(), NumFrames);
+				TEST_CHECK(MultiZone.GetGain(Zone) == Faders[Zone].GetAmplitude());
+				TEST_CHECK(MultiZone.IsZoneActive(Zone) == !Faders[Zone].IsMuted());
+				if (!Faders[Zone].IsMuted())
+				{
+					++NumActive;
+					for (int32 i = 0; i < NumFrames; ++i)
+					{
+						Expected[i] += FaderOut[i];
+					}
+				}
+			}
+
+			// Same sum in the same order, so the match is exact
+			TEST_CHECK(Out == Expected);
+			TEST_CHECK(MultiZone.GetNumActiveZones() == NumActive);
+		}
+
+		// Held inside an overlap only the two layers there are mixed
+		MultiZone.Process(3.75f, Zones, InputData, Out.data(), NumFrames);
+		TEST_CHECK(MultiZone.GetNumActiveZones() == 2 && MultiZone.IsZoneActive(3) && MultiZone.IsZoneActive(4));
+
+		// Out of every zone: ramps down, is cleared once, then left alone
+		MultiZone.Process(-3.0f, Zones, InputData, Out.data(), NumFrames);
+		TEST_CHECK(!MultiZone.IsMuted());
+		MultiZone.Process(-3.0f, Zones, InputData, Out.data(), NumFrames);
+		TEST_CHECK(MultiZone.IsMuted());
+		TEST_CHECK(Out[3] == 0.0f);
+		Out[3] = 42.0f;
+		MultiZone.Process(-3.0f, Zones, InputData, Out.data(), NumFrames);
+		TEST_CHECK(Out[3] == 42.0f);
+
+		// A zone edge that moves applies without the value moving
+		FadeInEnds[0] = -0.25f;
+		MultiZone.Process(-0.25f, Zones, InputData, Out.data(), NumFrames);
+		MultiZone.Process(-0.25f, Zones, InputData, Out.data(), NumFrames);
+		TEST_CHECK(MultiZone.GetGain(0) == 1.0f);
+		TEST_CHECK(std::equal(Out.begin(), Out.end(), InputData[0]));
+
+		// Moving only an edge while the value holds still, the multi-zone fader follows the edge and a
+		// FMappedRangeFader keeps the gain it had
+		FMappedRangeFader HeldFader;
+		HeldFader.Process(-0.25f, { FadeInStarts[0], FadeInEnds[0], FadeOutStarts[0], FadeOutEnds[0] }, InputData[0], FaderOut.data(), NumFrames);
+		FadeInEnds[0] = 0.0f;
+		MultiZone.Process(-0.25f, Zones, InputData, Out.data(), NumFrames);
+		HeldFader.Process(-0.25f, { FadeInStarts[0], FadeInEnds[0], FadeOutStarts[0], FadeOutEnds[0] }, InputData[0], FaderOut.data(), NumFrames);
+		TEST_CHECK(MultiZone.GetGain(0) == GetTrapezoidGain(-0.25f, FadeInStarts[0], FadeInEnds[0], FadeOutStarts[0], FadeOutEnds[0]));
+		TEST_CHECK(MultiZone.GetGain(0) != 1.0f);
+		TEST_CHECK(HeldFader.GetAmplitude() == 1.0f);
+	}
+
+	void TestCrossfadeCurves()
+	{
+		const ECrossfadeCurve Curves[] = { ECrossfadeCurve::EqualPower, ECrossfadeCurve::Linear, ECrossfadeCurve::SCurve, ECrossfadeCurve::Sqrt,
+			ECrossfadeCurve::PanLaw3dB, ECrossfadeCurve::PanLaw4p5dB, ECrossfadeCurve::PanLaw6dB };
+		const double MidpointDb[] = { -3.01, -6.02, -6.02, -3.01, -3.01, -4.52, -6.02 };
+
+		for (int32 CurveIndex = 0; CurveIndex < 7; ++CurveIndex)
+		{
+			const ECrossfadeCurve Curve = Curves[CurveIndex];
+			for (const EGainAccuracy Accuracy : { EGainAccuracy::Exact, EGainAccuracy::Fast })
+			{
+				const FEqualPowerGains Start = GetCrossfadeGains(0.0f, Curve, Accuracy);
+				const FEqualPowerGains End = GetCrossfadeGains(1.0f, Curve, Accuracy);
+				TEST_CHECK(Start.A == 1.0f && End.B == 1.0f);
+				TEST_CHECK(Start.B == 0.0f && End.A == 0.0f);
+
+				const FEqualPowerGains Mid = GetCrossfadeGains(0.5f, Curve, Accuracy);
+				TEST_CHECK_NEAR(20.0 * std::log10(Mid.A), MidpointDb[CurveIndex], 0.01);
+				TEST_CHECK_NEAR(Mid.A, Mid.B, 1e-6);
+
+				// Constant power or constant amplitude all the way across, and symmetric
+				for (int32 Step = 0; Step <= 16; ++Step)
+				{
+					const float Alpha = (float)Step / 16.0f;
+					const FEqualPowerGains Gains = GetCrossfadeGains(Alpha, Curve, Accuracy);
+					const FEqualPowerGains Mirror = GetCrossfadeGains(1.0f - Alpha, Curve, Accuracy);
+					TEST_CHECK_NEAR(Gains.A, Mirror.B, 1e-6);
+					if (Curve == ECrossfadeCurve::Linear || Curve == ECrossfadeCurve::SCurve || Curve == ECrossfadeCurve::PanLaw6dB)
+					{
+						TEST_CHECK_NEAR(Gains.A + Gains.B, 1.0, 1e-6);
+					}
+					else if (Curve != ECrossfadeCurve::PanLaw4p5dB)
+					{
+						TEST_CHECK_NEAR(Gains.A * Gains.A + Gains.B * Gains.B, 1.0, 1e-6);
+					}
+				}
+
+				// The array and window kernels give the same gains as the scalar ones
+				const float Alphas[] = { -0.5f, 0.0f, 0.1f, 0.5f, 0.77f, 1.0f };
+				float GainsA[6];
+				float GainsB[6];
+				float WindowGains[6];
+				float Values[6];
+				ComputeCrossfadeGains(Alphas, GainsA, GainsB, 6, Curve, Accuracy);
+				for (int32 i = 0; i < 6; ++i)
+				{
+					Values[i] = std::min(std::max(Alphas[i], 0.0f), 1.0f);
+				}
+				ComputeCrossfadeWindowGains(Values, 1.0f, WindowGains, 6, Curve, Accuracy);
+				for (int32 i = 1; i < 6; ++i)
+				{
+					const FEqualPowerGains Gains = GetCrossfadeGains(Alphas[i], Curve, Accuracy);
+					TEST_CHECK(GainsA[i] == Gains.A && GainsB[i] == Gains.B);
+					TEST_CHECK_NEAR(WindowGains[i], Gains.B, 1e-6);
+				}
+			}
+		}
+
+		// The equal power curves are exactly the original gains, out of range values included
+		TEST_CHECK(GetCrossfadeGains(-0.5f, ECrossfadeCurve::EqualPower, EGainAccuracy::Exact).A == GetEqualPowerGains(-0.5f).A);
+		TEST_CHECK(GetCrossfadeGains(0.3f, ECrossfadeCurve::PanLaw3dB, EGainAccuracy::Fast).B == GetEqualPowerGainsFast(0.3f).B);
+
+		// Changing the curve of a running crossfade ramps to the new gains
+		const int32 NumFrames = 8;
+		const std::vector<float> Ones(NumFrames, 1.0f);
+		const float* InputData[] = { Ones.data(), Ones.data() };
+		std::vector<float> Out(NumFrames);
+		TEqualPowerCrossfader<2> Crossfader;
+		Crossfader.Process(0.5f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		Crossfader.Process(0.5f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[7], std::sqrt(2.0), 1e-6);
+		Crossfader.SetCurve(ECrossfadeCurve::Linear);
+		Crossfader.Process(0.5f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[0], std::sqrt(2.0), 1e-6);
+		TEST_CHECK(Out[7] < Out[0] && Out[7] > 1.0f);
+		Crossfader.Process(0.5f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[0], 1.0, 1e-6);
+
+		FEqualPowerCrossfadePair Pair;
+		Pair.SetCurve(ECrossfadeCurve::SCurve);
+		Pair.Process(0.25f, EGainAccuracy::Exact, Ones.data(), Ones.data(), Out.data(), NumFrames);
+		Pair.Process(0.25f, EGainAccuracy::Exact, Ones.data(), Ones.data(), Out.data(), NumFrames);
+		TEST_CHECK_NEAR(Out[3], 1.0, 1e-6);
+	}
+
+	void TestSettledCrossfade()
+	{
+		const int32 NumFrames = 4;
+		const float Noise[3][NumFrames] = { { 0.1f, -0.7f, 1e-30f, 0.3f }, { 0.5f, 0.25f, -1.0f, 0.0f }, { -0.2f, 0.9f, 0.4f, -0.3f } };
+		const float* InputData[] = { Noise[0], Noise[1], Noise[2] };
+		std::vector<float> Out(NumFrames, 0.0f);
+
+		// Once the ramp from the first block has finished a whole number value mixes only its input, as a copy
+		TEqualPowerCrossfader<3> Crossfader;
+		Crossfader.Process(1.0f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		Crossfader.Process(1.0f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK(Crossfader.GetNumMixedInputs() == 1);
+		TEST_CHECK(std::equal(Out.begin(), Out.end(), Noise[1]));
+
+		// and moving away ramps from there
+		Crossfader.Process(1.5f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK(Crossfader.GetNumMixedInputs() == 2);
+		TEST_CHECK_NEAR(Out[0], Noise[1][0], 1e-6);
+		TEST_CHECK_NEAR(Out[2], Noise[1][2] * (1.0 + std::sqrt(0.5)) * 0.5 + Noise[2][2] * std::sqrt(0.5) * 0.5, 1e-6);
+
+		FEqualPowerCrossfadePair Pair;
+		Pair.Process(1.0f, EGainAccuracy::Exact, Noise[0], Noise[1], Out.data(), NumFrames);
+		Pair.Process(1.0f, EGainAccuracy::Exact, Noise[0], Noise[1], Out.data(), NumFrames);
+		TEST_CHECK(std::equal(Out.begin(), Out.end(), Noise[1]));
+	}
+
+	void TestTrapezoidGain()
+	{
+		TEST_CHECK_NEAR(GetTrapezoidGain(0.5f, 0.0f, 1.0f, 2.0f, 3.0f), 0.5, 1e-6);
+		TEST_CHECK_NEAR(GetTrapezoidGain(1.5f, 0.0f, 1.0f, 2.0f, 3.0f), 1.0, 1e-6);
+		TEST_CHECK_NEAR(GetTrapezoidGain(2.75f, 0.0f, 1.0f, 2.0f, 3.0f), 0.25, 1e-6);
+		TEST_CHECK_NEAR(GetTrapezoidGain(4.0f, 0.0f, 1.0f, 2.0f, 3.0f), 0.0, 1e-6);
+
+		// Zero width ranges step at the end of the range
+		TEST_CHECK_NEAR(GetMappedRangeValueClamped(1.0f, 1.0f, 0.0f, 1.0f, 0.5f), 0.0, 1e-6);
+		TEST_CHECK_NEAR(GetMappedRangeValueClamped(1.0f, 1.0f, 0.0f, 1.0f, 1.0f), 1.0, 1e-6);
+	}
+
+	void TestFadeEnvelope()
+	{
+		const int32 NumFrames = 8;
+		std::vector<float> Out(NumFrames, -1.0f);
+
+		FFadeEnvelope FadeIn(EFadeDirection::In);
+		TEST_CHECK(FadeIn.GetValue() == 0.0f);
+		TEST_CHECK(FadeIn.Render(Out.data(), NumFrames) == -1);
+		TEST_CHECK(Out[7] == 0.0f);
+
+		// Started on frame 2, a 4 sample fade is 0 on frame 2 and lands on 1 on frame 6
+		std::vector<int32> FinishedFrames;
+		const FFadeEvent StartEvent = { 2, EFadeEventType::Start, 4.0f };
+		FadeIn.RenderBlock(Out.data(), NumFrames, &StartEvent, 1, [&FinishedFrames](int32 Frame) { FinishedFrames.push_back(Frame); });
+		TEST_CHECK(Out[1] == 0.0f);
+		TEST_CHECK_NEAR(Out[2], 0.0, 1e-6);
+		TEST_CHECK_NEAR(Out[3], 0.25, 1e-6);
+		TEST_CHECK_NEAR(Out[5], 0.75, 1e-6);
+		TEST_CHECK(Out[6] == 1.0f && Out[7] == 1.0f);
+		TEST_CHECK(FinishedFrames.size() == 1 && FinishedFrames[0] == 6);
+		TEST_CHECK(!FadeIn.IsFading());
+		TEST_CHECK(FadeIn.GetValue() == 1.0f);
+
+		// A fade spanning blocks finishes on the exact frame of the later block
+		FFadeEnvelope FadeOut(EFadeDirection::Out);
+		FinishedFrames.clear();
+		const FFadeEvent LongStart = { 4, EFadeEventType::Start, 10.0f };
+		FadeOut.RenderBlock(Out.data(), NumFrames, &LongStart, 1, [&FinishedFrames](int32 Frame) { FinishedFrames.push_back(Frame); });
+		TEST_CHECK_NEAR(Out[7], 0.7, 1e-6);
+		TEST_CHECK(FadeOut.IsFading());
+		FadeOut.RenderBlock(Out.data(), NumFrames, nullptr, 0, [&FinishedFrames](int32 Frame) { FinishedFrames.push_back(Frame); });
+		TEST_CHECK_NEAR(Out[5], 0.1, 1e-6);
+		TEST_CHECK(Out[6] == 0.0f);
+		TEST_CHECK(FinishedFrames.size() == 1 && FinishedFrames[0] == 6);
+
+		// A reset lands on its own frame
+		const FFadeEvent Events[] = { { 0, EFadeEventType::Start, 100.0f }, { 3, EFadeEventType::Reset, 0.0f } };
+		FadeOut.RenderBlock(Out.data(), NumFrames, Events, 2, [](int32) {});
+		TEST_CHECK(Out[2] < 1.0f);
+		TEST_CHECK(Out[3] == 1.0f && Out[7] == 1.0f);
+		TEST_CHECK(!FadeOut.IsFading());
+
+		// Once settled the buffer is not rewritten
+		FadeOut.RenderBlock(Out.data(), NumFrames, nullptr, 0, [](int32) {});
+		Out[0] = -1.0f;
+		FadeOut.RenderBlock(Out.data(), NumFrames, nullptr, 0, [](int32) {});
+		TEST_CHECK(Out[0] == -1.0f);
+
+		// Out of range fade lengths from the time pin: NaN finishes at once, a huge one barely moves
+		FFadeEnvelope NaNFade(EFadeDirection::In);
+		NaNFade.Start(std::nanf(""));
+		TEST_CHECK(NaNFade.Render(Out.data(), NumFrames) == 0);
+		TEST_CHECK(Out[7] == 1.0f);
+		FFadeEnvelope HugeFade(EFadeDirection::In);
+		HugeFade.Start(1e30f);
+		TEST_CHECK(HugeFade.Render(Out.data(), NumFrames) == -1);
+		TEST_CHECK(HugeFade.IsFading() && Out[7] >= 0.0f && Out[7] < 1e-6f);
+	}
+	void TestFadeAudio()
+	{
+		const int32 NumFrames = 8;
+		std::vector<float> In(NumFrames);
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			In[i] = 0.5f - 0.1f * (float)i;
+		}
+		std::vector<float> Out(NumFrames, -1.0f);
+		std::vector<float> EnvelopeAudio(NumFrames);
+
+		// Applying the envelope gives exactly the rendered envelope times the audio, event frames included
+		for (const EFadeDirection Direction : { EFadeDirection::In, EFadeDirection::Out })
+		{
+			FFadeEnvelope Fused(Direction);
+			FFadeEnvelope Reference(Direction);
+			std::vector<int32> FusedFinished;
+			std::vector<int32> ReferenceFinished;
+			const FFadeEvent Blocks[][2] = {
+				{ { 3, EFadeEventType::Start, 6.5f }, { 8, EFadeEventType::Start, 0.0f } },
+				{ { 5, EFadeEventType::Reset, 0.0f }, { 6, EFadeEventType::Start, 2.0f } },
+				{ { 0, EFadeEventType::Start, 3.0f }, { 1, EFadeEventType::Start, 3.0f } },
+			};
+			const int32 NumBlockEvents[] = { 1, 2, 0, 1, 0 };
+			for (int32 Block = 0; Block < 5; ++Block)
+			{
+				const FFadeEvent* Events = Block < 3 ? Blocks[Block] : Blocks[2];
+				const int32 NumEvents = NumBlockEvents[Block];
+				Fused.ApplyBlock(In.data(), Out.data(), NumFrames, Events, NumEvents, [&FusedFinished](int32 Frame) { FusedFinished.push_back(Frame); });
+				Reference.RenderBlock(EnvelopeAudio.data(), NumFrames, Events, NumEvents, [&ReferenceFinished](int32 Frame) { ReferenceFinished.push_back(Frame); });
+				for (int32 i = 0; i < NumFrames; ++i)
+				{
+					TEST_CHECK(Out[i] == In[i] * EnvelopeAudio[i]);
+				}
+				TEST_CHECK(Fused.GetValue() == Reference.GetValue());
+			}
+			TEST_CHECK(FusedFinished == ReferenceFinished);
+			TEST_CHECK(!FusedFinished.empty());
+		}
+
+		// A finished fade in passes the audio straight through
+		FFadeEnvelope FadeIn(EFadeDirection::In);
+		const FFadeEvent StartEvent = { 0, EFadeEventType::Start, 4.0f };
+		FadeIn.ApplyBlock(In.data(), Out.data(), NumFrames, &StartEvent, 1, [](int32) {});
+		TEST_CHECK(Out[0] == 0.0f && Out[4] == In[4]);
+		FadeIn.ApplyBlock(In.data(), Out.data(), NumFrames, nullptr, 0, [](int32) {});
+		TEST_CHECK(std::equal(In.begin(), In.end(), Out.begin()));
+
+		// A finished fade out is cleared once and then left alone
+		FFadeEnvelope FadeOut(EFadeDirection::Out);
+		FadeOut.ApplyBlock(In.data(), Out.data(), NumFrames, &StartEvent, 1, [](int32) {});
+		TEST_CHECK(Out[0] == In[0] && Out[4] == 0.0f);
+		FadeOut.ApplyBlock(In.data(), Out.data(), NumFrames, nullptr, 0, [](int32) {});
+		TEST_CHECK(Out[7] == 0.0f);
+		Out[0] = -1.0f;
+		FadeOut.ApplyBlock(In.data(), Out.data(), NumFrames, nullptr, 0, [](int32) {});
+		TEST_CHECK(Out[0] == -1.0f);
+	}
+	void TestFadeEngine()
+	{
+		const int32 NumFrames = 8;
+		std::vector<float> Out(NumFrames, -1.0f);
+		std::vector<std::pair<int32, EFadeDirection>> Finished;
+		auto OnFinished = [&Finished](int32 Frame, EFadeDirection Direction) { Finished.push_back({ Frame, Direction }); };
+
+		// From silence a fade in behaves as FFadeEnvelope: 0 on its start frame, landing FadeSamples frames later
+		FFadeEngine Engine;
+		const FFadeCommand FadeIn = { 2, EFadeCommandType::FadeIn, 4.0f };
+		Engine.RenderBlock(Out.data(), NumFrames, &FadeIn, 1, OnFinished);
+		TEST_CHECK(Out[1] == 0.0f && Out[2] == 0.0f);
+		TEST_CHECK_NEAR(Out[3], 0.25, 1e-6);
+		TEST_CHECK_NEAR(Out[5], 0.75, 1e-6);
+		TEST_CHECK(Out[6] == 1.0f && Out[7] == 1.0f);
+		TEST_CHECK(Finished.size() == 1 && Finished[0].first == 6 && Finished[0].second == EFadeDirection::In);
+		TEST_CHECK(Engine.GetState() == EFadeState::Holding);
+
+		// A NaN length jumps straight to the target, a huge one starts a fade that barely moves
+		FFadeEngine Unclamped;
+		Unclamped.FadeTo(EFadeDirection::In, std::nanf(""));
+		Unclamped.RenderBlock(Out.data(), NumFrames, nullptr, 0, OnFinished);
+		TEST_CHECK(Unclamped.GetValue() == 1.0f);
+		Unclamped.FadeTo(EFadeDirection::Out, 1e30f);
+		Unclamped.RenderBlock(Out.data(), NumFrames, nullptr, 0, OnFinished);
+		TEST_CHECK(Unclamped.IsFading() && Unclamped.GetValue() > 0.999f);
+		Finished.clear();
+
+		// Reversing part way continues from the current value, taking only as long as the distance left
+		FFadeEngine Reversed;
+		Finished.clear();
+		const FFadeCommand Reverse[] = { { 0, EFadeCommandType::FadeIn, 8.0f }, { 4, EFadeCommandType::FadeOut, 8.0f } };
+		Reversed.RenderBlock(Out.data(), NumFrames, Reverse, 2, OnFinished);
+		TEST_CHECK_NEAR(Out[3], 0.375, 1e-6);
+		TEST_CHECK_NEAR(Out[4], 0.375, 1e-6);
+		TEST_CHECK_NEAR(Out[6], 0.125, 1e-6);
+		TEST_CHECK(Out[7] == 0.0f);
+		for (int32 i = 1; i < NumFrames; ++i)
+		{
+			TEST_CHECK(std::fabs(Out[i] - Out[i - 1]) <= 0.125f + 1e-6f);
+		}
+		TEST_CHECK(Finished.size() == 1 && Finished[0].first == 7 && Finished[0].second == EFadeDirection::Out);
+
+		// Hold freezes the fade where it is, and the next fade picks up from there
+		FFadeEngine Held;
+		const FFadeCommand HoldCommands[] = { { 0, EFadeCommandType::FadeIn, 10.0f }, { 5, EFadeCommandType::Hold, 0.0f } };
+		Held.RenderBlock(Out.data(), NumFrames, HoldCommands, 2, OnFinished);
+		TEST_CHECK_NEAR(Out[4], 0.4, 1e-6);
+		TEST_CHECK(Out[5] == Out[4] && Out[7] == Out[4]);
+		TEST_CHECK(!Held.IsFading());
+		const FFadeCommand Resume = { 0, EFadeCommandType::FadeIn, 10.0f };
+		Held.RenderBlock(Out.data(), NumFrames, &Resume, 1, OnFinished);
+		TEST_CHECK_NEAR(Out[0], 0.4, 1e-6);
+		TEST_CHECK_NEAR(Out[5], 0.9, 1e-6);
+		TEST_CHECK(Out[6] == 1.0f);
+
+		// A zero length fade, or one already at its target, lands on its own frame
+		FFadeEngine Instant(1.0f);
+		Finished.clear();
+		const FFadeCommand Instants[] = { { 1, EFadeCommandType::FadeIn, 4.0f }, { 3, EFadeCommandType::FadeOut, 0.0f } };
+		Instant.RenderBlock(Out.data(), NumFrames, Instants, 2, OnFinished);
+		TEST_CHECK(Out[2] == 1.0f && Out[3] == 0.0f);
+		TEST_CHECK(Finished.size() == 2 && Finished[0].first == 1 && Finished[1].first == 3);
+
+		// Applying gives exactly the rendered envelope times the audio, and holding at 1 or 0 is a copy or a single clear
+		std::vector<float> In(NumFrames);
+		for (int32 i = 0; i < NumFrames; ++i)
+		{
+			In[i] = 0.3f + 0.05f * (float)i;
+		}
+		std::vector<float> EnvelopeAudio(NumFrames);
+		FFadeEngine Fused;
+		FFadeEngine Reference;
+		const FFadeCommand Blocks[][2] = {
+			{ { 1, EFadeCommandType::FadeIn, 5.5f }, { 4, EFadeCommandType::FadeOut, 3.0f } },
+			{ { 2, EFadeCommandType::FadeIn, 12.0f }, { 6, EFadeCommandType::Hold, 0.0f } },
+			{ { 0, EFadeCommandType::FadeIn, 2.0f }, { 0, EFadeCommandType::FadeIn, 2.0f } },
+		};
+		for (int32 Block = 0; Block < 4; ++Block)
+		{
+			const int32 NumCommands = Block < 3 ? (Block == 2 ? 1 : 2) : 0;
+			Fused.ApplyBlock(In.data(), Out.data(), NumFrames, Blocks[std::min(Block, 2)], NumCommands, [](int32, EFadeDirection) {});
+			Reference.RenderBlock(EnvelopeAudio.data(), NumFrames, Blocks[std::min(Block, 2)], NumCommands, [](int32, EFadeDirection) {});
+			for (int32 i = 0; i < NumFrames; ++i)
+			{
+				TEST_CHECK(Out[i] == In[i] * EnvelopeAudio[i]);
+			}
+		}
+		TEST_CHECK(Fused.GetValue() == 1.0f);
+		TEST_CHECK(std::equal(In.begin(), In.end(), Out.begin()));
+
+		const FFadeCommand Silence = { 0, EFadeCommandType::FadeOut, 0.0f };
+		Fused.ApplyBlock(In.data(), Out.data(), NumFrames, &Silence, 1, [](int32, EFadeDirection) {});
+		Fused.ApplyBlock(In.data(), Out.data(), NumFrames, nullptr, 0, [](int32, EFadeDirection) {});
+		TEST_CHECK(Out[0] == 0.0f && Out[7] == 0.0f);
+		Out[0] = -1.0f;
+		Fused.ApplyBlock(In.data(), Out.data(), NumFrames, nullptr, 0, [](int32, EFadeDirection) {});
+		TEST_CHECK(Out[0] == -1.0f);
+	}
+
+	void TestDenormals()
+	{
+		TEST_CHECK(SnapToSilence(5e-7f, DefaultSilenceThreshold) == 0.0f);
+		TEST_CHECK(SnapToSilence(-5e-7f, DefaultSilenceThreshold) == 0.0f);
+		TEST_CHECK(SnapToSilence(2e-6f, DefaultSilenceThreshold) == 2e-6f);
+		TEST_CHECK(SnapToSilence(5e-7f, 0.0f) == 5e-7f);
+
+		TEST_CHECK(GetSilenceThreshold() == DefaultSilenceThreshold);
+		SetSilenceThreshold(-1.0f);
+		TEST_CHECK(GetSilenceThreshold() == 0.0f);
+		SetSilenceThreshold(DefaultSilenceThreshold);
+
+#if MSUTILS_HAS_FLUSH_DENORMALS
+		// 1e-40 is below the smallest normal float, so it only survives with the default floating point mode
+		volatile float Tiny = 1e-30f;
+		volatile float Scale = 1e-10f;
+		volatile float Product = Tiny * Scale;
+		TEST_CHECK(Product != 0.0f);
+		{
+			const FScopedFlushDenormals FlushDenormals;
+			Product = Tiny * Scale;
+			TEST_CHECK(Product == 0.0f);
+			{
+				// A disabled scope leaves the mode alone, and nested scopes restore what they found
+				const FScopedFlushDenormals Disabled(false);
+				const FScopedFlushDenormals Nested;
+				Product = Tiny * Scale;
+				TEST_CHECK(Product == 0.0f);
+			}
+			Product = Tiny * Scale;
+			TEST_CHECK(Product == 0.0f);
+		}
+		Product = Tiny * Scale;
+		TEST_CHECK(Product != 0.0f);
+		{
+			const FScopedFlushDenormals Disabled(false);
+			Product = Tiny * Scale;
+			TEST_CHECK(Product != 0.0f);
+		}
+#endif
+
+		const int32 NumFrames = 4;
+		const std::vector<float> In(NumFrames, 1.0f);
+		std::vector<float> Out(NumFrames, 1.0f);
+
+		// A value just inside the fade in edge gives a gain of 1e-7, which mutes straight away rather than ramping
+		const FTrapezoidZone Zone = { 0.0f, 1.0f, 2.0f, 3.0f };
+		FMappedRangeFader Fader;
+		Fader.Process(1e-7f, Zone, In.data(), Out.data(), NumFrames);
+		TEST_CHECK(Fader.IsMuted());
+		TEST_CHECK(Fader.GetAmplitude() == 0.0f);
+		TEST_CHECK(Out[3] == 0.0f);
+
+		FMappedRangeFader Unsnapped;
+		Unsnapped.SetSilenceThreshold(0.0f);
+		Unsnapped.Process(1e-7f, Zone, In.data(), Out.data(), NumFrames);
+		TEST_CHECK(!Unsnapped.IsMuted());
+		TEST_CHECK(Unsnapped.GetAmplitude() > 0.0f);
+
+		// An input with a gain below the threshold is not mixed at all
+		const float* InputData[] = { In.data(), In.data(), In.data(), In.data() };
+		TEqualPowerCrossfader<4> Crossfader;
+		Crossfader.Process(1e-7f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK(Crossfader.IsInputActive(0) && !Crossfader.IsInputActive(1));
+		TEST_CHECK(Crossfader.GetNumMixedInputs() == 1);
+
+		TEqualPowerCrossfader<4> UnsnappedCrossfader;
+		UnsnappedCrossfader.SetSilenceThreshold(0.0f);
+		UnsnappedCrossfader.Process(1e-7f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK(UnsnappedCrossfader.IsInputActive(0) && UnsnappedCrossfader.IsInputActive(1));
+
+		// Moving on ramps the snapped input in from 0, the same as from any other silent input
+		Crossfader.Process(0.5f, EGainAccuracy::Exact, InputData, Out.data(), NumFrames);
+		TEST_CHECK(Crossfader.IsInputActive(1));
+		TEST_CHECK(Crossfader.GetCurrentGain(1) > 0.7f);
+
+		// A fade out is silent from the frame it lands on until it is reset
+		FFadeEnvelope Envelope(EFadeDirection::Out);
+		std::vector<float> EnvelopeOut(8, 0.0f);
+		TEST_CHECK(!Envelope.IsSilent());
+		Envelope.Start(4.0f);
+		Envelope.Render(EnvelopeOut.data(), 2);
+		TEST_CHECK(!Envelope.IsSilent());
+		Envelope.Render(EnvelopeOut.data(), 8);
+		TEST_CHECK(Envelope.IsSilent());
+		Envelope.Reset();
+		TEST_CHECK(!Envelope.IsSilent());
+	}
+
+	// The fixed paths used for constant inputs must give exactly what the general paths give for the same constant values
+	void TestFixedGainPaths()
+	{
+		const int32 NumFrames = 37;
+		const int32 NumChannels = 2;
+		std::vector<float> Noise(NumFrames * NumChannels);
+		for (int32 i = 0; i < NumFrames * NumChannels; ++i)
+		{
+			Noise[i] = std::sin(0.37f * (float)i);
+		}
+		const float* InputData[NumChannels] = { Noise.data(), Noise.data() + NumFrames };
+
+		const FTrapezoidZone Zone = { 0.0f, 1.0f, 2.0f, 3.0f };
+		for (const float Value : { -1.0f, 0.25f, 1.5f, 2.5f, 1e-7f })
+		{
+			std::vector<float> Out(NumFrames * NumChannels, 0.0f);
+			std::vector<float> Expected(NumFrames * NumChannels, 0.0f);
+			float* OutputData[NumChannels] = { Out.data(), Out.data() + NumFrames };
+			float* ExpectedData[NumChannels] = { Expected.data(), Expected.data() + NumFrames };
+
+			FFixedZoneFader Fixed(Value, Zone);
+			FMappedRangeFader Fader;
+			for (int32 Block = 0; Block < 3; ++Block)
+			{
+				Fader.Process(Value, Zone, InputData, ExpectedData, NumChannels, NumFrames);
+				// A muted fixed zone is never processed, so its output stays as it was created
+				if (!Fixed.IsMuted())
+				{
+					Fixed.Process(InputData, OutputData, NumChannels, NumFrames);
+				}
+				TEST_CHECK(Out == Expected);
+				TEST_CHECK(Fixed.IsMuted() == Fader.IsMuted());
+				TEST_CHECK(Fixed.GetAmplitude() == Fader.GetAmplitude());
+			}
+		}
+
+		const float* CrossfadeInputs[4 * NumChannels];
+		for (int32 i = 0; i < 4 * NumChannels; ++i)
+		{
+			CrossfadeInputs[i] = InputData[i % NumChannels];
+		}
+		for (const float Value : { 0.0f, 1.3f, 2.0f, 2.75f, 5.0f })
+		{
+			std::vector<float> Out(NumFrames * NumChannels, 0.0f);
+			std::vector<float> Expected(NumFrames * NumChannels, 0.0f);
+			float* OutputData[NumChannels] = { Out.data(), Out.data() + NumFrames };
+			float* ExpectedData[NumChannels] = { Expected.data(), Expected.data() + NumFrames };
+
+			TEqualPowerCrossfader<4> Fixed;
+			TEqualPowerCrossfader<4> Crossfader;
+			Fixed.Process(Value, EGainAccuracy::Exact, CrossfadeInputs, OutputData, NumChannels, NumFrames);
+			Crossfader.Process(Value, EGainAccuracy::Exact, CrossfadeInputs, ExpectedData, NumChannels, NumFrames);
+			for (int32 Block = 0; Block < 3; ++Block)
+			{
+				Fixed.MixSettled(CrossfadeInputs, OutputData, NumChannels, NumFrames);
+				Crossfader.Process(Value, EGainAccuracy::Exact, CrossfadeInputs, ExpectedData, NumChannels, NumFrames);
+				TEST_CHECK(Out == Expected);
+			}
+		}
+	}
+
+	// Renders three blocks from Reused and Fresh with Render(Object, OutBuffer, Block) and checks they match exactly
+	template<typename ObjectType, typename RenderType>
+	bool RendersLikeNew(ObjectType& Reused, ObjectType& Fresh, int32 NumFrames, RenderType&& Render)
+	{
+		bool bMatch = true;
+		for (int32 Block = 0; Block < 3; ++Block)
+		{
+			// Stale contents, so a reset that skips clearing a muted output is caught
+			std::vector<float> ReusedOut(NumFrames, 0.5f);
+			std::vector<float> FreshOut(NumFrames, 0.5f);
+			Render(Reused, ReusedOut.data(), Block);
+			Render(Fresh, FreshOut.data(), Block);
+			bMatch &= ReusedOut == FreshOut;
+		}
+		return bMatch;
+	}
+
+	void TestReset()
+	{
+		const int32 NumFrames = 37;
+		std::vector<float> Noise(4 * NumFrames);
+		for (int32 i = 0; i < 4 * NumFrames; ++i)
+		{
+			Noise[i] = std::sin(0.37f * (float)i);
+		}
+		const float* Inputs[4] = { Noise.data(), Noise.data() + NumFrames, Noise.data() + 2 * NumFrames, Noise.data() + 3 * NumFrames };
+
+		{
+			const float Values[] = { 0.5f, 0.5f, 1.7f };
+			auto Render = [&](TEqualPowerCrossfader<4>& Crossfader, float* Out, int32 Block)
+				{
+					Crossfader.Process(Values[Block], EGainAccuracy::Exact, Inputs, Out, NumFrames);
+				};
+			TEqualPowerCrossfader<4> Reused;
+			TEqualPowerCrossfader<4> Fresh;
+			std::vector<float> Dirty(NumFrames);
+			Reused.Process(2.6f, EGainAccuracy::Exact, Inputs, Dirty.data(), NumFrames);
+			Reused.Process(2.6f, EGainAccuracy::Exact, Inputs, Dirty.data(), NumFrames);
+			Reused.Reset();
+			TEST_CHECK(Reused.GetNumMixedInputs() == 0);
+			TEST_CHECK(RendersLikeNew(Reused, Fresh, NumFrames, Render));
+		}
+
+		{
+			const float Values[] = { 0.3f, 0.3f, 0.9f };
+			auto Render = [&](FEqualPowerCrossfadePair& Crossfader, float* Out, int32 Block)
+				{
+					Crossfader.Process(Values[Block], EGainAccuracy::Fast, Inputs[0], Inputs[1], Out, NumFrames);
+				};
+			FEqualPowerCrossfadePair Reused;
+			FEqualPowerCrossfadePair Fresh;
+			std::vector<float> Dirty(NumFrames);
+			Reused.Process(0.8f, EGainAccuracy::Exact, Inputs[0], Inputs[1], Dirty.data(), NumFrames);
+			Reused.Reset();
+			TEST_CHECK(!Reused.IsInputActive(0) && !Reused.IsInputActive(1));
+			TEST_CHECK(RendersLikeNew(Reused, Fresh, NumFrames, Render));
+		}
+
+		{
+			std::vector<float> Ramp(NumFrames);
+			FillLinear(Ramp.data(), NumFrames, 0.2f, 0.05f);
+			auto Render = [&](FAudioRateEqualPowerCrossfader& Crossfader, float* Out, int32)
+				{
+					Crossfader.Process(Ramp.data(), EGainAccuracy::Exact, Inputs, Out, NumFrames);
+				};
+			FAudioRateEqualPowerCrossfader Reused(4, NumFrames);
+			FAudioRateEqualPowerCrossfader Fresh(4, NumFrames);
+			std::vector<float> Dirty(NumFrames);
+			std::vector<float> High(NumFrames, 3.0f);
+			Reused.Process(High.data(), EGainAccuracy::Exact, Inputs, Dirty.data(), NumFrames);
+			Reused.Reset();
+			TEST_CHECK(Reused.GetFirstActiveInput() == 0 && Reused.GetLastActiveInput() == -1);
+			TEST_CHECK(RendersLikeNew(Reused, Fresh, NumFrames, Render));
+		}
+
+		{
+			// Two voices, whose outputs are checked one after the other
+			const float Values[][2] = { { 0.25f, 1.0f }, { 0.25f, 1.0f }, { 0.6f, 0.0f } };
+			auto Render = [&](FEqualPowerCrossfadeBank& Bank, float* Out, int32 Block)
+				{
+					std::vector<float> Second(NumFrames);
+					float* Outputs[2] = { Out, Second.data() };
+					Bank.Process(Values[Block], EGainAccuracy::Exact, Inputs, Inputs + 2, Outputs, NumFrames);
+					for (int32 i = 0; i < NumFrames; ++i)
+					{
+						Out[i] += 2.0f * Second[i];
+					}
+				};
+			FEqualPowerCrossfadeBank Reused(2);
+			FEqualPowerCrossfadeBank Fresh(2);
+			std::vector<float> DirtyA(NumFrames);
+			std::vector<float> DirtyB(NumFrames);
+			float* Dirty[2] = { DirtyA.data(), DirtyB.data() };
+			const float DirtyValues[2] = { 0.9f, 0.4f };
+			Reused.Process(DirtyValues, EGainAccuracy::Fast, Inputs, Inputs + 2, Dirty, NumFrames);
+			Reused.Process(DirtyValues, EGainAccuracy::Fast, Inputs, Inputs + 2, Dirty, NumFrames);
+			Reused.Reset();
+			TEST_CHECK(!Reused.IsSettled());
+			TEST_CHECK(RendersLikeNew(Reused, Fresh, NumFrames, Render));
+		}
+
+		{
+			const FTrapezoidZone Zone = { 0.0f, 1.0f, 2.0f, 3.0f };
+			const float Values[] = { 0.5f, -1.0f, -1.0f };
+			auto Render = [&](FMappedRangeFader& Fader, float* Out, int32 Block)
+				{
+					Fader.Process(Values[Block], Zone, Inputs[0], Out, NumFrames);
+				};
+			FMappedRangeFader Reused;
+			FMappedRangeFader Fresh;
+			std::vector<float> Dirty(NumFrames);
+			Reused.Process(1.5f, Zone, Inputs[0], Dirty.data(), NumFrames);
+			Reused.Process(-1.0f, Zone, Inputs[0], Dirty.data(), NumFrames);
+			Reused.Reset();
+			TEST_CHECK(Reused.IsMuted() && Reused.GetAmplitude() == 0.0f);
+			TEST_CHECK(RendersLikeNew(Reused, Fresh, NumFrames, Render));
+
+			auto RenderFixed = [&](FFixedZoneFader& Fader, float* Out, int32)
+				{
+					Fader.Process(Inputs[0], Out, NumFrames);
+				};
+			FFixedZoneFader ReusedFixed(0.5f, Zone);
+			FFixedZoneFader FreshFixed(0.5f, Zone);
+			ReusedFixed.Process(Inputs[0], Dirty.data(), NumFrames);
+			ReusedFixed.Reset();
+			TEST_CHECK(RendersLikeNew(ReusedFixed, FreshFixed, NumFrames, RenderFixed));
+		}
+
+		{
+			const float FadeInStarts[] = { 0.0f, 1.0f };
+			const float FadeInEnds[] = { 1.0f, 2.0f };
+			const float FadeOutStarts[] = { 2.0f, 3.0f };
+			const float FadeOutEnds[] = { 3.0f, 4.0f };
+			const FTrapezoidZoneArrays Zones = { FadeInStarts, FadeInEnds, FadeOutStarts, FadeOutEnds };
+			const float Values[] = { 1.5f, 1.5f, -1.0f };
+			auto Render = [&](TMultiZoneFader<2>& Fader, float* Out, int32 Block)
+				{
+					Fader.Process(Values[Block], Zones, Inputs, Out, NumFrames);
+				};
+			TMultiZoneFader<2> Reused;
+			TMultiZoneFader<2> Fresh;
+			std::vector<float> Dirty(NumFrames);
+			Reused.Process(2.5f, Zones, Inputs, Dirty.data(), NumFrames);
+			Reused.Process(-1.0f, Zones, Inputs, Dirty.data(), NumFrames);
+			Reused.Reset();
+			TEST_CHECK(Reused.IsMuted() && Reused.GetGain(0) == 0.0f && Reused.GetGain(1) == 0.0f);
+			TEST_CHECK(RendersLikeNew(Reused, Fresh, NumFrames, Render));
+		}
+
+		{
+			const FFadeEvent Start = { 5, EFadeEventType::Start, 50.0f };
+			auto Render = [&](FFadeEnvelope& Envelope, float* Out, int32 Block)
+				{
+					Envelope.RenderBlock(Out, NumFrames, &Start, Block == 0 ? 1 : 0, [](int32) {});
+				};
+			FFadeEnvelope Reused(EFadeDirection::Out);
+			FFadeEnvelope Fresh(EFadeDirection::Out);
+			std::vector<float> Dirty(NumFrames);
+			Reused.RenderBlock(Dirty.data(), NumFrames, &Start, 1, [](int32) {});
+			Reused.Reset();
+			TEST_CHECK(Reused.GetValue() == 1.0f && !Reused.IsFading());
+			TEST_CHECK(RendersLikeNew(Reused, Fresh, NumFrames, Render));
+		}
+
+		{
+			const FFadeCommand FadeOut = { 3, EFadeCommandType::FadeOut, 60.0f };
+			auto Render = [&](FFadeEngine& Engine, float* Out, int32 Block)
+				{
+					Engine.ApplyBlock(Inputs[0], Out, NumFrames, &FadeOut, Block == 0 ? 1 : 0, [](int32, EFadeDirection) {});
+				};
+			FFadeEngine Reused(0.0f);
+			FFadeEngine Fresh(1.0f);
+			const FFadeCommand FadeIn = { 0, EFadeCommandType::FadeIn, 20.0f };
+			std::vector<float> Dirty(NumFrames);
+			Reused.ApplyBlock(Inputs[0], Dirty.data(), NumFrames, &FadeIn, 1, [](int32, EFadeDirection) {});
+			Reused.Reset(1.0f);
+			TEST_CHECK(Reused.GetValue() == 1.0f && Reused.GetState() == EFadeState::Holding);
+			TEST_CHECK(RendersLikeNew(Reused, Fresh, NumFrames, Render));
+		}
+	}
+
+	void TestNodeStats()
+	{
+		static FNodeStats Stats("Test Node");
+
+		bool bFound = false;
+		ForEachNodeStats([&bFound](const FNodeStats& Registered)
+			{
+				bFound |= &Registered == &Stats;
+			});
+		TEST_CHECK(bFound);
+
+		Stats.RecordBlock(100, true);
+		Stats.RecordBlock(300, false);
+		Stats.RecordBlock(200, false);
+		FNodeStatsSnapshot Snapshot = Stats.GetSnapshot();
+		TEST_CHECK(Snapshot.FastPathBlocks == 1);
+		TEST_CHECK(Snapshot.SlowPathBlocks == 2);
+		TEST_CHECK(Snapshot.GetNumBlocks() == 3);
+		TEST_CHECK(Snapshot.PeakNanoseconds == 300);
+		TEST_CHECK_NEAR(Snapshot.GetAverageNanoseconds(), 200.0, 1e-9);
+
+		{
+			FScopedNodeBlockTimer Timer(Stats);
+			Timer.SetFastPath(true);
+		}
+		TEST_CHECK(Stats.GetSnapshot().FastPathBlocks == 2);
+
+		{
+			const FNodeInstanceCounter First(Stats);
+			const FNodeInstanceCounter Second(Stats);
+#if MSUTILS_NODE_STATS
+			TEST_CHECK(Stats.GetSnapshot().LiveInstances == 2);
+#endif
+			// Resetting leaves the live instances alone
+			ResetNodeStats();
+			Snapshot = Stats.GetSnapshot();
+			TEST_CHECK(Snapshot.GetNumBlocks() == 0);
+			TEST_CHECK(Snapshot.PeakNanoseconds == 0);
+			TEST_CHECK(Snapshot.GetAverageNanoseconds() == 0.0);
+#if MSUTILS_NODE_STATS
+			TEST_CHECK(Snapshot.LiveInstances == 2);
+#endif
+		}
+		TEST_CHECK(Stats.GetSnapshot().LiveInstances == 0);
+	}
+
+	void TestTelemetry()
+	{
+		// Indices wrap around the ring many times, and a full ring drops rather than overwrites
+		TSpscRing<int32, 4> Ring;
+		int32 Value = 0;
+		for (int32 i = 0; i < 10; ++i)
+		{
+			TEST_CHECK(Ring.Push(i));
+			TEST_CHECK(Ring.Pop(Value) && Value == i);
+		}
+		TEST_CHECK(!Ring.Pop(Value));
+		for (int32 i = 0; i < 6; ++i)
+		{
+			TEST_CHECK(Ring.Push(i) == (i < 4));
+		}
+		TEST_CHECK(Ring.Num() == 4);
+		TEST_CHECK(Ring.GetNumDropped() == 2);
+		for (int32 i = 0; i < 4; ++i)
+		{
+			TEST_CHECK(Ring.Pop(Value) && Value == i);
+		}
+		TEST_CHECK(Ring.Num() == 0);
+
+		// Telemetry is opt in: a publisher created while it is off never opens a channel
+		const int32 NumChannels = GetNumTelemetryChannels();
+		{
+			FTelemetryPublisher Disabled("Test Node");
+			TEST_CHECK(!Disabled.IsActive());
+			Disabled.PublishGain(1.0f);
+		}
+		TEST_CHECK(GetNumTelemetryChannels() == NumChannels);
+
+#if MSUTILS_TELEMETRY
+		SetTelemetryEnabled(true);
+		std::vector<FTelemetryEvent> Events;
+		const auto Drain = [&Events]()
+		{
+			Events.clear();
+			DrainTelemetry([&Events](const FTelemetryChannel& Channel, const FTelemetryEvent& Event)
+				{
+					if (std::strcmp(Channel.GetNodeName(), "Test Node") == 0)
+					{
+						Events.push_back(Event);
+					}
+				});
+		};
+
+		{
+			FTelemetryPublisher Publisher("Test Node");
+			TEST_CHECK(Publisher.IsActive());
+			TEST_CHECK(GetNumTelemetryChannels() == NumChannels + 1);
+
+			Publisher.PublishCrossfade(1.25f, GetCrossfadePosition(1.25f, 4), 0.7f, 0.3f);
+			Publisher.PublishState("Ramping");
+			// Repeated states are only published once
+			Publisher.PublishState("Ramping");
+			Publisher.PublishGain(0.5f);
+			Publisher.PublishState("Unity");
+
+			Drain();
+			TEST_CHECK(Events.size() == 4);
+			if (Events.size() == 4)
+			{
+				TEST_CHECK(Events[0].Type == ETelemetryEventType::Crossfade);
+				TEST_CHECK(Events[0].IndexA == 1 && Events[0].IndexB == 2);
+				TEST_CHECK_NEAR(Events[0].Alpha, 0.25, 1e-6);
+				TEST_CHECK(Events[0].GainA == 0.7f && Events[0].GainB == 0.3f);
+				TEST_CHECK(Events[1].Type == ETelemetryEventType::State && std::strcmp(Events[1].State, "Ramping") == 0);
+				TEST_CHECK(Events[2].Type == ETelemetryEventType::Gain && Events[2].Value == 0.5f);
+				TEST_CHECK(std::strcmp(Events[3].State, "Unity") == 0);
+			}
+
+			// Turning telemetry off stops publishing without closing the channel
+			SetTelemetryEnabled(false);
+			Publisher.PublishGain(0.25f);
+			Drain();
+			TEST_CHECK(Events.empty());
+			SetTelemetryEnabled(true);
+
+			Publisher.PublishGain(0.25f);
+		}
+
+		// Events published before the operator went are still delivered, then the channel is freed
+		TEST_CHECK(GetNumTelemetryChannels() == NumChannels + 1);
+		Drain();
+		TEST_CHECK(Events.size() == 1 && Events[0].Value == 0.25f);
+		TEST_CHECK(GetNumTelemetryChannels() == NumChannels);
+		SetTelemetryEnabled(false);
+#endif
+	}
+
+	// Every SIMD kernel the CPU supports must give exactly the scalar reference's output, including the scalar tails
+	// and unaligned buffers
+	void TestSimdKernels(ESimdLevel Level)
+	{
+		const FGainKernelTable& Kernels = GetGainKernelTable(Level);
+		const FGainKernelTable& Reference = ScalarGainKernelTable;
+
+		const int32 MaxFrames = 300;
+		std::vector<float> InA(MaxFrames + 1);
+		std::vector<float> InB(MaxFrames + 1);
+		std::vector<float> Gains(MaxFrames + 1);
+		uint32 Seed = 12345;
+		for (int32 i = 0; i <= MaxFrames; ++i)
+		{
+			Seed = Seed * 1664525u + 1013904223u;
+			InA[i] = (float)(Seed >> 8) / 8388608.0f - 1.0f;
+			InB[i] = std::sin(0.1f * (float)i);
+			Gains[i] = 0.5f + 0.25f * std::cos(0.03f * (float)i);
+		}
+
+		std::vector<float> Out(MaxFrames + 1);
+		std::vector<float> Expected(MaxFrames + 1);
+		auto ResetOutputs = [&Out, &Expected, &InB]()
+		{
+			std::copy(InB.begin(), InB.end(), Out.begin());
+			std::copy(InB.begin(), InB.end(), Expected.begin());
+		};
+
+		for (const int32 NumFrames : { 0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 64, 100, 257, MaxFrames })
+		{
+			for (const int32 Offset : { 0, 1 })
+			{
+				const float* A = InA.data() + Offset;
+				const float* B = InB.data() + Offset;
+				const float* G = Gains.data() + Offset;
+				float* O = Out.data() + Offset;
+				float* E = Expected.data() + Offset;
+				const float Start = 0.8f;
+				const float Increment = -0.6f / (float)std::max(NumFrames, 1);
+
+				ResetOutputs();
+				Kernels.FillLinear(O, NumFrames, Start, Increment);
+				Reference.FillLinear(E, NumFrames, Start, Increment);
+				TEST_CHECK(Out == Expected);
+
+				ResetOutputs();
+				Kernels.ScaleLinear(A, O, NumFrames, Start, Increment);
+				Reference.ScaleLinear(A, E, NumFrames, Start, Increment);
+				TEST_CHECK(Out == Expected);
+
+				ResetOutputs();
+				Kernels.ScaleLinear(O, O, NumFrames, Start, Increment);
+				Reference.ScaleLinear(E, E, NumFrames, Start, Increment);
+				TEST_CHECK(Out == Expected);
+
+				ResetOutputs();
+				Kernels.MixInLinear(A, O, NumFrames, Start, Increment);
+				Reference.MixInLinear(A, E, NumFrames, Start, Increment);
+				TEST_CHECK(Out == Expected);
+
+				ResetOutputs();
+				Kernels.MixPairLinear(A, B, O, NumFrames, Start, Increment, 0.1f, -Increment);
+				Reference.MixPairLinear(A, B, E, NumFrames, Start, Increment, 0.1f, -Increment);
+				TEST_CHECK(Out == Expected);
+
+				ResetOutputs();
+				Kernels.Multiply(A, G, O, NumFrames);
+				Reference.Multiply(A, G, E, NumFrames);
+				TEST_CHECK(Out == Expected);
+
+				ResetOutputs();
+				Kernels.MixInMultiplied(A, G, O, NumFrames);
+				Reference.MixInMultiplied(A, G, E, NumFrames);
+				TEST_CHECK(Out == Expected);
+			}
+		}
+	}
+}
+
+int main()
+{
+	// The whole suite runs once per kernel set the CPU supports, so every path is checked with every kernel set
+	for (const ESimdLevel Level : { ESimdLevel::Scalar, ESimdLevel::SSE, ESimdLevel::AVX2, ESimdLevel::AVX512, ESimdLevel::NEON })
+	{
+		if (!IsSimdLevelSupported(Level))
+		{
+			continue;
+		}
+
+		std::printf("Testing with %s kernels\n", GetSimdLevelName(Level));
+		TEST_CHECK(SetActiveSimdLevel(Level) == Level);
+		TestSimdKernels(Level);
+
+		TestEqualPowerGains();
+		TestFastEqualPowerGains();
+		TestCrossfadePosition();
+		TestRampKernels();
+		TestEqualPowerCrossfader();
+		TestEqualPowerCrossfaderMixPaths();
+		TestAudioRateEqualPowerCrossfader();
+		TestInputActivity();
+		TestEqualPowerCrossfadePair();
+		TestMappedRangeFader();
+		TestLargeEqualPowerCrossfader();
+		TestSettledCrossfade();
+		TestMultichannel();
+		TestCrossfadeBank();
+		TestMultiZoneFader();
+		TestCrossfadeCurves();
+		TestTrapezoidGain();
+		TestFadeEnvelope();
+		TestFadeAudio();
+		TestFadeEngine();
+		TestDenormals();
+		TestFixedGainPaths();
+		TestReset();
+	}
+
+	TEST_CHECK(IsSimdLevelSupported(GetBestSimdLevel()));
+	TEST_CHECK(InitSimdKernels() == GetBestSimdLevel());
+	TEST_CHECK(GetActiveSimdLevel() == GetBestSimdLevel());
+
+	TestNodeStats();
+	TestTelemetry();
+
+	if (NumFailures > 0)
+	{
+		std::printf("%d check(s) failed\n", NumFailures);
+		return 1;
+	}
+
+	std::printf("All MSUtilsDSP tests passed\n");
+	return 0;
+}